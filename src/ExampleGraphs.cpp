@@ -4,7 +4,7 @@ Graph ExampleGraphs::Graph1(){
     Graph gh1;
     for (auto i = 1; i <= 8; i++) {
         int line = 1;
-        Vertex *v = new Vertex("V" + to_string(i), "District" + to_string(i), "Municipality" + to_string(i), "Line" + to_string(line), {"Township" + to_string(i)});
+        Vertex *v = new Vertex(gh1.getStationTable(), "V" + to_string(i), "District" + to_string(i), "Municipality" + to_string(i), "Line" + to_string(line), {"Township" + to_string(i)});
         gh1.addVertex(v);
     }
 
@@ -26,7 +26,7 @@ Graph ExampleGraphs::Graph2(){
     Graph gh2;
     for (auto i = 1; i <= 5; i++) {
         int line = 1;
-        Vertex *v = new Vertex("V" + to_string(i), "District" + to_string(i), "Municipality" + to_string(i), "Line" + to_string(line), {"Township" + to_string(i)});
+        Vertex *v = new Vertex(gh2.getStationTable(), "V" + to_string(i), "District" + to_string(i), "Municipality" + to_string(i), "Line" + to_string(line), {"Township" + to_string(i)});
         gh2.addVertex(v);
     }
 
@@ -43,7 +43,7 @@ Graph ExampleGraphs::Graph3(){
     Graph gh3;
     for (auto i = 1; i <= 5; i++) {
         int line = 1;
-        Vertex *v = new Vertex("V" + to_string(i), "District" + to_string(i), "Municipality" + to_string(i), "Line" + to_string(line), {"Township" + to_string(i)});
+        Vertex *v = new Vertex(gh3.getStationTable(), "V" + to_string(i), "District" + to_string(i), "Municipality" + to_string(i), "Line" + to_string(line), {"Township" + to_string(i)});
         gh3.addVertex(v);
     }
 
@@ -67,7 +67,7 @@ Graph ExampleGraphs::Graph4(){
         if (i >= 7){
             line = 2;
         }
-        Vertex *v = new Vertex("V" + to_string(i), "District" + to_string(i), "Municipality" + to_string(i), "Line" + to_string(line), {"Township" + to_string(i)});
+        Vertex *v = new Vertex(gh4.getStationTable(), "V" + to_string(i), "District" + to_string(i), "Municipality" + to_string(i), "Line" + to_string(line), {"Township" + to_string(i)});
         gh4.addVertex(v);
     }
 
@@ -93,7 +93,7 @@ Graph ExampleGraphs::Graph5(){
     Graph gh5;
     for (auto i = 1; i <= 7; i++) {
         int line = 1;
-        Vertex *v = new Vertex("V" + to_string(i), "District" + to_string(i), "Municipality" + to_string(i), "Line" + to_string(line), {"Township" + to_string(i)});
+        Vertex *v = new Vertex(gh5.getStationTable(), "V" + to_string(i), "District" + to_string(i), "Municipality" + to_string(i), "Line" + to_string(line), {"Township" + to_string(i)});
         gh5.addVertex(v);
     }
 
@@ -112,7 +112,7 @@ Graph ExampleGraphs::Graph6(){
     Graph gh6;
     for (auto i = 1; i <= 5; i++) {
         int line = 1;
-        Vertex *v = new Vertex("V" + to_string(i), "District" + to_string(i), "Municipality" + to_string(i), "Line" + to_string(line), {"Township" + to_string(i)});
+        Vertex *v = new Vertex(gh6.getStationTable(), "V" + to_string(i), "District" + to_string(i), "Municipality" + to_string(i), "Line" + to_string(line), {"Township" + to_string(i)});
         gh6.addVertex(v);
     }
 
@@ -130,7 +130,7 @@ Graph ExampleGraphs::costGraph1() {
 
     for (auto i = 1; i <= 5; i++) {
         int line = 1;
-        Vertex *v = new Vertex("V" + to_string(i), "District" + to_string(i), "Municipality" + to_string(i), "Line" + to_string(line), {"Township" + to_string(i)});
+        Vertex *v = new Vertex(gh.getStationTable(), "V" + to_string(i), "District" + to_string(i), "Municipality" + to_string(i), "Line" + to_string(line), {"Township" + to_string(i)});
         gh.addVertex(v);
     }
 
@@ -149,7 +149,7 @@ Graph ExampleGraphs::costGraph2() {
 
     for (auto i = 1; i <= 6; i++) {
         int line = 1;
-        Vertex *v = new Vertex("V" + to_string(i), "District" + to_string(i), "Municipality" + to_string(i), "Line" + to_string(line), {"Township" + to_string(i)});
+        Vertex *v = new Vertex(gh.getStationTable(), "V" + to_string(i), "District" + to_string(i), "Municipality" + to_string(i), "Line" + to_string(line), {"Township" + to_string(i)});
         gh.addVertex(v);
     }
 
@@ -167,7 +167,7 @@ Graph ExampleGraphs::maxFlowSinglePointGraph1() {
     Graph gh;
     for (auto i = 1; i <= 14; i++) {
         int line = 1;
-        auto *v = new Vertex("V" + to_string(i), "District" + to_string(i), "Municipality" + to_string(i), "Line" + to_string(line), {"Township" + to_string(i)});
+        auto *v = new Vertex(gh.getStationTable(), "V" + to_string(i), "District" + to_string(i), "Municipality" + to_string(i), "Line" + to_string(line), {"Township" + to_string(i)});
         gh.addVertex(v);
     }
 
@@ -195,7 +195,7 @@ Graph ExampleGraphs::maxFlowSinglePointGraph2() {
     Graph gh;
     for (auto i = 1; i <= 6; i++) {
         int line = 1;
-        auto *v = new Vertex("V" + to_string(i), "District" + to_string(i), "Municipality" + to_string(i), "Line" + to_string(line), {"Township" + to_string(i)});
+        auto *v = new Vertex(gh.getStationTable(), "V" + to_string(i), "District" + to_string(i), "Municipality" + to_string(i), "Line" + to_string(line), {"Township" + to_string(i)});
         gh.addVertex(v);
     }
 
@@ -213,7 +213,7 @@ Graph ExampleGraphs::topSegmentFailureGraph1() {
     Graph gh;
     for (auto i = 1; i <= 7; i++) {
         int line = 1;
-        auto *v = new Vertex("V" + to_string(i), "District" + to_string(i), "Municipality" + to_string(i), "Line" + to_string(line), {"Township" + to_string(i)});
+        auto *v = new Vertex(gh.getStationTable(), "V" + to_string(i), "District" + to_string(i), "Municipality" + to_string(i), "Line" + to_string(line), {"Township" + to_string(i)});
         gh.addVertex(v);
     }
 
@@ -231,7 +231,7 @@ Graph ExampleGraphs::topSegmentFailureGraph2() {
     Graph gh;
     for (auto i = 1; i <= 4; i++) {
         int line = 1;
-        auto *v = new Vertex("V" + to_string(i), "District" + to_string(i), "Municipality" + to_string(i), "Line" + to_string(line), {"Township" + to_string(i)});
+        auto *v = new Vertex(gh.getStationTable(), "V" + to_string(i), "District" + to_string(i), "Municipality" + to_string(i), "Line" + to_string(line), {"Township" + to_string(i)});
         gh.addVertex(v);
     }
 
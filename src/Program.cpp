@@ -8,15 +8,7 @@
  */
 Program::Program()
 {
-    auto region_map = Scraper::scrape_stations("../src/data/stations.csv", railway);
-    Scraper::scrape_networks("../src/data/network.csv", railway);
-    Scraper::fix_graph(railway);
-    railway.setRegion(LINE);
-    Scraper::findExtremes(region_map, railway);
-    railway.setRegion(MUNICIPALITIES);
-    Scraper::findExtremes(region_map, railway);
-    railway.setRegion(DISTRICTS);
-    Scraper::findExtremes(region_map, railway);
+    Scraper::loadRailway("../src/data/", railway);
 
     currMenuPage = 0;
     createMainMenu();
@@ -26,8 +18,6 @@ Program::Program()
     createMenu4();
     createMenu5();
     createMenuReducedConnectivity();
-
-    railway.setConnectedComponents();
 }
 
 /**
@@ -45,7 +35,17 @@ void Program::run()
             cout << "\033[31mPlease insert a valid option: \033[0m";
         cout<<"\033[0m";
         Menu menu = menus[currMenuPage];
-        menu.doAction(option - 1);
+        Metrics::beginAnalysis(menu.getButtons()[option - 1]);
+        {
+            TraceScope trace("menu", menu.getButtons()[option - 1]);
+            Allocations::Scope allocations;
+            long long solverCalls = Allocations::getSolverCalls();
+            menu.doAction(option - 1);
+            // Without metrics the solver calls aren't counted, so every action is kept
+            if (Allocations::getSolverCalls() != solverCalls || !Metrics::isEnabled())
+                Allocations::setLastAction(menu.getButtons()[option - 1], allocations.getStats());
+        }
+        Metrics::endAnalysis();
     }
 
     cleanMenus();
@@ -80,8 +80,10 @@ void Program::createMainMenu()
 {
     menus.emplace_back("../src/menus/mainMenu");
     menus[menus.size() - 1].addMenuItem(new ChangeMenu(currMenuPage, railway, 1));
-    menus[menus.size() - 1].addMenuItem(new MinCostMaxFlow(currMenuPage, railway));
-    menus[menus.size() - 1].addMenuItem(new ChangeMenu(currMenuPage, railway, 3));
+    menus[menus.size() - 1].addMenuItem(new ChangeMenu(currMenuPage, railway, 2));
+    menus[menus.size() - 1].addMenuItem(new ChangeMenu(currMenuPage, railway, 3, &reducedConnectivity, &pool));
+    menus[menus.size() - 1].addMenuItem(new SolverMetrics(currMenuPage, railway));
+    menus[menus.size() - 1].addMenuItem(new MemoryReport(currMenuPage, railway));
     menus[menus.size() - 1].addMenuItem(new ChangeMenu(currMenuPage, railway, -1));
 }
 
@@ -92,7 +94,8 @@ void Program::createMenu1()
 {
     menus.emplace_back("../src/menus/menu1");
     menus[menus.size() - 1].addMenuItem(new MaxFlowUserInput(currMenuPage, railway));
-    menus[menus.size() - 1].addMenuItem(new PairsMaxFlow(currMenuPage, railway));
+    menus[menus.size() - 1].addMenuItem(new PairsMaxFlow(currMenuPage, railway, pool));
+    menus[menus.size() - 1].addMenuItem(new TopPairsMaxFlow(currMenuPage, railway, pool));
     menus[menus.size() - 1].addMenuItem(new ChangeMenu(currMenuPage, railway, 4));
     menus[menus.size() - 1].addMenuItem(new ChangeMenu(currMenuPage, railway, 5));
     menus[menus.size() - 1].addMenuItem(new SinglePointMaxFlow(currMenuPage, railway));
@@ -107,6 +110,9 @@ void Program::createMenu2()
 {
     menus.emplace_back("../src/menus/menu2");
     menus[menus.size() - 1].addMenuItem(new MinCostMaxFlow(currMenuPage, railway));
+    menus[menus.size() - 1].addMenuItem(new TargetFlow(currMenuPage, railway));
+    menus[menus.size() - 1].addMenuItem(new CheapestRoute(currMenuPage, railway));
+    menus[menus.size() - 1].addMenuItem(new ExtremeCosts(currMenuPage, railway, pool));
     menus[menus.size() - 1].addMenuItem(new ChangeMenu(currMenuPage, railway, 0));
 }
 
@@ -116,24 +122,26 @@ void Program::createMenu2()
 void Program::createMenu3() {
     menus.emplace_back("../src/menus/menu3");
 
-    menus[menus.size() - 1].addMenuItem(new ReducedConnectivityMaxFlow(currMenuPage, railway));
-    menus[menus.size() - 1].addMenuItem(new TopSegmentFailure(currMenuPage, railway));
-    menus[menus.size() - 1].addMenuItem(new ChangeMenu(currMenuPage, railway, 0));
+    menus[menus.size() - 1].addMenuItem(new ReducedConnectivityMaxFlow(currMenuPage, railway, reducedConnectivity));
+    menus[menus.size() - 1].addMenuItem(new TopSegmentFailure(currMenuPage, railway, reducedConnectivity, pool));
+    menus[menus.size() - 1].addMenuItem(new CriticalSegments(currMenuPage, railway, reducedConnectivity, pool));
+    menus[menus.size() - 1].addMenuItem(new RandomFailures(currMenuPage, railway, reducedConnectivity, pool));
+    menus[menus.size() - 1].addMenuItem(new ChangeMenu(currMenuPage, railway, 0, &reducedConnectivity));
 }
 
 void Program::createMenu4() {
     menus.emplace_back("../src/menus/menu4");
 
-    menus[menus.size() - 1].addMenuItem(new DistrictBrute(currMenuPage, railway));
-    menus[menus.size() - 1].addMenuItem(new District(currMenuPage, railway));
+    menus[menus.size() - 1].addMenuItem(new DistrictBrute(currMenuPage, railway, pool));
+    menus[menus.size() - 1].addMenuItem(new District(currMenuPage, railway, pool));
     menus[menus.size() - 1].addMenuItem(new ChangeMenu(currMenuPage, railway, 1));
 }
 
 void Program::createMenu5() {
     menus.emplace_back("../src/menus/menu5");
 
-    menus[menus.size() - 1].addMenuItem(new MunicipalitiesBrute(currMenuPage, railway));
-    menus[menus.size() - 1].addMenuItem(new Municipalities(currMenuPage, railway));
+    menus[menus.size() - 1].addMenuItem(new MunicipalitiesBrute(currMenuPage, railway, pool));
+    menus[menus.size() - 1].addMenuItem(new Municipalities(currMenuPage, railway, pool));
     menus[menus.size() - 1].addMenuItem(new ChangeMenu(currMenuPage, railway, 1));
 }
 
@@ -154,7 +162,7 @@ void Program::cleanMenus()
 
 void Program::createMenuReducedConnectivity() {
     menus.emplace_back("../src/menus/reducedConnectivity");
-    menus[menus.size() - 1].addMenuItem(new ReducedConnectivityMaxFlow(currMenuPage, railway));
-    menus[menus.size() - 1].addMenuItem(new TopSegmentFailure(currMenuPage, railway));
-    menus[menus.size() - 1].addMenuItem(new ChangeMenu(currMenuPage, railway, 0));
+    menus[menus.size() - 1].addMenuItem(new ReducedConnectivityMaxFlow(currMenuPage, railway, reducedConnectivity));
+    menus[menus.size() - 1].addMenuItem(new TopSegmentFailure(currMenuPage, railway, reducedConnectivity, pool));
+    menus[menus.size() - 1].addMenuItem(new ChangeMenu(currMenuPage, railway, 0, &reducedConnectivity));
 }
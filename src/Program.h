@@ -7,17 +7,28 @@
 #include <vector>
 #include <iostream>
 #include "menuItems/costOptimization/MinCostMaxFlow.h"
+#include "menuItems/costOptimization/CheapestRoute.h"
+#include "menuItems/costOptimization/ExtremeCosts.h"
+#include "menuItems/costOptimization/TargetFlow.h"
 #include <limits>
 #include <set>
 #include "ExampleGraphs.h"
 #include "menuItems/general/Menu.h"
 #include "menuItems/general/MenuItem.h"
 #include "menuItems/general/ChangeMenu.h"
+#include "menuItems/general/SolverMetrics.h"
+#include "menuItems/general/MemoryReport.h"
+#include "metrics/Allocations.h"
+#include "metrics/Trace.h"
+#include "parallel/WorkStealingPool.h"
 #include "menuItems/basicServices/PairsMaxFlow.h"
+#include "menuItems/basicServices/TopPairsMaxFlow.h"
 #include "menuItems/basicServices/MaxFlowUserInput.h"
 #include "menuItems/basicServices/SinglePointMaxFlow.h"
 #include "menuItems/reliabilityAndSensivity/ReducedConnectivityMaxFlow.h"
 #include "menuItems/reliabilityAndSensivity/TopSegmentFailure.h"
+#include "menuItems/reliabilityAndSensivity/CriticalSegments.h"
+#include "menuItems/reliabilityAndSensivity/RandomFailures.h"
 #include "Scraper.h"
 #include "menuItems/basicServices/Municipalities.h"
 #include "utils.h"
@@ -38,6 +49,12 @@ private:
     /** @var program's database where airports, airlines and the flights graph are stored*/
     Graph railway;
 
+    /** @var segments disabled by the user for the reduced connectivity menu, without touching the graph */
+    Scenario reducedConnectivity;
+
+    /** @var workers shared by every analysis, so the threads are started once for the whole program */
+    WorkStealingPool pool;
+
     void createMainMenu();
     void createMenu1();
     void createMenu2();
@@ -1,4 +1,5 @@
 #include "Scraper.h"
+#include "metrics/Trace.h"
 
 using namespace std;
 
@@ -41,7 +42,7 @@ vector<unordered_map<string, vector<Vertex *>>> Scraper::scrape_stations(string
         line_map[main_line] = vec;
         municipality_map[municipality] = vec;
         district_map[district] = vec;
-        auto v = new Vertex(name, district, municipality, main_line, townships);
+        auto v = new Vertex(graph.getStationTable(), name, district, municipality, main_line, townships);
         graph.addVertex(v);
     }
 
@@ -105,36 +106,30 @@ void Scraper::getPrematureExtremes(unordered_map<string, vector<Vertex *>> &map,
     for (auto const &v: vertexSet){
         int count = 0;
         if(gh.getRegion() == LINE){
-            auto line = v.second->getLine();
-
         for (auto &e: v.second->getAdj()){
-            if (e->getDest()->getLine() == line) count++;
+            if (e->getDest()->getRegionId(LINE) == v.second->getRegionId(LINE)) count++;
         }
 
         if (count == 1 || count > 2){
-            map[line].push_back(v.second);
+            map[v.second->getLine()].push_back(v.second);
         }
     }
         else if (gh.getRegion() == MUNICIPALITIES){
-            auto municipality = v.second->getMunicipality();
-
             for (auto &e: v.second->getAdj()){
-                if (e->getDest()->getMunicipality() == municipality) count++;
+                if (e->getDest()->getRegionId(MUNICIPALITIES) == v.second->getRegionId(MUNICIPALITIES)) count++;
             }
 
             if (count == 1){
-                map[municipality].push_back(v.second);
+                map[v.second->getMunicipality()].push_back(v.second);
             }
         }
         else{
-            auto district = v.second->getDistrict();
-
             for (auto &e: v.second->getAdj()){
-                if (e->getDest()->getDistrict() == district) count++;
+                if (e->getDest()->getRegionId(DISTRICTS) == v.second->getRegionId(DISTRICTS)) count++;
             }
 
             if (count == 1 || count > 2){
-                map[district].push_back(v.second);
+                map[v.second->getDistrict()].push_back(v.second);
             }
         }
     }
@@ -176,87 +171,83 @@ void Scraper::getPrematureExtremes(unordered_map<string, vector<Vertex *>> &map,
 }
 
 void Scraper::findExtremes(vector<unordered_map<string, vector<Vertex *>>> &map, Graph &gh){
+    DirectionOptimizingBfs bfs(gh);
+    bfs.restrictTo((enum region) gh.getRegion());
+
     if(gh.getRegion() == LINE){
         getPrematureExtremes(map[0], gh);
         for (auto &p : map[0]){
-            findExtremesBFS(p.second[0], gh);
+            findExtremesBFS(p.second[0], gh, bfs);
             for (auto &v: p.second) gh.insertExtreme(v);
         }
     }else if(gh.getRegion() == MUNICIPALITIES){
         getPrematureExtremes(map[1], gh);
         for (auto &p : map[1]){
-            findExtremesBFS(p.second[0], gh);
+            findExtremesBFS(p.second[0], gh, bfs);
             for (auto &v: p.second) gh.insertExtremeMunicipality(v);
         }
     }
     else{
         getPrematureExtremes(map[2], gh);
         for (auto &p : map[2]){
-            findExtremesBFS(p.second[0], gh);
+            findExtremesBFS(p.second[0], gh, bfs);
             for (auto &v: p.second) gh.insertExtremeDistrict(v);
         }
     }
 }
 
-
-void Scraper::findExtremesBFS(Vertex* origin, Graph &gh){
-
-    for(auto &n : gh.getVertexSet()){
-        n.second->setInQueue(false);
-        n.second->setProcesssing(false);
+void Scraper::loadRailway(const string &dataDir, Graph &gh){
+    TraceScope load("startup", "loadRailway");
+    vector<unordered_map<string, vector<Vertex *>>> region_map;
+    {
+        TraceScope phase("startup", "scrape_stations");
+        region_map = scrape_stations(dataDir + "stations.csv", gh);
     }
+    {
+        TraceScope phase("startup", "scrape_networks");
+        scrape_networks(dataDir + "network.csv", gh);
+    }
+    {
+        TraceScope phase("startup", "fix_graph");
+        fix_graph(gh);
+    }
+    {
+        TraceScope phase("startup", "findExtremes (lines)");
+        gh.setRegion(LINE);
+        findExtremes(region_map, gh);
+    }
+    {
+        TraceScope phase("startup", "findExtremes (municipalities)");
+        gh.setRegion(MUNICIPALITIES);
+        findExtremes(region_map, gh);
+    }
+    {
+        TraceScope phase("startup", "findExtremes (districts)");
+        gh.setRegion(DISTRICTS);
+        findExtremes(region_map, gh);
+    }
+    {
+        TraceScope phase("startup", "setConnectedComponents");
+        gh.setConnectedComponents();
+    }
+    gh.getStationTable().shrinkToFit();
+}
 
-    queue<Vertex*> q;
-    q.push(origin);
-    origin->setInQueue(true);
-    bool isExtreme;
-
-    while (!q.empty()){
-        isExtreme = true;
-
-        auto v = q.front();
-        q.pop();
-
-
-        for(auto &e: v->getAdj()) {
-            auto w = e->getDest();
-            if(gh.getRegion() == LINE){
-                if (w->getLine() != v->getLine()) {
-                    continue;
-                }
-            }
-            else if(gh.getRegion() == MUNICIPALITIES){
-                if (w->getMunicipality() != v->getMunicipality()) {
-                    continue;
-                }
-            }
-            else{
-                if (w->getDistrict() != v->getDistrict()) {
-                    continue;
-                }
-            }
 
-            if (!w->getInQueue()) {
-                w->setInQueue(true);
-                q.push(w);
-            }
+void Scraper::findExtremesBFS(Vertex* origin, Graph &gh, DirectionOptimizingBfs &bfs){
+    // An ordered search visits the vertices in the order of a queue, so the ends of the search are the vertices whose
+    // neighbours in the region were all dequeued before them
+    bfs.search(bfs.indexOf(origin), true);
 
-            if (!w->isProcessing()) {
-                isExtreme = false;
-            }
+    for (int v: bfs.getSearchEnds()){
+        if (gh.getRegion() == LINE){
+            gh.insertExtreme(bfs.getVertex(v));
         }
-
-        if (isExtreme){
-            if (gh.getRegion() == LINE){
-                gh.insertExtreme(v);
-            }
-            else if (gh.getRegion() == MUNICIPALITIES){
-                gh.insertExtremeMunicipality(v);
-            }
-            else{
-                gh.insertExtremeDistrict(v);
-            }
+        else if (gh.getRegion() == MUNICIPALITIES){
+            gh.insertExtremeMunicipality(bfs.getVertex(v));
+        }
+        else{
+            gh.insertExtremeDistrict(bfs.getVertex(v));
         }
-        v->setProcesssing(true);
     }
 }
@@ -8,6 +8,7 @@
 #include <unordered_set>
 #include <map>
 #include "graph/Graph.h"
+#include "graph/DirectionOptimizingBfs.h"
 
 
 using namespace std;
@@ -51,12 +52,22 @@ public:
 
     /**
      * Finds the extremes of the graph according to lines, municipalities and districts, and adds them to the different extreme vectors;
-     * Time Complexity: O(P*(V+E)), where V is the number of vertices in the graph, E is the number of edges in the graph and P is the number of extreme vertices;
+     * Time Complexity: O(V*log(V) + E + P*(R+F)), where V is the number of vertices in the graph, E is the number of edges in the graph, P is the number of regions and R and F are the number of stations and edges of a region;
      * @param map - the vector of unordered_maps containing all the stations of the graph;
      * @param gh - the graph used to find the extremes;
      */
     static void findExtremes(vector<unordered_map<string, vector<Vertex *>>> &map, Graph &gh);
 
+    /**
+     * Loads the railway in a data directory: scrapes its stations and networks, removes the stations with no segments, finds
+     * the extremes of every line, municipality and district and sets the connected components of the graph;
+     * Time Complexity: O(L + P*(V+E)), where L is the number of lines in the files, V is the number of vertices in the graph,
+     * E is the number of edges in the graph and P is the number of extreme vertices;
+     * @param dataDir - the directory with the stations.csv and network.csv files, ending with a slash
+     * @param gh - the graph to which the railway will be added
+     */
+    static void loadRailway(const string &dataDir, Graph &gh);
+
 private:
     /**
      * Finds the extremes based on only if a vertex only has one adjacent edge, or if it has more than two adjacent edges;
@@ -68,11 +79,13 @@ private:
 
     /**
      * Runs a BFS starting at the node origin and finds all the remaining extremes of the graph, adding them to the extreme vectors;
-     * Time Complexity: O(V+E), where V is the number of vertices in the graph and E is the number of edges in the graph;
+     * A vertex is an extreme when the BFS reached all its neighbours of the same region before it;
+     * Time Complexity: O(R+F), where R is the number of vertices in the region of origin and F is the number of edges leaving them;
      * @param origin - the vertex from which the BFS will start;
      * @param gh - the graph used to find the extremes;
+     * @param bfs - the traversal of the graph, restricted to the current region of gh;
      */
-    static void findExtremesBFS(Vertex *origin, Graph &gh);
+    static void findExtremesBFS(Vertex *origin, Graph &gh, DirectionOptimizingBfs &bfs);
 };
 
 
@@ -0,0 +1,892 @@
+#include <chrono>
+#include <cmath>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <random>
+#include "Scraper.h"
+#include "graph/CheapestCostMatrix.h"
+#include "graph/DirectionOptimizingBfs.h"
+#include "graph/FlowKernels.h"
+#include "graph/FlowNetwork.h"
+#include "graph/MemoryFootprint.h"
+#include "graph/MinCostSession.h"
+#include "graph/RegionSolver.h"
+#include "graph/ScenarioReachability.h"
+#include "graph/SegmentCriticality.h"
+#include "graph/UndirectedFlowNetwork.h"
+#include "metrics/Allocations.h"
+#include "metrics/Metrics.h"
+#include "metrics/Trace.h"
+#include "parallel/WorkStealingPool.h"
+
+using namespace std;
+
+/**
+ * Runs a workload and prints its wall time, the solver metrics it produced and the allocations of the calling thread.
+ * @param name - the name of the workload
+ * @param workload - the workload
+ */
+void runWorkload(const string &name, const function<void()> &workload) {
+    MetricsSnapshot before = Metrics::collect();
+    AllocationStats allocations;
+    auto start = chrono::steady_clock::now();
+    {
+        TraceScope trace("bench", name);
+        Allocations::Scope scope;
+        workload();
+        allocations = scope.getStats();
+    }
+    double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+    cout << "== " << name << " (" << ms << " ms)" << endl;
+    Metrics::print(cout, Metrics::collect() - before);
+    cout << "Caller thread: " << allocations.count << " allocations, " << allocations.bytes << " bytes, peak "
+         << allocations.peak << " bytes" << endl << endl;
+}
+
+/**
+ * Checks that a solver doesn't allocate once its workspace is set up, by running it again over every pair after a first
+ * call. An allocation in the solve loop is a regression, so it is reported on the error stream.
+ * @tparam Workspace - the type of the workspace of the solver
+ * @tparam Solve - the type of the solver call
+ * @param name - the name of the solver
+ * @param pairs - the source and sink of each call
+ * @param solve - runs the solver for a pair, with a workspace that is reused by every call
+ * @return true if no call allocated, false otherwise
+ */
+template <class Workspace = FlowWorkspace, class Solve>
+bool checkNoAllocations(const string &name, const vector<pair<int, int>> &pairs, const Solve &solve) {
+    if (pairs.empty() || !Allocations::isTracking()) return true;
+
+    Workspace ws;
+    solve(pairs[0].first, pairs[0].second, ws);
+
+    Allocations::Scope scope;
+    for (auto &pa: pairs)
+        solve(pa.first, pa.second, ws);
+    AllocationStats stats = scope.getStats();
+
+    if (stats.count == 0) {
+        cout << name << ": no allocations in " << pairs.size() << " calls" << endl;
+        return true;
+    }
+
+    cerr << "ALLOCATION REGRESSION: " << name << " allocated " << stats.count << " times (" << stats.bytes
+         << " bytes) in " << pairs.size() << " calls with a set up workspace" << endl;
+    return false;
+}
+
+/**
+ * Draws pairs of distinct stations, always the same ones for the same network.
+ * @param network - the network
+ * @param count - the number of pairs
+ * @return the indices of the stations of each pair
+ */
+vector<pair<int, int>> drawPairs(const FlowNetwork &network, int count) {
+    mt19937 rng(5489);
+    int stations = network.getSuperSource();
+    uniform_int_distribution<int> pick(0, stations - 1);
+
+    vector<pair<int, int>> pairs;
+    while ((int) pairs.size() < count && stations > 1) {
+        int s = pick(rng), t = pick(rng);
+        if (s != t) pairs.emplace_back(s, t);
+    }
+
+    return pairs;
+}
+
+/**
+ * Times the max flows between pairs of stations over a network with other capacity and cost types than the 32-bit one,
+ * and checks that their values, and the costs of the min cost max flows of the first 100 pairs, match the 32-bit ones.
+ * A mismatch is reported on the error stream.
+ * @tparam Network - the type of the network
+ * @param name - the name of the capacity and cost types
+ * @param railway - the railway graph
+ * @param network - the 32-bit network of the railway, with a super source
+ * @param pairs - the pairs of stations
+ * @param pool - the pool that runs the solves
+ * @return true if every value matched, false otherwise
+ */
+template <class Network>
+bool checkFlowTypes(const string &name, const Graph &railway, const FlowNetwork &network,
+                    const vector<pair<int, int>> &pairs, WorkStealingPool &pool) {
+    typedef typename Network::Workspace Workspace;
+    Network other(railway, railway.getExtremes());
+    size_t costed = min<size_t>(pairs.size(), 100);
+    vector<double> flows(pairs.size()), costs(costed);
+
+    runWorkload("Max flow between " + to_string(pairs.size()) + " pairs of stations (" + name + ")", [&]() {
+        pool.parallelFor<Workspace>(pairs.size(), [&](size_t i, Workspace &ws) {
+            flows[i] = (double) other.maxFlow(pairs[i].first, pairs[i].second, ws);
+        });
+    });
+    pool.parallelFor<Workspace>(costed, [&](size_t i, Workspace &ws) {
+        other.minCostMaxFlow(pairs[i].first, pairs[i].second, ws);
+        costs[i] = (double) other.getResult(ws).cost;
+    });
+
+    int mismatches = 0;
+    FlowWorkspace ws;
+    for (size_t i = 0; i < pairs.size(); i++) {
+        if (network.maxFlow(pairs[i].first, pairs[i].second, ws) != flows[i]) mismatches++;
+        if (i < costed) {
+            network.minCostMaxFlow(pairs[i].first, pairs[i].second, ws);
+            if (network.getResult(ws).cost != costs[i]) mismatches++;
+        }
+    }
+
+    if (mismatches == 0) return true;
+    cerr << "FLOW TYPE MISMATCH: " << name << " differs from 32-bit in " << mismatches << " values" << endl;
+    return false;
+}
+
+/**
+ * Times the max flows from the super source into each station and between pairs of stations over the undirected network,
+ * and checks that their values, and the min cuts of the first 100 pairs, match the ones of the directed network.
+ * A mismatch is reported on the error stream.
+ * @param network - the directed network of the railway, with a super source
+ * @param undirected - the undirected network of the railway, with the same super source
+ * @param pairs - the pairs of stations
+ * @param pool - the pool that runs the solves
+ * @return true if every value and cut matched, false otherwise
+ */
+bool checkUndirected(const FlowNetwork &network, const UndirectedFlowNetwork &undirected,
+                     const vector<pair<int, int>> &pairs, WorkStealingPool &pool) {
+    int stations = network.getSuperSource();
+    vector<int> stationFlows(stations), flows(pairs.size());
+
+    runWorkload("Max flow from every line extreme into each station (undirected)", [&]() {
+        pool.parallelFor<UndirectedFlowWorkspace>(stations, [&](size_t v, UndirectedFlowWorkspace &ws) {
+            stationFlows[v] = undirected.maxFlow(undirected.getSuperSource(), (int) v, ws);
+        });
+    });
+    runWorkload("Max flow between " + to_string(pairs.size()) + " pairs of stations (undirected)", [&]() {
+        pool.parallelFor<UndirectedFlowWorkspace>(pairs.size(), [&](size_t i, UndirectedFlowWorkspace &ws) {
+            flows[i] = undirected.maxFlow(pairs[i].first, pairs[i].second, ws);
+        });
+    });
+
+    int mismatches = 0;
+    FlowWorkspace ws;
+    UndirectedFlowWorkspace uws;
+    for (int v = 0; v < stations; v++)
+        if (network.maxFlow(network.getSuperSource(), v, ws) != stationFlows[v]) mismatches++;
+    for (size_t i = 0; i < pairs.size(); i++) {
+        if (network.maxFlow(pairs[i].first, pairs[i].second, ws) != flows[i]) mismatches++;
+        if (i >= 100) continue;
+
+        undirected.maxFlow(pairs[i].first, pairs[i].second, uws);
+        for (int v = 0; v < network.getSize(); v++)
+            if (network.isSourceSide(v, ws) != undirected.isSourceSide(v, uws)) mismatches++;
+    }
+
+    if (mismatches == 0) return true;
+    cerr << "UNDIRECTED MISMATCH: the undirected network differs from the directed one in " << mismatches << " values"
+         << endl;
+    return false;
+}
+
+/**
+ * Times a max flow workload with the augmenting paths searched from the source only and then from both ends, and checks
+ * that both give the same values and min cuts. A mismatch is reported on the error stream.
+ * @tparam Network - the type of the network
+ * @param name - the name of the workload
+ * @param network - the network
+ * @param pairs - the source and sink of each max flow
+ * @param pool - the pool that runs the solves
+ * @return true if every value and cut matched, false otherwise
+ */
+template <class Network>
+bool checkBidirectional(const string &name, const Network &network, const vector<pair<int, int>> &pairs,
+                        WorkStealingPool &pool) {
+    typedef typename Network::Workspace Workspace;
+    int n = network.getSize();
+    size_t cuts = min<size_t>(pairs.size(), 100);
+    vector<vector<long long>> flows(2, vector<long long>(pairs.size()));
+    vector<vector<bool>> sourceSides(2, vector<bool>(cuts * n));
+
+    for (int bidirectional = 0; bidirectional < 2; bidirectional++) {
+        runWorkload(name + (bidirectional ? " (bidirectional search)" : " (single-ended search)"), [&]() {
+            pool.parallelFor<Workspace>(pairs.size(), [&](size_t i, Workspace &ws) {
+                ws.bidirectional = bidirectional;
+                flows[bidirectional][i] = (long long) network.maxFlow(pairs[i].first, pairs[i].second, ws);
+                if (i >= cuts) return;
+
+                for (int v = 0; v < n; v++)
+                    sourceSides[bidirectional][i * n + v] = network.isSourceSide(v, ws);
+            });
+        });
+    }
+
+    if (flows[0] == flows[1] && sourceSides[0] == sourceSides[1]) return true;
+    cerr << "BIDIRECTIONAL MISMATCH: " << name << " differs from the single-ended search" << endl;
+    return false;
+}
+
+/**
+ * Times the min cost max flows between pairs of stations with each search for the cheapest augmenting paths, and checks
+ * that every engine finds the same values and costs. Cost scaling is only timed over integer capacities and costs, the
+ * only ones it runs on. A mismatch is reported on the error stream.
+ * @tparam Network - the type of the network
+ * @param name - the name of the workload
+ * @param network - the network
+ * @param pairs - the source and sink of each min cost max flow
+ * @param pool - the pool that runs the solves
+ * @return true if every value and cost matched, false otherwise
+ */
+template <class Network>
+bool checkMinCostEngines(const string &name, const Network &network, const vector<pair<int, int>> &pairs,
+                         WorkStealingPool &pool) {
+    typedef typename Network::Workspace Workspace;
+    typedef typename decltype(Workspace::flow)::value_type Cap;
+    typedef typename decltype(Workspace::price)::value_type Cost;
+    vector<pair<enum minCostEngine, string>> engines = {{BELLMAN_FORD, "Bellman-Ford"},
+                                                         {BUCKET_DIJKSTRA, "Dijkstra with a bucket queue"}};
+    // Without exact types cost scaling falls back to Dijkstra, so it would only time Dijkstra again
+    if (FlowTraits<Cap>::exact && FlowTraits<Cost>::exact)
+        engines.emplace_back(COST_SCALING, "cost scaling");
+    vector<vector<double>> values(engines.size(), vector<double>(pairs.size()));
+    vector<vector<double>> costs(engines.size(), vector<double>(pairs.size()));
+
+    for (size_t e = 0; e < engines.size(); e++) {
+        runWorkload(name + " (" + engines[e].second + ")", [&]() {
+            pool.parallelFor<Workspace>(pairs.size(), [&](size_t i, Workspace &ws) {
+                ws.engine = engines[e].first;
+                values[e][i] = (double) network.minCostMaxFlow(pairs[i].first, pairs[i].second, ws);
+                costs[e][i] = (double) network.getResult(ws).cost;
+            });
+        });
+    }
+
+    int mismatches = 0;
+    for (size_t e = 1; e < engines.size(); e++) {
+        for (size_t i = 0; i < pairs.size(); i++)
+            if (abs(values[e][i] - values[0][i]) > 1e-6 || abs(costs[e][i] - costs[0][i]) > 1e-6) mismatches++;
+    }
+
+    if (mismatches == 0) return true;
+    cerr << "MIN COST MISMATCH: " << name << " differs between the engines in " << mismatches << " solves" << endl;
+    return false;
+}
+
+/**
+ * Times the cheapest flows of one unit and of half the max flow between pairs of stations, next to their min cost max
+ * flows, and checks that each one costs what the first units of the marginal costs of the max flow add up to.
+ * A mismatch is reported on the error stream.
+ * @param name - the name of the workload
+ * @param network - the network
+ * @param pairs - the source and sink of each flow
+ * @param pool - the pool that runs the solves
+ * @return true if every value and cost matched, false otherwise
+ */
+bool checkTargetFlows(const string &name, const FlowNetwork &network, const vector<pair<int, int>> &pairs,
+                      WorkStealingPool &pool) {
+    vector<int> maxFlows(pairs.size());
+    vector<vector<pair<int, int>>> curves(pairs.size());
+    runWorkload(name + " (max flow)", [&]() {
+        pool.parallelFor<FlowWorkspace>(pairs.size(), [&](size_t i, FlowWorkspace &ws) {
+            ws.engine = BUCKET_DIJKSTRA;
+            maxFlows[i] = network.minCostMaxFlow(pairs[i].first, pairs[i].second, ws);
+            curves[i] = ws.marginalCosts;
+        });
+    });
+
+    int mismatches = 0;
+    for (int half = 0; half < 2; half++) {
+        vector<int> targets(pairs.size()), values(pairs.size()), costs(pairs.size());
+        for (size_t i = 0; i < pairs.size(); i++)
+            targets[i] = half ? max(1, maxFlows[i] / 2) : 1;
+
+        runWorkload(name + (half ? " (half the max flow)" : " (one unit)"), [&]() {
+            pool.parallelFor<FlowWorkspace>(pairs.size(), [&](size_t i, FlowWorkspace &ws) {
+                ws.engine = BUCKET_DIJKSTRA;
+                values[i] = network.minCostFlow(pairs[i].first, pairs[i].second, targets[i], ws);
+                costs[i] = network.getResult(ws).cost;
+            });
+        });
+
+        for (size_t i = 0; i < pairs.size(); i++) {
+            int remaining = min(targets[i], maxFlows[i]), cost = 0;
+            for (auto &step: curves[i]) {
+                int units = min(step.first, remaining);
+                cost += units * step.second;
+                remaining -= units;
+            }
+            if (values[i] != min(targets[i], maxFlows[i]) || costs[i] != cost) mismatches++;
+        }
+    }
+
+    if (mismatches == 0) return true;
+    cerr << "TARGET FLOW MISMATCH: " << name << " differs from the marginal costs in " << mismatches << " solves"
+         << endl;
+    return false;
+}
+
+/**
+ * Times a what-if session of min cost max flows between two stations while the capacities and costs of random segments
+ * change, one more per query. Each query is solved once re-optimizing the one before it and once cold, and both must find
+ * the same values and costs. Queries to other stations aren't timed, since the session solves them cold. A mismatch is
+ * reported on the error stream.
+ * @param name - the name of the workload
+ * @param network - the network
+ * @param query - the source and sink of every query
+ * @return true if every value and cost matched, false otherwise
+ */
+bool checkWarmStarts(const string &name, const FlowNetwork &network, const pair<int, int> &query) {
+    int s = query.first, t = query.second;
+    if (s == t) return true;
+
+    mt19937 rng(5489);
+    uniform_int_distribution<int> pickArc(0, network.getArcCount() - 1), pickCapacity(1, 10), pickCost(1, 6);
+    vector<Scenario> scenarios;
+    Scenario scenario;
+    for (int i = 0; i < 50; i++) {
+        Edge *e = network.getEdge(pickArc(rng));
+        if (e == nullptr) continue;
+        if (i % 2 == 0) scenario.setCapacity(e, pickCapacity(rng));
+        else scenario.setCost(e, pickCost(rng));
+        scenarios.push_back(scenario);
+    }
+
+    size_t n = scenarios.size();
+    vector<vector<int>> values(2, vector<int>(n)), costs(2, vector<int>(n));
+    runWorkload(name + " (cold)", [&]() {
+        FlowWorkspace ws;
+        ws.engine = BUCKET_DIJKSTRA;
+        for (size_t i = 0; i < n; i++) {
+            network.prepare(ws, scenarios[i]);
+            values[0][i] = network.minCostMaxFlow(s, t, ws);
+            costs[0][i] = network.getResult(ws).cost;
+        }
+    });
+
+    MinCostSession session(network);
+    runWorkload(name + " (warm)", [&]() {
+        for (size_t i = 0; i < n; i++) {
+            values[1][i] = session.solve(s, t, scenarios[i]);
+            costs[1][i] = session.getResult().cost;
+        }
+    });
+    cout << "Warm solves: " << session.getWarmSolves() << ", cold solves: " << session.getColdSolves() << endl << endl;
+
+    if (values[0] == values[1] && costs[0] == costs[1]) return true;
+    cerr << "WARM START MISMATCH: " << name << " differs between the warm and the cold solves" << endl;
+    return false;
+}
+
+/**
+ * Times the matrix of cheapest costs between every pair of line extremes, and checks that it is symmetric and that the
+ * routes of the first 100 pairs cost what the matrix says. A mismatch is reported on the error stream.
+ * @param railway - the railway graph
+ * @param pool - the pool that searches the rows
+ * @return true if every cost matched, false otherwise
+ */
+bool checkCheapestCosts(const Graph &railway, WorkStealingPool &pool) {
+    FlowNetwork network(railway);
+    vector<int> stations;
+    for (Vertex *v: railway.getExtremes())
+        stations.push_back(network.indexOf(v));
+    sort(stations.begin(), stations.end());
+
+    unique_ptr<CheapestCostMatrix> matrix;
+    runWorkload("Cheapest costs between " + to_string(stations.size()) + " line extremes", [&]() {
+        matrix.reset(new CheapestCostMatrix(network, stations, pool));
+    });
+
+    int mismatches = 0, checked = 0;
+    FlowWorkspace ws;
+    for (int i = 0; i < matrix->getSize(); i++) {
+        for (int j = 0; j < matrix->getSize(); j++) {
+            if (matrix->getCost(i, j) != matrix->getCost(j, i)) mismatches++;
+            if (i == j || checked >= 100) continue;
+
+            checked++;
+            int cost = network.cheapestRoute(stations[i], stations[j], ws), routeCost = 0;
+            for (int a: network.getRoute(stations[j], ws))
+                routeCost += network.getArcCost(a);
+            if (cost != matrix->getCost(i, j) || (cost != FlowTraits<int>::infinity() && cost != routeCost))
+                mismatches++;
+        }
+    }
+
+    if (mismatches == 0) return true;
+    cerr << "CHEAPEST COST MISMATCH: the matrix differs from the routes in " << mismatches << " values" << endl;
+    return false;
+}
+
+/**
+ * Times the region reports with the augmenting paths searched from the source only and then from both ends, and checks
+ * that both leave the same flow on every station. A mismatch is reported on the error stream.
+ * @param railway - the railway graph
+ * @param pool - the pool that runs the regions
+ * @return true if every flow matched, false otherwise
+ */
+bool checkBidirectionalRegions(const Graph &railway, WorkStealingPool &pool) {
+    bool clean = true;
+    for (enum region r: {MUNICIPALITIES, DISTRICTS}) {
+        string name = r == MUNICIPALITIES ? "municipality" : "district";
+        vector<vector<int>> flows(2);
+
+        for (int bidirectional = 0; bidirectional < 2; bidirectional++) {
+            for (auto &pa: railway.getVertexSet())
+                pa.second->setFlow(0);
+
+            RegionSolver solver(railway, r, bidirectional);
+            runWorkload("Max flow between the extremes of each " + name +
+                        (bidirectional ? " (bidirectional search)" : " (single-ended search)"), [&]() {
+                solver.solveExtremePairs(railway.getExtremes(), pool);
+            });
+            runWorkload("Gomory-Hu tree of each " + name +
+                        (bidirectional ? " (bidirectional search)" : " (single-ended search)"), [&]() {
+                solver.solveAllPairs(pool);
+            });
+
+            for (auto &pa: railway.getVertexSet())
+                flows[bidirectional].push_back(pa.second->getFlow());
+        }
+
+        if (flows[0] != flows[1]) {
+            cerr << "BIDIRECTIONAL MISMATCH: " << name << " flows differ from the single-ended search" << endl;
+            clean = false;
+        }
+    }
+
+    return clean;
+}
+
+/**
+ * Builds a synthetic railway with long, sparse lines: lines of 100 stations in a row, each joined to the previous one at
+ * its first station, and its middle station joined to a random earlier station, so the network is one large component. Every 50th
+ * line is left unjoined, as a component of its own.
+ * @param gh - the graph to which the stations are added
+ * @param stations - the number of stations
+ */
+void buildSyntheticRailway(Graph &gh, int stations) {
+    mt19937 rng(5489);
+    const int lineLength = 100;
+
+    for (int i = 0; i < stations; i++) {
+        int line = i / lineLength;
+        gh.addVertex(new Vertex(gh.getStationTable(), "S" + to_string(i), "District" + to_string(line / 20),
+                                "Municipality" + to_string(line / 4), "Line" + to_string(line), {}));
+    }
+
+    for (int i = 1; i < stations; i++) {
+        int line = i / lineLength;
+        if (i % lineLength != 0)
+            gh.addBidirectionalEdge("S" + to_string(i - 1), "S" + to_string(i), 2, STANDARD);
+        else if (line % 50 != 0) {
+            gh.addBidirectionalEdge("S" + to_string(i - lineLength), "S" + to_string(i), 2, STANDARD);
+            uniform_int_distribution<int> pick(0, i - 1);
+            int middle = min(i + lineLength / 2, stations - 1);
+            gh.addBidirectionalEdge("S" + to_string(pick(rng)), "S" + to_string(middle), 1, ALFA_PENDULAR);
+        }
+    }
+}
+
+/**
+ * Builds a synthetic railway for the min cost engines: a square grid of stations where each segment gets a random
+ * capacity from 1 to 10 and a random service, so there are many routes of different costs between two stations. The
+ * stations of the border are returned as the extremes, the sources of the super source.
+ * @param gh - the graph to which the stations are added
+ * @param side - the number of stations of each side of the grid
+ * @return the stations of the border
+ */
+unordered_set<Vertex *> buildSyntheticGrid(Graph &gh, int side) {
+    mt19937 rng(5489);
+    uniform_int_distribution<int> capacity(1, 10), service(0, 1);
+    unordered_set<Vertex *> border;
+
+    for (int i = 0; i < side * side; i++) {
+        auto v = new Vertex(gh.getStationTable(), "G" + to_string(i), "District", "Municipality", "Line" + to_string(i / side), {});
+        gh.addVertex(v);
+        int row = i / side, column = i % side;
+        if (row == 0 || column == 0 || row == side - 1 || column == side - 1) border.insert(v);
+    }
+
+    for (int i = 0; i < side * side; i++) {
+        if (i % side != side - 1)
+            gh.addBidirectionalEdge("G" + to_string(i), "G" + to_string(i + 1), capacity(rng),
+                                    service(rng) ? ALFA_PENDULAR : STANDARD);
+        if (i + side < side * side)
+            gh.addBidirectionalEdge("G" + to_string(i), "G" + to_string(i + side), capacity(rng),
+                                    service(rng) ? ALFA_PENDULAR : STANDARD);
+    }
+
+    return border;
+}
+
+/**
+ * Labels the connected components of a graph with a queue based BFS over its Vertex and Edge objects, the way the
+ * traversals worked before DirectionOptimizingBfs.
+ * @param gh - the graph
+ * @param bfs - the traversal whose indices and seed order are used
+ * @return the component of each vertex, numbered like DirectionOptimizingBfs::labelComponents
+ */
+vector<int> labelComponentsWithQueue(const Graph &gh, const DirectionOptimizingBfs &bfs) {
+    for (auto &pa: gh.getVertexSet())
+        pa.second->setVisited(false);
+    vector<int> component(bfs.getSize(), 0);
+    int components = 0;
+
+    for (auto &pa: gh.getVertexSet()) {
+        if (pa.second->isVisited()) continue;
+
+        components++;
+        queue<Vertex *> q;
+        q.push(pa.second);
+        pa.second->setVisited(true);
+        while (!q.empty()) {
+            Vertex *v = q.front();
+            q.pop();
+            component[bfs.indexOf(v)] = components;
+
+            for (Edge *e: v->getAdj()) {
+                if (e->getDest()->isVisited()) continue;
+                e->getDest()->setVisited(true);
+                q.push(e->getDest());
+            }
+        }
+    }
+
+    return component;
+}
+
+/**
+ * Times the plain traversals over a synthetic railway: connected components with a queue over the Vertex objects, and
+ * with the direction-optimizing BFS on one thread and over a pool. A difference in the components is reported on the
+ * error stream.
+ * @param stations - the number of stations of the synthetic railway
+ * @param pool - the pool that expands the bottom-up levels
+ * @return true if every traversal found the same components, false otherwise
+ */
+bool checkTraversals(int stations, WorkStealingPool &pool) {
+    Graph synthetic;
+    runWorkload("Build a synthetic railway of " + to_string(stations) + " stations", [&]() {
+        buildSyntheticRailway(synthetic, stations);
+    });
+
+    DirectionOptimizingBfs bfs(synthetic);
+    vector<int> seeds;
+    for (auto &pa: synthetic.getVertexSet())
+        seeds.push_back(bfs.indexOf(pa.second));
+
+    vector<int> expected, found, parallel;
+    runWorkload("Connected components (queue over the vertices)", [&]() {
+        expected = labelComponentsWithQueue(synthetic, bfs);
+    });
+    runWorkload("Connected components (direction-optimizing BFS)", [&]() {
+        found = bfs.labelComponents(seeds);
+    });
+    bfs.setPool(&pool);
+    runWorkload("Connected components (direction-optimizing BFS, " + to_string(pool.getThreadCount()) + " threads)",
+                [&]() {
+        parallel = bfs.labelComponents(seeds);
+    });
+
+    int reached = bfs.search(seeds[0]);
+    int reachedInOrder = bfs.search(seeds[0], true);
+    int expectedReach = count(expected.begin(), expected.end(), expected[seeds[0]]);
+
+    if (found == expected && parallel == expected && reached == expectedReach && reachedInOrder == expectedReach)
+        return true;
+    cerr << "TRAVERSAL MISMATCH: the direction-optimizing BFS differs from the queue based one" << endl;
+    return false;
+}
+
+/**
+ * Finds the stations cut off from every line extreme in each failure scenario with a plain BFS from the super source per
+ * scenario.
+ * @param network - the network, with a super source
+ * @param failedArcs - an arc of each failed segment, for each scenario
+ * @return the indices of the stations cut off in each scenario
+ */
+vector<vector<int>> findDisconnectedWithBfs(const FlowNetwork &network, const vector<vector<int>> &failedArcs) {
+    vector<vector<int>> disconnected(failedArcs.size());
+    vector<char> down(network.getArcCount(), false), reached(network.getSize());
+    vector<int> queue;
+
+    for (size_t s = 0; s < failedArcs.size(); s++) {
+        for (int a: failedArcs[s])
+            down[a] = down[network.getArcReverse(a)] = true;
+
+        fill(reached.begin(), reached.end(), false);
+        queue.assign(1, network.getSuperSource());
+        reached[network.getSuperSource()] = true;
+        for (size_t head = 0; head < queue.size(); head++) {
+            int v = queue[head];
+            for (int i = 0; i < network.getOutDegree(v); i++) {
+                int a = network.getOutArc(v, i), w = network.getArcDest(a);
+                if (down[a] || network.isArcDisabled(a) || reached[w]) continue;
+                reached[w] = true;
+                queue.push_back(w);
+            }
+        }
+
+        for (int v = 0; v < network.getSuperSource(); v++)
+            if (!reached[v]) disconnected[s].push_back(v);
+        for (int a: failedArcs[s])
+            down[a] = down[network.getArcReverse(a)] = false;
+    }
+
+    return disconnected;
+}
+
+/**
+ * Finds the stations cut off from every line extreme in each failure scenario with one bit-parallel search over N
+ * scenarios at a time.
+ * @tparam N - the number of scenarios of each search
+ * @param network - the network, with a super source
+ * @param failedArcs - an arc of each failed segment, for each scenario
+ * @return the indices of the stations cut off in each scenario
+ */
+template <size_t N>
+vector<vector<int>> findDisconnectedWithMasks(const FlowNetwork &network, const vector<vector<int>> &failedArcs) {
+    vector<vector<int>> disconnected(failedArcs.size());
+    ScenarioReachability<N> reachability(network);
+    vector<typename ScenarioReachability<N>::Mask> reach;
+    vector<vector<int>> block;
+
+    for (size_t first = 0; first < failedArcs.size(); first += N) {
+        block.assign(failedArcs.begin() + first, failedArcs.begin() + min(first + N, failedArcs.size()));
+        reachability.setScenarios(block);
+        reachability.findReachable(network.getSuperSource(), reach);
+        for (size_t s = 0; s < block.size(); s++)
+            reachability.getDisconnected(reach, s, disconnected[first + s]);
+    }
+
+    return disconnected;
+}
+
+/**
+ * Times the search for the stations cut off from every line extreme over random failure scenarios, with a plain BFS per
+ * scenario and with the bit-parallel searches over 64 and 256 scenarios, and prints the scenarios handled per second by
+ * each. A difference in the stations found is reported on the error stream.
+ * @param network - the network of the railway, with a super source
+ * @param scenarios - the number of scenarios
+ * @param probability - the probability of failure of each segment
+ * @return true if every search found the same stations, false otherwise
+ */
+bool checkScenarioReachability(const FlowNetwork &network, int scenarios, double probability) {
+    mt19937_64 rng(5489);
+    uniform_real_distribution<double> unit(0, 1);
+    vector<int> segments = network.getSegments();
+    vector<vector<int>> failedArcs(scenarios);
+    for (auto &failed: failedArcs)
+        for (int a: segments)
+            if (unit(rng) < probability)
+                failed.push_back(a);
+
+    vector<vector<int>> expected, found64, found256;
+    auto timeSearch = [&](const string &engine, const function<vector<vector<int>>()> &search, vector<vector<int>> &found) {
+        double ms = 0;
+        runWorkload("Stations cut off from every line extreme in " + to_string(scenarios) + " scenarios (" + engine + ")",
+                    [&]() {
+            auto start = chrono::steady_clock::now();
+            found = search();
+            ms = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+        });
+        cout << engine << ": " << (long long) (scenarios / ms * 1000) << " scenarios/s" << endl << endl;
+    };
+    timeSearch("BFS per scenario", [&]() { return findDisconnectedWithBfs(network, failedArcs); }, expected);
+    timeSearch("64 scenarios per search", [&]() { return findDisconnectedWithMasks<64>(network, failedArcs); }, found64);
+    timeSearch("256 scenarios per search", [&]() { return findDisconnectedWithMasks<256>(network, failedArcs); },
+               found256);
+
+    if (found64 == expected && found256 == expected) return true;
+    cerr << "REACHABILITY MISMATCH: the bit-parallel searches differ from the BFS per scenario" << endl;
+    return false;
+}
+
+/**
+ * Times the bookkeeping over the whole flow arrays of a few solved workspaces (the cost of each flow and the net flow out
+ * of the super source, which reaches every line extreme) with the scalar kernels and, when the processor has them, with
+ * the AVX2 ones, and checks that both give the same sums. A mismatch is reported on the error stream.
+ * @param network - the directed network of the railway, with a super source
+ * @param undirected - the undirected network of the railway, with the same super source
+ * @param pairs - the source and sink of each solve
+ * @return true if every sum matched, false otherwise
+ */
+bool checkKernels(const FlowNetwork &network, const UndirectedFlowNetwork &undirected,
+                  const vector<pair<int, int>> &pairs) {
+    const int ROUNDS = 1000;
+    vector<FlowWorkspace> solved(min<size_t>(pairs.size(), 100));
+    vector<UndirectedFlowWorkspace> undirectedSolved(solved.size());
+    for (size_t i = 0; i < solved.size(); i++) {
+        network.minCostMaxFlow(pairs[i].first, pairs[i].second, solved[i]);
+        undirected.maxFlow(pairs[i].first, pairs[i].second, undirectedSolved[i]);
+    }
+
+    vector<int> costs(network.getArcCount());
+    for (int a = 0; a < network.getArcCount(); a++)
+        costs[a] = network.getArcCost(a);
+
+    bool simd = FlowKernels::isSimd();
+    vector<long long> sums;
+    for (bool useSimd: {false, true}) {
+        if (FlowKernels::setSimd(useSimd) != useSimd) continue;
+
+        long long sum = 0;
+        runWorkload(string("Flow bookkeeping of ") + to_string(solved.size()) + " solves (" +
+                    (useSimd ? "AVX2" : "scalar") + " kernels)", [&]() {
+            for (int round = 0; round < ROUNDS; round++) {
+                for (size_t i = 0; i < solved.size(); i++) {
+                    sum += FlowKernels::sumProducts(solved[i].flow, costs);
+                    sum += network.getFlowInto(network.getSuperSource(), solved[i]);
+                    sum += undirected.getFlowInto(undirected.getSuperSource(), undirectedSolved[i]);
+                }
+            }
+        });
+        sums.push_back(sum);
+    }
+    FlowKernels::setSimd(simd);
+
+    if (count(sums.begin(), sums.end(), sums[0]) == (int) sums.size()) return true;
+    cerr << "KERNEL MISMATCH: the AVX2 kernels differ from the scalar ones" << endl;
+    return false;
+}
+
+/**
+ * Benchmark of the flow solvers over the railway: times a few workloads that are representative of the menus and shows
+ * what the solvers did in each of them.
+ * Usage: project_railway_bench [data directory, "../src/data/" by default] [stations of the synthetic railway, 200000 by
+ * default]
+ */
+int main(int argc, char *argv[]) {
+    Trace::setThreadName("main");
+    string dataDir = argc > 1 ? argv[1] : "../src/data/";
+    if (dataDir.back() != '/') dataDir += '/';
+
+    Graph railway;
+    runWorkload("Load railway", [&]() { Scraper::loadRailway(dataDir, railway); });
+    if (railway.getVertexSet().empty()) {
+        cerr << "No stations found in " << dataDir << endl;
+        return 1;
+    }
+
+    FlowNetwork network(railway, railway.getExtremes());
+    WorkStealingPool pool;
+    cout << network.getSuperSource() << " stations, " << network.getArcCount() << " arcs, " << pool.getThreadCount()
+         << " threads" << endl << endl;
+
+    runWorkload("Max flow from every line extreme into each station", [&]() {
+        pool.parallelFor<FlowWorkspace>(network.getSuperSource(), [&](size_t v, FlowWorkspace &ws) {
+            network.maxFlow(network.getSuperSource(), (int) v, ws);
+        });
+    });
+
+    vector<pair<int, int>> pairs = drawPairs(network, 1000);
+    runWorkload("Max flow between 1000 pairs of stations", [&]() {
+        pool.parallelFor<FlowWorkspace>(pairs.size(), [&](size_t i, FlowWorkspace &ws) {
+            network.maxFlow(pairs[i].first, pairs[i].second, ws);
+        });
+    });
+
+    runWorkload("Min cost max flow between 100 pairs of stations", [&]() {
+        pool.parallelFor<FlowWorkspace>(100, [&](size_t i, FlowWorkspace &ws) {
+            network.minCostMaxFlow(pairs[i].first, pairs[i].second, ws);
+        });
+    });
+
+    runWorkload("Top 10 critical segments", [&]() {
+        SegmentCriticality criticality(network);
+        criticality.rank(pool, 10, [](int, long) {});
+    });
+
+    UndirectedFlowNetwork undirected(railway, railway.getExtremes());
+    bool clean = checkUndirected(network, undirected, pairs, pool);
+
+    vector<pair<int, int>> stationPairs;
+    for (int v = 0; v < network.getSuperSource(); v++)
+        stationPairs.emplace_back(network.getSuperSource(), v);
+    clean &= checkBidirectional("Max flow from every line extreme into each station", network, stationPairs, pool);
+    clean &= checkBidirectional("Max flow between " + to_string(pairs.size()) + " pairs of stations", network, pairs,
+                                pool);
+    clean &= checkBidirectional("Undirected max flow between " + to_string(pairs.size()) + " pairs of stations",
+                                undirected, pairs, pool);
+    clean &= checkBidirectionalRegions(railway, pool);
+    vector<pair<int, int>> costedPairs(pairs.begin(), pairs.begin() + min<size_t>(pairs.size(), 100));
+    clean &= checkMinCostEngines("Min cost max flow between " + to_string(costedPairs.size()) + " pairs of stations",
+                                 network, costedPairs, pool);
+    clean &= checkMinCostEngines("Floating point min cost max flow between " + to_string(costedPairs.size()) +
+                                 " pairs of stations", RealFlowNetwork(railway, railway.getExtremes()), costedPairs,
+                                 pool);
+    vector<pair<int, int>> stationTargets(stationPairs.begin(),
+                                          stationPairs.begin() + min<size_t>(stationPairs.size(), 100));
+    clean &= checkTargetFlows("Cheapest flow from every line extreme into " + to_string(stationTargets.size()) +
+                              " stations", network, stationTargets, pool);
+    clean &= checkWarmStarts("What-if session of min cost max flows from every line extreme", network,
+                             stationTargets.back());
+    clean &= checkCheapestCosts(railway, pool);
+    clean &= checkScenarioReachability(network, 16384, 0.05);
+    {
+        Graph grid;
+        unordered_set<Vertex *> border = buildSyntheticGrid(grid, 40);
+        FlowNetwork gridNetwork(grid, border);
+        mt19937 rng(5489);
+        uniform_int_distribution<int> pick(0, gridNetwork.getSuperSource() - 1);
+        vector<pair<int, int>> gridPairs;
+        for (int i = 0; i < 20; i++)
+            gridPairs.emplace_back(gridNetwork.getSuperSource(), pick(rng));
+        for (int i = 0; i < 20; i++)
+            gridPairs.emplace_back(pick(rng), pick(rng));
+        clean &= checkMinCostEngines("Min cost max flow over a synthetic 40x40 grid", gridNetwork, gridPairs, pool);
+        clean &= checkWarmStarts("What-if session of min cost max flows over a synthetic 40x40 grid", gridNetwork,
+                                 gridPairs.front());
+    }
+    clean &= checkTraversals(argc > 2 ? stoi(argv[2]) : 200000, pool);
+    clean &= checkKernels(network, undirected, pairs);
+    clean &= checkFlowTypes<WideFlowNetwork>("64-bit", railway, network, pairs, pool);
+    clean &= checkFlowTypes<RealFlowNetwork>("floating point", railway, network, pairs, pool);
+
+    cout << "== Memory footprint" << endl;
+    MemoryFootprint::print(cout, "Railway graph", MemoryFootprint::measure(railway));
+    cout << endl;
+    MemoryFootprint::print(cout, "Flow network", MemoryFootprint::measure(network));
+    cout << endl;
+    MemoryFootprint::print(cout, "Undirected flow network", MemoryFootprint::measure(undirected));
+    cout << endl;
+
+    cout << "== Allocations of the solvers" << endl;
+    Allocations::print(cout);
+    cout << endl;
+
+    vector<pair<int, int>> checked(pairs.begin(), pairs.begin() + min<size_t>(pairs.size(), 50));
+    clean &= checkNoAllocations("maxFlow", checked, [&](int s, int t, FlowWorkspace &ws) {
+        network.maxFlow(s, t, ws);
+    });
+    clean &= checkNoAllocations<UndirectedFlowWorkspace>("undirected maxFlow", checked,
+                                                         [&](int s, int t, UndirectedFlowWorkspace &ws) {
+        undirected.maxFlow(s, t, ws);
+    });
+    clean &= checkNoAllocations("bidirectional maxFlow", checked, [&](int s, int t, FlowWorkspace &ws) {
+        ws.bidirectional = true;
+        network.maxFlow(s, t, ws);
+    });
+    clean &= checkNoAllocations("minCostMaxFlow", checked, [&](int s, int t, FlowWorkspace &ws) {
+        network.minCostMaxFlow(s, t, ws);
+    });
+    clean &= checkNoAllocations("reoptimize", checked, [&](int s, int t, FlowWorkspace &ws) {
+        network.minCostMaxFlow(s, t, ws);
+        network.reoptimize(s, t, ws);
+    });
+    clean &= checkNoAllocations("repairFlow", checked, [&](int s, int t, FlowWorkspace &ws) {
+        network.maxFlow(s, t, ws);
+        for (int a = 0; a < network.getArcCount(); a++) {
+            if (ws.flow[a] > 0 && network.getEdge(a) != nullptr) {
+                network.repairFlow(s, t, a, ws);
+                break;
+            }
+        }
+    });
+    cout << endl;
+
+    cout << "== Total" << endl;
+    Metrics::print(cout, Metrics::collect());
+    cout << endl << "== Latencies" << endl;
+    Metrics::printLatencies(cout);
+    Trace::write();
+    return clean ? 0 : 1;
+}
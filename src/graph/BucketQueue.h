@@ -0,0 +1,202 @@
+#ifndef PROJECT_RAILWAY_BUCKETQUEUE_H
+#define PROJECT_RAILWAY_BUCKETQUEUE_H
+
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+using namespace std;
+
+/**
+ * Monotone priority queue of vertices for Dijkstra's searches with small, non-negative costs (a radix heap): Dial's buckets
+ * widened to powers of two. Bucket 0 holds the vertices whose key is the last one popped, and bucket i the ones whose key
+ * first differs from it in bit i-1, so keys are never compared until their bucket is the first non-empty one, and then it
+ * is split into the lower buckets. Over the railway's services (2 and 4) the keys stay a few units above the last one, so
+ * the vertices only move between the first buckets, like in Dial's circular array.
+ * Each vertex is in at most one bucket, linked through arrays indexed by vertex, so lowering a key moves the vertex instead
+ * of adding a copy, and the queue never allocates once it is sized. Keys must be at least the last one popped.
+ * @tparam Key - the type of the keys (integer or floating point, as non-negative doubles order like their bit patterns)
+ */
+template <class Key>
+class BucketQueue {
+public:
+    /**
+     * Creates an empty queue, sized for no vertex.
+     */
+    BucketQueue() {
+        for (int &h: head) h = -1;
+    }
+
+    /**
+     * Sizes the queue for a number of vertices and empties it.
+     * Time Complexity: O(N), where N is the number of vertices.
+     * @param n - the number of vertices
+     */
+    void resize(int n) {
+        key.resize(n);
+        prev.resize(n);
+        next.resize(n);
+        bucket.assign(n, -1);
+        for (int &h: head) h = -1;
+        last = 0;
+        count = 0;
+    }
+
+    /**
+     * Gets the number of vertices the queue is sized for.
+     * @return the number of vertices
+     */
+    int getSize() const {
+        return bucket.size();
+    }
+
+    /**
+     * Checks if the queue is empty.
+     * @return true if no vertex is queued, false otherwise
+     */
+    bool empty() const {
+        return count == 0;
+    }
+
+    /**
+     * Queues a vertex, or lowers the key of a queued one.
+     * Time Complexity: O(1).
+     * @param v - the vertex
+     * @param k - its key, at least the last key popped
+     */
+    void push(int v, Key k) {
+        if (bucket[v] != -1) unlink(v);
+        else count++;
+
+        key[v] = k;
+        link(v, bucketOf(k));
+    }
+
+    /**
+     * Removes a vertex with the lowest key.
+     * Time Complexity: O(log(C)) amortized, where C is the highest key.
+     * @return the vertex
+     */
+    int pop() {
+        if (head[0] == -1) {
+            int i = 1;
+            while (head[i] == -1) i++;
+
+            // The lowest key of the first non-empty bucket becomes the last one, which splits the bucket into lower ones
+            last = key[head[i]];
+            for (int v = head[i]; v != -1; v = next[v])
+                if (key[v] < last) last = key[v];
+
+            int v = head[i];
+            head[i] = -1;
+            while (v != -1) {
+                int following = next[v];
+                link(v, bucketOf(key[v]));
+                v = following;
+            }
+        }
+
+        int v = head[0];
+        unlink(v);
+        bucket[v] = -1;
+        count--;
+        return v;
+    }
+
+    /**
+     * Gets the key of a vertex.
+     * @param v - the vertex
+     * @return its key (the one it was popped with, if it is no longer queued)
+     */
+    Key getKey(int v) const {
+        return key[v];
+    }
+
+    /**
+     * Empties the queue, e.g. after a search stopped before popping every vertex.
+     * Time Complexity: O(Q), where Q is the number of vertices queued.
+     */
+    void clear() {
+        for (int &h: head) {
+            for (int v = h; v != -1; v = next[v])
+                bucket[v] = -1;
+            h = -1;
+        }
+        last = 0;
+        count = 0;
+    }
+
+    /**
+     * Gets the heap memory used by the queue.
+     * @return the number of bytes
+     */
+    size_t getHeapBytes() const {
+        return key.capacity() * sizeof(Key) + (prev.capacity() + next.capacity()) * sizeof(int) + bucket.capacity();
+    }
+
+private:
+    static const int BUCKETS = 65; /**< Bucket 0 plus one bucket per bit of a 64-bit key */
+
+    vector<Key> key; /**< Key of each vertex */
+    vector<int> prev; /**< Previous vertex in the bucket of each vertex (-1 for the first one) */
+    vector<int> next; /**< Next vertex in the bucket of each vertex (-1 for the last one) */
+    vector<signed char> bucket; /**< Bucket of each vertex (-1 if it is not queued) */
+    int head[BUCKETS]; /**< First vertex of each bucket (-1 if empty) */
+    Key last = 0; /**< Last key popped, every queued key is at least this one */
+    int count = 0; /**< Number of vertices queued */
+
+    /**
+     * Gets the bits of a key, ordered like the key.
+     * @param k - the key
+     * @return the bits
+     */
+    static unsigned long long bitsOf(Key k) {
+        return bitsOf(k, is_integral<Key>());
+    }
+
+    static unsigned long long bitsOf(Key k, true_type) {
+        return (unsigned long long) k;
+    }
+
+    static unsigned long long bitsOf(Key k, false_type) {
+        double d = k;
+        unsigned long long bits;
+        memcpy(&bits, &d, sizeof(bits));
+        return bits;
+    }
+
+    /**
+     * Gets the bucket of a key: 0 if it is the last key, otherwise one past the highest bit where they differ.
+     * @param k - the key
+     * @return the bucket
+     */
+    int bucketOf(Key k) const {
+        unsigned long long diff = bitsOf(k) ^ bitsOf(last);
+        return diff == 0 ? 0 : 64 - __builtin_clzll(diff);
+    }
+
+    /**
+     * Adds a vertex to the front of a bucket.
+     * @param v - the vertex
+     * @param b - the bucket
+     */
+    void link(int v, int b) {
+        bucket[v] = b;
+        prev[v] = -1;
+        next[v] = head[b];
+        if (head[b] != -1) prev[head[b]] = v;
+        head[b] = v;
+    }
+
+    /**
+     * Removes a vertex from its bucket, leaving its bucket number behind.
+     * @param v - the vertex
+     */
+    void unlink(int v) {
+        if (prev[v] != -1) next[prev[v]] = next[v];
+        else head[bucket[v]] = next[v];
+        if (next[v] != -1) prev[next[v]] = prev[v];
+    }
+};
+
+#endif //PROJECT_RAILWAY_BUCKETQUEUE_H
@@ -0,0 +1,23 @@
+#include "CheapestCostMatrix.h"
+
+CheapestCostMatrix::CheapestCostMatrix(const FlowNetwork &network, const vector<int> &stations, WorkStealingPool &pool)
+        : stations(stations), costs(stations.size() * stations.size()) {
+    size_t k = stations.size();
+    pool.parallelFor<FlowWorkspace>(k, [&](size_t i, FlowWorkspace &ws) {
+        network.cheapestRoute(stations[i], -1, ws);
+        for (size_t j = 0; j < k; j++)
+            costs[i * k + j] = ws.price[stations[j]];
+    });
+}
+
+int CheapestCostMatrix::getSize() const {
+    return stations.size();
+}
+
+int CheapestCostMatrix::getStation(int i) const {
+    return stations[i];
+}
+
+int CheapestCostMatrix::getCost(int i, int j) const {
+    return costs[(size_t) i * stations.size() + j];
+}
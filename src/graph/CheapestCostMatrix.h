@@ -0,0 +1,52 @@
+#ifndef PROJECT_RAILWAY_CHEAPESTCOSTMATRIX_H
+#define PROJECT_RAILWAY_CHEAPESTCOSTMATRIX_H
+
+#include <vector>
+#include "FlowNetwork.h"
+#include "parallel/WorkStealingPool.h"
+
+using namespace std;
+
+/**
+ * Cost of the cheapest route between every pair of a set of stations (e.g. the line extremes, for tariff planning).
+ * Each row is one cheapestRoute search to every vertex, and the rows are searched in parallel, one workspace per worker.
+ */
+class CheapestCostMatrix {
+public:
+    /**
+     * Calculates the costs between every pair of stations.
+     * Time Complexity: O(K*(E + V*log(C))), where K is the number of stations, V is the number of vertices, E is the
+     * number of edges and C is the cost of the most expensive route.
+     * @param network - the network
+     * @param stations - the indices of the stations
+     * @param pool - the pool that searches the rows
+     */
+    CheapestCostMatrix(const FlowNetwork &network, const vector<int> &stations, WorkStealingPool &pool);
+
+    /**
+     * Gets the number of stations of the matrix.
+     * @return the number of stations
+     */
+    int getSize() const;
+
+    /**
+     * Gets the index in the network of a station of the matrix.
+     * @param i - the position of the station
+     * @return the index of the station
+     */
+    int getStation(int i) const;
+
+    /**
+     * Gets the cost of the cheapest route between two stations of the matrix.
+     * @param i - the position of the origin station
+     * @param j - the position of the destination station
+     * @return the cost of the route (FlowTraits<int>::infinity() if there is none)
+     */
+    int getCost(int i, int j) const;
+
+private:
+    vector<int> stations; /**< Index of each station in the network */
+    vector<int> costs; /**< Cost between each pair of stations, row by row */
+};
+
+#endif //PROJECT_RAILWAY_CHEAPESTCOSTMATRIX_H
@@ -0,0 +1,226 @@
+#include "DirectionOptimizingBfs.h"
+
+DirectionOptimizingBfs::DirectionOptimizingBfs(const Graph &gh) {
+    for (const auto &v: gh.getVertexSet())
+        vertices.push_back(v.second);
+    sort(vertices.begin(), vertices.end(), [](const Vertex *v1, const Vertex *v2) {
+        return v1->getId() < v2->getId();
+    });
+
+    int n = vertices.size();
+    index.reserve(n);
+    for (int i = 0; i < n; i++)
+        index[vertices[i]] = i;
+
+    start.assign(1, 0);
+    for (Vertex *v: vertices) {
+        for (Edge *e: v->getAdj()) {
+            auto dest = index.find(e->getDest());
+            if (dest != index.end()) targets.push_back(dest->second);
+        }
+        start.push_back(targets.size());
+    }
+
+    size_t words = (n + 63) / 64;
+    reached.assign(words, 0);
+    frontier.assign(words, 0);
+    next.assign(words, 0);
+    component.assign(n, 0);
+}
+
+int DirectionOptimizingBfs::getSize() const {
+    return vertices.size();
+}
+
+int DirectionOptimizingBfs::indexOf(const Vertex *v) const {
+    auto it = index.find(v);
+    return it == index.end() ? -1 : it->second;
+}
+
+Vertex *DirectionOptimizingBfs::getVertex(int i) const {
+    return vertices[i];
+}
+
+void DirectionOptimizingBfs::restrictTo(enum region r) {
+    label.resize(vertices.size());
+    for (size_t v = 0; v < vertices.size(); v++)
+        label[v] = vertices[v]->getRegionId(r);
+}
+
+void DirectionOptimizingBfs::setPool(WorkStealingPool *pool) {
+    this->pool = pool;
+}
+
+bool DirectionOptimizingBfs::isReached(int v) const {
+    return (reached[v >> 6] >> (v & 63)) & 1;
+}
+
+const vector<int> &DirectionOptimizingBfs::getOrder() const {
+    return order;
+}
+
+void DirectionOptimizingBfs::clearReached() {
+    if (ordered) {
+        for (int v: order)
+            reached[v >> 6] = 0;
+    }
+    else
+        fill(reached.begin(), reached.end(), 0);
+}
+
+int DirectionOptimizingBfs::search(int source, bool ordered) {
+    clearReached();
+    order.clear();
+    this->ordered = ordered;
+    return expand(source, 1, ordered);
+}
+
+vector<int> DirectionOptimizingBfs::labelComponents(const vector<int> &seeds) {
+    clearReached();
+    order.clear();
+    ordered = false;
+    fill(component.begin(), component.end(), 0);
+
+    int components = 0;
+    for (int s: seeds)
+        if (!isReached(s)) expand(s, ++components, false);
+
+    return component;
+}
+
+vector<int> DirectionOptimizingBfs::getSearchEnds() {
+    rank.resize(vertices.size());
+    for (size_t i = 0; i < order.size(); i++)
+        rank[order[i]] = i;
+
+    // Every followed neighbour of a reached vertex was reached too, so its rank is from this search
+    vector<int> ends;
+    for (int v: order) {
+        int region = label.empty() ? 0 : label[v];
+        bool isEnd = true;
+        for (int i = start[v]; i < start[v + 1] && isEnd; i++)
+            if (isFollowed(targets[i], region) && rank[targets[i]] >= rank[v]) isEnd = false;
+
+        if (isEnd) ends.push_back(v);
+    }
+
+    return ends;
+}
+
+int DirectionOptimizingBfs::expand(int source, int mark, bool keepOrder) {
+    int region = label.empty() ? 0 : label[source];
+    reached[source >> 6] |= 1ULL << (source & 63);
+    component[source] = mark;
+    queue.assign(1, source);
+    if (keepOrder) order.push_back(source);
+
+    long long frontierEdges = start[source + 1] - start[source];
+    long long unexplored = targets.size();
+    int frontierSize = 1, total = 1;
+    bool bottomUp = false;
+
+    while (frontierSize > 0) {
+        if (!bottomUp && !keepOrder && frontierEdges > unexplored / ALPHA) {
+            fill(frontier.begin(), frontier.end(), 0);
+            for (int v: queue)
+                frontier[v >> 6] |= 1ULL << (v & 63);
+            bottomUp = true;
+        }
+        else if (bottomUp && frontierSize < (int) vertices.size() / BETA) {
+            queue.clear();
+            for (size_t i = 0; i < frontier.size(); i++) {
+                for (uint64_t bits = frontier[i]; bits != 0; bits &= bits - 1)
+                    queue.push_back(i * 64 + __builtin_ctzll(bits));
+            }
+            bottomUp = false;
+        }
+
+        unexplored -= frontierEdges;
+        frontierSize = bottomUp ? stepBottomUp(mark, region, frontierEdges)
+                                : stepTopDown(mark, region, keepOrder, frontierEdges);
+        total += frontierSize;
+    }
+
+    return total;
+}
+
+int DirectionOptimizingBfs::stepTopDown(int mark, int region, bool keepOrder, long long &edges) {
+    nextQueue.clear();
+    edges = 0;
+
+    for (int v: queue) {
+        for (int i = start[v]; i < start[v + 1]; i++) {
+            int w = targets[i];
+            uint64_t bit = 1ULL << (w & 63);
+            if ((reached[w >> 6] & bit) || !isFollowed(w, region)) continue;
+
+            reached[w >> 6] |= bit;
+            component[w] = mark;
+            nextQueue.push_back(w);
+            edges += start[w + 1] - start[w];
+            if (keepOrder) order.push_back(w);
+        }
+    }
+
+    queue.swap(nextQueue);
+    return queue.size();
+}
+
+int DirectionOptimizingBfs::stepBottomUp(int mark, int region, long long &edges) {
+    size_t words = frontier.size();
+    size_t tasks = (words + WORDS_PER_TASK - 1) / WORDS_PER_TASK;
+    int found = 0;
+    edges = 0;
+
+    if (pool == nullptr || tasks < 2) {
+        found = stepBottomUpWords(0, words, mark, region, edges);
+    }
+    else {
+        vector<int> taskFound(tasks, 0);
+        vector<long long> taskEdges(tasks, 0);
+        pool->parallelFor(tasks, [&](size_t t, unsigned) {
+            size_t first = t * WORDS_PER_TASK;
+            taskFound[t] = stepBottomUpWords(first, min(first + WORDS_PER_TASK, words), mark, region, taskEdges[t]);
+        });
+
+        for (size_t t = 0; t < tasks; t++) {
+            found += taskFound[t];
+            edges += taskEdges[t];
+        }
+    }
+
+    frontier.swap(next);
+    return found;
+}
+
+int DirectionOptimizingBfs::stepBottomUpWords(size_t first, size_t last, int mark, int region, long long &edges) {
+    int n = vertices.size();
+    int found = 0;
+
+    for (size_t i = first; i < last; i++) {
+        uint64_t candidates = ~reached[i];
+        if (i == reached.size() - 1 && n % 64 != 0) candidates &= (1ULL << (n % 64)) - 1;
+
+        uint64_t word = 0;
+        for (; candidates != 0; candidates &= candidates - 1) {
+            int v = i * 64 + __builtin_ctzll(candidates);
+            if (!isFollowed(v, region)) continue;
+
+            for (int j = start[v]; j < start[v + 1]; j++) {
+                int w = targets[j];
+                if ((frontier[w >> 6] >> (w & 63)) & 1) {
+                    word |= 1ULL << (v & 63);
+                    component[v] = mark;
+                    edges += start[v + 1] - start[v];
+                    break;
+                }
+            }
+        }
+
+        next[i] = word;
+        reached[i] |= word;
+        found += __builtin_popcountll(word);
+    }
+
+    return found;
+}
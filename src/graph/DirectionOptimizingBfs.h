@@ -0,0 +1,188 @@
+#ifndef PROJECT_RAILWAY_DIRECTIONOPTIMIZINGBFS_H
+#define PROJECT_RAILWAY_DIRECTIONOPTIMIZINGBFS_H
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+#include "Graph.h"
+#include "parallel/WorkStealingPool.h"
+
+using namespace std;
+
+/**
+ * Breadth-first traversal over a CSR snapshot of a Graph, used by the plain traversals of the project (connected
+ * components, components of each region and the discovery of extremes) instead of chasing the Vertex and Edge pointers.
+ * Each level is expanded top-down, the frontier scanning its edges, or bottom-up, every vertex not reached yet looking for
+ * a neighbour in the frontier and stopping at the first one, whichever scans fewer edges (Beamer's heuristic). The reached
+ * set and the frontiers of the bottom-up levels are bitmaps, counted with population counts, and the bottom-up levels can
+ * be split over the workers of a pool. Bottom-up levels rely on every segment of the railway having both of its edges, so
+ * the vertices a vertex is reached from are its neighbours.
+ * Vertices are indexed like in FlowNetwork (sorted by id) and keep the adjacency order of the graph.
+ */
+class DirectionOptimizingBfs {
+public:
+    /**
+     * Takes a snapshot of the topology of a graph.
+     * Time Complexity: O(V*log(V) + E), where V is the number of vertices and E is the number of edges.
+     * @param gh - the graph to snapshot
+     */
+    explicit DirectionOptimizingBfs(const Graph &gh);
+
+    /**
+     * Gets the number of vertices of the snapshot.
+     * @return the number of vertices
+     */
+    int getSize() const;
+
+    /**
+     * Gets the index of a vertex of the original graph.
+     * @param v - the vertex
+     * @return the index of the vertex, or -1 if it is not part of the snapshot
+     */
+    int indexOf(const Vertex *v) const;
+
+    /**
+     * Gets the vertex of the original graph with a certain index.
+     * @param i - the index of the vertex
+     * @return the vertex
+     */
+    Vertex *getVertex(int i) const;
+
+    /**
+     * Restricts the following searches to a kind of region: only the edges between two stations of the same region are
+     * followed, so a search only reaches the region of its source.
+     * Time Complexity: O(V), where V is the number of vertices.
+     * @param r - the kind of region
+     */
+    void restrictTo(enum region r);
+
+    /**
+     * Sets the pool that expands the bottom-up levels, which only pays off over millions of stations.
+     * @param pool - the pool (nullptr expands every level on the calling thread)
+     */
+    void setPool(WorkStealingPool *pool);
+
+    /**
+     * Finds the vertices reached from a source. An ordered search only expands top-down, so it visits the vertices in the
+     * order of a FIFO queue, and keeps that order for getOrder and getSearchEnds.
+     * Time Complexity: O(V+E), where V is the number of vertices and E is the number of edges.
+     * @param source - the index of the source vertex
+     * @param ordered - true to keep the order in which the vertices are visited
+     * @return the number of vertices reached
+     */
+    int search(int source, bool ordered = false);
+
+    /**
+     * Checks if a vertex was reached by the last search.
+     * @param v - the index of the vertex
+     * @return true if the vertex was reached, false otherwise
+     */
+    bool isReached(int v) const;
+
+    /**
+     * Gets the vertices reached by the last ordered search, in the order they were visited.
+     * @return the visited vertices
+     */
+    const vector<int> &getOrder() const;
+
+    /**
+     * Gets the vertices of the last ordered search that were visited after all of their followed neighbours, i.e. the ones
+     * where the search ends. Over a line, those are its extremes.
+     * Time Complexity: O(R+F), where R is the number of vertices reached and F is the number of edges leaving them.
+     * @return the vertices, in the order they were visited
+     */
+    vector<int> getSearchEnds();
+
+    /**
+     * Labels the components reached from a list of seeds: every seed not reached from an earlier one starts a new
+     * component, numbered from 1 in the order of the seeds.
+     * Time Complexity: O(V+E), where V is the number of vertices and E is the number of edges.
+     * @param seeds - the indices of the seeds
+     * @return the component of each vertex (0 for the vertices not reached from any seed)
+     */
+    vector<int> labelComponents(const vector<int> &seeds);
+
+private:
+    static const int ALPHA = 14; /**< Goes bottom-up when the frontier has more than 1/ALPHA of the edges left */
+    static const int BETA = 24; /**< Goes back top-down when the frontier has less than 1/BETA of the vertices */
+    static const size_t WORDS_PER_TASK = 1024; /**< Words of the bitmaps expanded by each task of a bottom-up level */
+
+    vector<Vertex *> vertices; /**< Vertices of the original graph, sorted by id */
+    unordered_map<const Vertex *, int> index; /**< Index of each vertex of the original graph */
+    vector<int> start; /**< Start of the neighbours of each vertex in targets (size V+1) */
+    vector<int> targets; /**< Neighbours of every vertex, in adjacency order */
+    vector<int> label; /**< Region of each vertex, followed edges join vertices of the same region (empty for all) */
+    WorkStealingPool *pool = nullptr; /**< Pool that expands the bottom-up levels (nullptr for none) */
+
+    vector<uint64_t> reached; /**< Bitmap of the vertices reached */
+    vector<uint64_t> frontier; /**< Bitmap of the frontier of a bottom-up level */
+    vector<uint64_t> next; /**< Bitmap of the vertices found by a bottom-up level */
+    vector<int> component; /**< Component of each reached vertex */
+    vector<int> queue; /**< Frontier of a top-down level */
+    vector<int> nextQueue; /**< Vertices found by a top-down level */
+    vector<int> order; /**< Vertices visited by the last ordered search */
+    vector<int> rank; /**< Position of each vertex in order */
+    bool ordered = false; /**< True if the last search was ordered, so only the bits of order are set */
+
+    /**
+     * Checks if a search from a vertex of a region follows the edges into a vertex.
+     * @param w - the index of the vertex
+     * @param region - the region of the search
+     * @return true if the edges into w are followed, false otherwise
+     */
+    bool isFollowed(int w, int region) const {
+        return label.empty() || label[w] == region;
+    }
+
+    /**
+     * Clears the reached bitmap, only touching the words of the last ordered search when there was one.
+     * Time Complexity: O(V/64), or O(R) after an ordered search that reached R vertices.
+     */
+    void clearReached();
+
+    /**
+     * Reaches the vertices not reached yet that can be reached from a source, marking them with a component.
+     * Time Complexity: O(V+E), where V is the number of vertices and E is the number of edges.
+     * @param source - the index of the source vertex
+     * @param mark - the component of the vertices reached
+     * @param keepOrder - true to only expand top-down and keep the order of the vertices
+     * @return the number of vertices reached
+     */
+    int expand(int source, int mark, bool keepOrder);
+
+    /**
+     * Expands a level from the frontier list, filling the next one.
+     * Time Complexity: O(F), where F is the number of edges leaving the frontier.
+     * @param mark - the component of the vertices reached
+     * @param region - the region of the search
+     * @param keepOrder - true to add the vertices reached to order
+     * @param edges - variable that will hold the number of edges leaving the new frontier
+     * @return the number of vertices reached
+     */
+    int stepTopDown(int mark, int region, bool keepOrder, long long &edges);
+
+    /**
+     * Expands a level from the frontier bitmap: each vertex not reached yet looks for a neighbour in the frontier.
+     * Time Complexity: O(V/64 + U), where V is the number of vertices and U is the number of edges scanned from the
+     * vertices not reached yet.
+     * @param mark - the component of the vertices reached
+     * @param region - the region of the search
+     * @param edges - variable that will hold the number of edges leaving the new frontier
+     * @return the number of vertices reached
+     */
+    int stepBottomUp(int mark, int region, long long &edges);
+
+    /**
+     * Expands the words [first, last) of a bottom-up level. Only those words of next and reached are written, so
+     * disjoint ranges can be expanded at the same time.
+     * @param first - the first word
+     * @param last - the word after the last one
+     * @param mark - the component of the vertices reached
+     * @param region - the region of the search
+     * @param edges - variable to which the number of edges leaving the vertices reached is added
+     * @return the number of vertices reached
+     */
+    int stepBottomUpWords(size_t first, size_t last, int mark, int region, long long &edges);
+};
+
+#endif //PROJECT_RAILWAY_DIRECTIONOPTIMIZINGBFS_H
@@ -0,0 +1,255 @@
+#include "FailureSimulation.h"
+#include <algorithm>
+#include <cmath>
+
+void SampleStats::add(int flow) {
+    samples++;
+    sum += flow;
+    sumSquares += (long long) flow * flow;
+    histogram[flow]++;
+}
+
+void SampleStats::merge(const SampleStats &other) {
+    samples += other.samples;
+    sum += other.sum;
+    sumSquares += other.sumSquares;
+    for (auto &bucket: other.histogram)
+        histogram[bucket.first] += bucket.second;
+}
+
+double SampleStats::getMean() const {
+    return samples == 0 ? 0 : (double) sum / samples;
+}
+
+double SampleStats::getVariance() const {
+    if (samples < 2) return 0;
+
+    double variance = ((double) sumSquares - (double) sum * sum / samples) / (samples - 1);
+    return variance < 0 ? 0 : variance;
+}
+
+double SampleStats::getHalfWidth() const {
+    return samples == 0 ? 0 : 1.96 * sqrt(getVariance() / samples);
+}
+
+double SampleStats::getProbabilityBelow(int flow) const {
+    long below = 0;
+    for (auto &bucket: histogram) {
+        if (bucket.first >= flow) break;
+        below += bucket.second;
+    }
+
+    return samples == 0 ? 0 : (double) below / samples;
+}
+
+FailureSimulation::FailureSimulation(const FlowNetwork &network, const vector<pair<int, int>> &queries,
+                                     const vector<double> &failureProbability, unsigned long seed)
+        : network(network), queries(queries), seed(seed) {
+    for (int a: network.getSegments()) {
+        if (failureProbability[a] > 0) {
+            segments.push_back(a);
+            probability.push_back(failureProbability[a]);
+        }
+    }
+
+    for (auto &query: queries) {
+        auto it = find(sources.begin(), sources.end(), query.first);
+        querySource.push_back(it - sources.begin());
+        if (it == sources.end()) sources.push_back(query.first);
+    }
+
+    if (network.getSuperSource() != -1) {
+        auto it = find(sources.begin(), sources.end(), network.getSuperSource());
+        if (it != sources.end()) cutOffSource = it - sources.begin();
+    }
+    cutOff.assign(network.getSize(), 0);
+
+    stats.assign(queries.size(), SampleStats());
+}
+
+void FailureSimulation::solveBaselines(WorkStealingPool &pool) {
+    baseline.assign(queries.size(), 0);
+    baselineFlows.assign(queries.size(), vector<int>());
+    uses.assign(queries.size(), vector<char>(segments.size(), false));
+
+    pool.parallelFor<FlowWorkspace>(queries.size(), [this](size_t q, FlowWorkspace &ws) {
+        baseline[q] = network.maxFlow(queries[q].first, queries[q].second, ws);
+        baselineFlows[q] = ws.flow;
+
+        for (size_t j = 0; j < segments.size(); j++) {
+            int a = segments[j], reverse = network.getArcReverse(a);
+            uses[q][j] = ws.flow[a] != (reverse == a ? 0 : ws.flow[reverse]);
+        }
+    });
+}
+
+void FailureSimulation::drawBlock(long block, int count, Worker &worker) const {
+    FlowWorkspace &ws = worker.ws;
+    if (ws.flow.size() != (size_t) network.getArcCount())
+        network.prepare(ws);
+    if (ws.failed.size() != (size_t) network.getArcCount())
+        ws.failed.assign(network.getArcCount(), false);
+    if (worker.stats.size() != queries.size())
+        worker.stats.assign(queries.size(), SampleStats());
+
+    seed_seq streamSeed{(unsigned long) seed, (unsigned long) block};
+    worker.rng.seed(streamSeed);
+    uniform_real_distribution<double> unit(0, 1);
+
+    worker.failedSegments.resize(count);
+    worker.failedArcs.resize(count);
+    for (int i = 0; i < count; i++) {
+        worker.failedSegments[i].clear();
+        worker.failedArcs[i].clear();
+        for (size_t j = 0; j < segments.size(); j++) {
+            if (unit(worker.rng) < probability[j]) {
+                worker.failedSegments[i].push_back(j);
+                worker.failedArcs[i].push_back(segments[j]);
+            }
+        }
+    }
+
+    worker.reachability.setScenarios(worker.failedArcs);
+    worker.reach.resize(sources.size());
+    for (size_t i = 0; i < sources.size(); i++)
+        worker.reachability.findReachable(sources[i], worker.reach[i]);
+
+    if (cutOffSource != -1) {
+        if (worker.cutOff.size() != cutOff.size())
+            worker.cutOff.assign(cutOff.size(), 0);
+        for (int i = 0; i < count; i++) {
+            worker.reachability.getDisconnected(worker.reach[cutOffSource], i, worker.disconnected);
+            for (int v: worker.disconnected)
+                worker.cutOff[v]++;
+        }
+    }
+
+    for (int i = 0; i < count; i++) {
+        auto &failed = worker.failedSegments[i];
+        bool marked = false;
+
+        for (size_t q = 0; q < queries.size(); q++) {
+            bool affected = false;
+            for (int j: failed)
+                if (uses[q][j]) {
+                    affected = true;
+                    break;
+                }
+
+            if (!affected) {
+                worker.stats[q].add(baseline[q]);
+                continue;
+            }
+
+            if (!worker.reach[querySource[q]][queries[q].second].test(i)) {
+                worker.stats[q].add(0);
+                worker.unreachable++;
+                continue;
+            }
+
+            if (!marked) {
+                for (int j: failed)
+                    ws.failed[segments[j]] = ws.failed[network.getArcReverse(segments[j])] = true;
+                marked = true;
+            }
+
+            // Each failed segment used by the baseline is repaired in turn; the other failed segments are already skipped
+            // and their flow can only go down, so once the last one is repaired the flow is a max flow without all of them
+            ws.flow = baselineFlows[q];
+            int flow = baseline[q];
+            for (int j: failed)
+                if (uses[q][j]) flow = network.repairFlow(queries[q].first, queries[q].second, segments[j], ws);
+
+            worker.stats[q].add(flow);
+            worker.solves++;
+        }
+
+        if (marked)
+            for (int j: failed)
+                ws.failed[segments[j]] = ws.failed[network.getArcReverse(segments[j])] = false;
+    }
+}
+
+bool FailureSimulation::run(WorkStealingPool &pool, double tolerance, long maxSamples, const function<void()> &report) {
+    if (baseline.size() != queries.size())
+        solveBaselines(pool);
+
+    vector<Worker> workers;
+    workers.reserve(pool.getThreadCount());
+    for (unsigned w = 0; w < pool.getThreadCount(); w++)
+        workers.emplace_back(network);
+
+    while (samples < maxSamples && !isConverged(tolerance)) {
+        long remaining = maxSamples - samples;
+        long roundBlocks = min<long>(BLOCKS_PER_ROUND, (remaining + SAMPLES_PER_BLOCK - 1) / SAMPLES_PER_BLOCK);
+        long first = blocks;
+
+        bool finished = pool.parallelFor(roundBlocks, [&](size_t i, unsigned w) {
+            int count = (int) min<long>(SAMPLES_PER_BLOCK, remaining - (long) i * SAMPLES_PER_BLOCK);
+            drawBlock(first + i, count, workers[w]);
+        });
+        // A cancelled round is dropped whole, so the statistics only hold finished blocks and the next run draws the
+        // same blocks again
+        if (!finished)
+            return false;
+        blocks += roundBlocks;
+
+        // Merged in worker order, but integer sums give the same statistics in any order
+        for (Worker &worker: workers) {
+            for (size_t q = 0; q < worker.stats.size(); q++) {
+                stats[q].merge(worker.stats[q]);
+                worker.stats[q] = SampleStats();
+            }
+            for (size_t v = 0; v < worker.cutOff.size(); v++) {
+                cutOff[v] += worker.cutOff[v];
+                worker.cutOff[v] = 0;
+            }
+            solves += worker.solves;
+            unreachable += worker.unreachable;
+            worker.solves = worker.unreachable = 0;
+        }
+        samples = stats.empty() ? samples + remaining : stats[0].samples;
+
+        report();
+    }
+
+    return isConverged(tolerance);
+}
+
+bool FailureSimulation::isConverged(double tolerance) const {
+    if (samples < MIN_SAMPLES)
+        return false;
+
+    for (auto &queryStats: stats)
+        if (queryStats.getHalfWidth() > tolerance * queryStats.getMean()) return false;
+
+    return true;
+}
+
+const SampleStats &FailureSimulation::getStats(size_t query) const {
+    return stats[query];
+}
+
+int FailureSimulation::getBaseline(size_t query) const {
+    return baseline[query];
+}
+
+long FailureSimulation::getSampleCount() const {
+    return samples;
+}
+
+long FailureSimulation::getSolveCount() const {
+    return solves;
+}
+
+long FailureSimulation::getUnreachableCount() const {
+    return unreachable;
+}
+
+long FailureSimulation::getCutOffCount(int vertex) const {
+    return cutOff[vertex];
+}
+
+size_t FailureSimulation::getSegmentCount() const {
+    return segments.size();
+}
@@ -0,0 +1,224 @@
+#ifndef PROJECT_RAILWAY_FAILURESIMULATION_H
+#define PROJECT_RAILWAY_FAILURESIMULATION_H
+
+#include <functional>
+#include <map>
+#include <random>
+#include <vector>
+#include "FlowNetwork.h"
+#include "ScenarioReachability.h"
+#include "parallel/WorkStealingPool.h"
+
+using namespace std;
+
+/**
+ * Running statistics of the max flow of a query over the samples of a simulation.
+ * Only integer sums are kept, so the statistics of different workers can be merged in any order with the same result.
+ */
+struct SampleStats {
+    long samples = 0; /**< Number of samples */
+    long long sum = 0; /**< Sum of the flows */
+    long long sumSquares = 0; /**< Sum of the squares of the flows */
+    map<int, long> histogram; /**< Number of samples with each flow */
+
+    /**
+     * Adds a sample.
+     * @param flow - the max flow of the sample
+     */
+    void add(int flow);
+
+    /**
+     * Adds every sample of another set of statistics.
+     * @param other - the statistics to add
+     */
+    void merge(const SampleStats &other);
+
+    /**
+     * Gets the mean flow of the samples.
+     * @return the mean flow
+     */
+    double getMean() const;
+
+    /**
+     * Gets the (unbiased) variance of the flow of the samples.
+     * @return the variance
+     */
+    double getVariance() const;
+
+    /**
+     * Gets the half width of the 95% confidence interval of the mean flow.
+     * @return the half width of the interval
+     */
+    double getHalfWidth() const;
+
+    /**
+     * Gets the fraction of the samples whose flow is below a value.
+     * @param flow - the value
+     * @return the fraction of the samples
+     */
+    double getProbabilityBelow(int flow) const;
+};
+
+/**
+ * Monte Carlo estimate of the max flow of a set of queries (source and sink pairs) when every segment of the network
+ * fails independently with its own probability.
+ * Samples are drawn in blocks, each with its own random stream seeded by the block number, so the estimates only depend
+ * on the seed and not on the number of threads or on which worker ran each block. The statistics are merged after
+ * every round of blocks, which lets the simulation stop as soon as the confidence intervals are tight enough. Rounds
+ * have a fixed size, so the point where it stops does not depend on the number of threads either.
+ * Removing segments can't raise a max flow, so a sample whose failed segments carry no flow in the max flow of the intact
+ * network (i.e. misses every segment the baseline relies on) has the baseline flow and is not solved. The other samples
+ * repair the baseline flow around their failed segments instead of solving from zero, unless a bit-parallel search over
+ * every sample of the block shows that the sink can't be reached from the source at all, which means a flow of 0. When a
+ * query starts at the super source, the same searches also count the samples in which each station is cut off from
+ * every line extreme.
+ */
+class FailureSimulation {
+public:
+    static const int SAMPLES_PER_BLOCK = 64; /**< Number of samples drawn by each task */
+    static const int BLOCKS_PER_ROUND = 32; /**< Number of blocks drawn between two convergence checks */
+    static const long MIN_SAMPLES = 1000; /**< Number of samples drawn before convergence is checked */
+
+    /**
+     * Finds the segments that can fail, i.e. the enabled segments with a positive probability of failure.
+     * Time Complexity: O(E), where E is the number of edges.
+     * @param network - the network
+     * @param queries - the source and sink of each query
+     * @param failureProbability - the probability of failure of each arc (read on one arc of each segment)
+     * @param seed - the seed of the random streams
+     */
+    FailureSimulation(const FlowNetwork &network, const vector<pair<int, int>> &queries,
+                      const vector<double> &failureProbability, unsigned long seed = 5489);
+
+    /**
+     * Draws samples until every confidence interval is within the tolerance, the sample limit is reached or the run is
+     * cancelled through the pool. The first run also solves the baselines of the queries. Later runs carry on with the
+     * samples already drawn. The round that a cancel interrupts is dropped, so only finished blocks are counted.
+     * Time Complexity: O(Q*V*E² / T) for the baselines plus O(N*(S + F*V*E²) / T) for the samples, where Q is the
+     * number of queries, N is the number of samples, S is the number of segments that can fail, F is the number of
+     * queries affected by each sample, V is the number of vertices, E is the number of edges and T is the number of threads.
+     * @param pool - the pool that draws the samples
+     * @param tolerance - the largest half width of the confidence intervals, relative to their mean
+     * @param maxSamples - the largest number of samples
+     * @param report - called after every round of samples
+     * @return true if the simulation converged, false otherwise
+     */
+    bool run(WorkStealingPool &pool, double tolerance, long maxSamples, const function<void()> &report);
+
+    /**
+     * Checks if every confidence interval is within a tolerance.
+     * @param tolerance - the largest half width of the confidence intervals, relative to their mean
+     * @return true if the simulation converged, false otherwise
+     */
+    bool isConverged(double tolerance) const;
+
+    /**
+     * Gets the statistics of a query.
+     * @param query - the position of the query
+     * @return the statistics of the query
+     */
+    const SampleStats &getStats(size_t query) const;
+
+    /**
+     * Gets the max flow of a query over the intact network.
+     * @param query - the position of the query
+     * @return the baseline flow
+     */
+    int getBaseline(size_t query) const;
+
+    /**
+     * Gets the number of samples drawn so far.
+     * @return the number of samples
+     */
+    long getSampleCount() const;
+
+    /**
+     * Gets the number of max flows repaired so far (samples that missed the baseline of a query are not repaired).
+     * @return the number of repairs
+     */
+    long getSolveCount() const;
+
+    /**
+     * Gets the number of query samples whose sink could not be reached from the source, which were answered without a
+     * repair.
+     * @return the number of unreachable query samples
+     */
+    long getUnreachableCount() const;
+
+    /**
+     * Gets the number of samples in which a station was cut off from every line extreme. They are only counted when a
+     * query starts at the super source, from the same searches that find the unreachable sinks.
+     * @param vertex - the index of the station
+     * @return the number of samples in which the station was cut off
+     */
+    long getCutOffCount(int vertex) const;
+
+    /**
+     * Gets the number of segments that can fail.
+     * @return the number of segments
+     */
+    size_t getSegmentCount() const;
+
+private:
+    /**
+     * Scratch state and partial statistics of a worker.
+     */
+    struct Worker {
+        FlowWorkspace ws; /**< Workspace of the solves */
+        mt19937_64 rng; /**< Random stream of the current block */
+        vector<vector<int>> failedSegments; /**< Segments (positions in segments) that failed in each sample of the block */
+        vector<vector<int>> failedArcs; /**< An arc of each failed segment, for each sample of the block */
+        ScenarioReachability<SAMPLES_PER_BLOCK> reachability; /**< Scenarios of the samples of the block */
+        vector<vector<ScenarioReachability<SAMPLES_PER_BLOCK>::Mask>> reach; /**< Samples where each vertex is reached from each source */
+        vector<int> disconnected; /**< Stations cut off from every line extreme in a sample */
+        vector<long> cutOff; /**< Samples in which each vertex was cut off since the last merge */
+        vector<SampleStats> stats; /**< Statistics of the samples drawn since the last merge */
+        long solves = 0; /**< Repairs since the last merge */
+        long unreachable = 0; /**< Samples answered by the reachability searches since the last merge */
+
+        /**
+         * Constructor
+         * @param network - the network being simulated
+         */
+        explicit Worker(const FlowNetwork &network) : reachability(network) {}
+    };
+
+    const FlowNetwork &network; /**< Network being simulated */
+    vector<pair<int, int>> queries; /**< Source and sink of each query */
+    vector<int> sources; /**< Distinct sources of the queries */
+    vector<int> querySource; /**< Position of the source of each query in sources */
+    int cutOffSource = -1; /**< Position of the super source in sources (-1 when no query starts there) */
+    vector<long> cutOff; /**< Number of samples in which each vertex was cut off from every line extreme */
+    unsigned long seed; /**< Seed of the random streams */
+    vector<int> segments; /**< An arc of each segment that can fail */
+    vector<double> probability; /**< Probability of failure of each segment */
+    vector<int> baseline; /**< Max flow of each query over the intact network */
+    vector<vector<int>> baselineFlows; /**< Flow of each arc in the baseline of each query */
+    vector<vector<char>> uses; /**< True for the segments that carry flow in the baseline of each query */
+    vector<SampleStats> stats; /**< Statistics of each query */
+    long samples = 0; /**< Number of samples drawn so far */
+    long blocks = 0; /**< Number of blocks drawn so far */
+    long solves = 0; /**< Number of max flows repaired so far */
+    long unreachable = 0; /**< Number of query samples whose sink could not be reached, so were not repaired */
+
+    /**
+     * Solves the baseline of every query and finds the segments each one relies on.
+     * Time Complexity: O(Q*V*E² / T), where Q is the number of queries, V is the number of vertices, E is the number of
+     * edges and T is the number of threads.
+     * @param pool - the pool that runs the queries
+     */
+    void solveBaselines(WorkStealingPool &pool);
+
+    /**
+     * Draws a block of samples. Every failure set of the block is drawn first, so a single search per source finds the
+     * samples in which each sink is unreachable.
+     * Time Complexity: O(B*(S + F*V*E²)), where B is the size of the block, S is the number of segments that can fail, F is
+     * the number of queries affected by each sample, V is the number of vertices and E is the number of edges.
+     * @param block - the number of the block, which seeds its random stream
+     * @param count - the number of samples of the block
+     * @param worker - the worker drawing the block
+     */
+    void drawBlock(long block, int count, Worker &worker) const;
+};
+
+#endif //PROJECT_RAILWAY_FAILURESIMULATION_H
@@ -0,0 +1,123 @@
+#include "FlowKernels.h"
+#include <cstring>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define FLOW_KERNELS_AVX2
+#include <immintrin.h>
+#endif
+
+namespace {
+#ifdef FLOW_KERNELS_AVX2
+    bool hasAvx2() {
+        return __builtin_cpu_supports("avx2");
+    }
+
+    __attribute__((target("avx2")))
+    int horizontalSum(__m256i v) {
+        __m128i sum = _mm_add_epi32(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1));
+        sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(1, 0, 3, 2)));
+        sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(2, 3, 0, 1)));
+        return _mm_cvtsi128_si32(sum);
+    }
+
+    __attribute__((target("avx2")))
+    int gatherSumAvx2(const int *values, const int *indices, size_t n) {
+        __m256i sum = _mm256_setzero_si256();
+        size_t i = 0;
+        for (; i + 8 <= n; i += 8) {
+            __m256i index = _mm256_loadu_si256((const __m256i *) (indices + i));
+            sum = _mm256_add_epi32(sum, _mm256_i32gather_epi32(values, index, 4));
+        }
+
+        int result = horizontalSum(sum);
+        for (; i < n; i++)
+            result += values[indices[i]];
+        return result;
+    }
+
+    __attribute__((target("avx2")))
+    int halfSumAvx2(const int *flow, const int *halves, size_t n) {
+        const __m256i one = _mm256_set1_epi32(1);
+        __m256i sum = _mm256_setzero_si256();
+        size_t i = 0;
+        for (; i + 8 <= n; i += 8) {
+            __m256i half = _mm256_loadu_si256((const __m256i *) (halves + i));
+            __m256i value = _mm256_i32gather_epi32(flow, _mm256_srli_epi32(half, 1), 4);
+
+            // Even halves are all ones in the mask, and (x ^ -1) - (-1) = -x
+            __m256i even = _mm256_cmpeq_epi32(_mm256_and_si256(half, one), _mm256_setzero_si256());
+            sum = _mm256_add_epi32(sum, _mm256_sub_epi32(_mm256_xor_si256(value, even), even));
+        }
+
+        int result = horizontalSum(sum);
+        for (; i < n; i++)
+            result += (halves[i] & 1) ? flow[halves[i] >> 1] : -flow[halves[i] >> 1];
+        return result;
+    }
+
+    __attribute__((target("avx2")))
+    int sumProductsAvx2(const int *a, const int *b, size_t n) {
+        __m256i sum = _mm256_setzero_si256();
+        size_t i = 0;
+        for (; i + 8 <= n; i += 8) {
+            __m256i x = _mm256_loadu_si256((const __m256i *) (a + i));
+            __m256i y = _mm256_loadu_si256((const __m256i *) (b + i));
+            sum = _mm256_add_epi32(sum, _mm256_mullo_epi32(x, y));
+        }
+
+        int result = horizontalSum(sum);
+        for (; i < n; i++)
+            result += a[i] * b[i];
+        return result;
+    }
+#else
+    bool hasAvx2() {
+        return false;
+    }
+#endif
+}
+
+bool FlowKernels::simd = hasAvx2();
+
+bool FlowKernels::isSimd() {
+    return simd;
+}
+
+bool FlowKernels::setSimd(bool enabled) {
+    simd = enabled && hasAvx2();
+    return simd;
+}
+
+void FlowKernels::clear(vector<int> &values) {
+    // libc already clears with the widest stores of the processor
+    if (!values.empty()) memset(values.data(), 0, values.size() * sizeof(int));
+}
+
+int FlowKernels::gatherSumSimd(const int *values, const int *indices, size_t n) {
+#ifdef FLOW_KERNELS_AVX2
+    return gatherSumAvx2(values, indices, n);
+#else
+    int sum = 0;
+    for (size_t i = 0; i < n; i++)
+        sum += values[indices[i]];
+    return sum;
+#endif
+}
+
+int FlowKernels::halfSumSimd(const int *flow, const int *halves, size_t n) {
+#ifdef FLOW_KERNELS_AVX2
+    return halfSumAvx2(flow, halves, n);
+#else
+    int sum = 0;
+    for (size_t i = 0; i < n; i++)
+        sum += (halves[i] & 1) ? flow[halves[i] >> 1] : -flow[halves[i] >> 1];
+    return sum;
+#endif
+}
+
+int FlowKernels::sumProducts(const vector<int> &a, const vector<int> &b) {
+#ifdef FLOW_KERNELS_AVX2
+    if (simd) return sumProductsAvx2(a.data(), b.data(), a.size());
+#endif
+    return sumProducts<int, int>(a, b);
+}
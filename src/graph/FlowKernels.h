@@ -0,0 +1,154 @@
+#ifndef PROJECT_RAILWAY_FLOWKERNELS_H
+#define PROJECT_RAILWAY_FLOWKERNELS_H
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+using namespace std;
+
+/**
+ * Bulk operations over the flow arrays of the networks, which are the per-solve O(E) bookkeeping around the searches:
+ * clearing the flows, summing the flow that reaches a vertex and summing the cost of a flow. The 32-bit arrays of the
+ * railway go through AVX2 kernels when the processor has them (checked once, at startup) and through scalar loops
+ * otherwise, with the same results; the 64-bit and floating point networks always use the generic versions. The
+ * adjacency lists of most stations are shorter than a register, so their sums stay inline and scalar.
+ */
+class FlowKernels {
+public:
+    /**
+     * Checks if the AVX2 kernels are in use.
+     * @return true if they are, false if the scalar ones are
+     */
+    static bool isSimd();
+
+    /**
+     * Switches between the AVX2 and the scalar kernels, so both can be timed. AVX2 can only be enabled where it is
+     * supported. Not thread safe: call it while no solve is running.
+     * @param enabled - true to use the AVX2 kernels
+     * @return true if the AVX2 kernels are in use afterwards
+     */
+    static bool setSimd(bool enabled);
+
+    /**
+     * Sets every value of an array to 0.
+     * Time Complexity: O(N), where N is the number of values.
+     * @param values - the array
+     */
+    static void clear(vector<int> &values);
+
+    /**
+     * Sets every value of an array to 0.
+     * Time Complexity: O(N), where N is the number of values.
+     * @tparam T - the type of the values
+     * @param values - the array
+     */
+    template <class T>
+    static void clear(vector<T> &values) {
+        fill(values.begin(), values.end(), T());
+    }
+
+    /**
+     * Sums the values at some positions of an array, e.g. the flows of the arcs that reach a vertex.
+     * Time Complexity: O(N), where N is the number of positions.
+     * @param values - the array
+     * @param indices - the positions
+     * @param n - the number of positions
+     * @return the sum of values[indices[i]] over every i in [0, n)
+     */
+    static int gatherSum(const vector<int> &values, const int *indices, size_t n) {
+        if (simd && n >= LANES) return gatherSumSimd(values.data(), indices, n);
+        return gatherSum<int>(values, indices, n);
+    }
+
+    /**
+     * Sums the values at some positions of an array, e.g. the flows of the arcs that reach a vertex.
+     * Time Complexity: O(N), where N is the number of positions.
+     * @tparam T - the type of the values
+     * @param values - the array
+     * @param indices - the positions
+     * @param n - the number of positions
+     * @return the sum of values[indices[i]] over every i in [0, n)
+     */
+    template <class T>
+    static T gatherSum(const vector<T> &values, const int *indices, size_t n) {
+        T sum = 0;
+        for (size_t i = 0; i < n; i++)
+            sum += values[indices[i]];
+        return sum;
+    }
+
+    /**
+     * Sums the flow that a list of halves carries into their first vertex, where half h belongs to segment h/2 and
+     * carries the net flow of its segment when it is odd and its opposite when it is even.
+     * Time Complexity: O(N), where N is the number of halves.
+     * @param flow - the net flow of each segment
+     * @param halves - the halves
+     * @param n - the number of halves
+     * @return the flow entering through the halves minus the flow leaving through them
+     */
+    static int halfSum(const vector<int> &flow, const int *halves, size_t n) {
+        if (simd && n >= LANES) return halfSumSimd(flow.data(), halves, n);
+        return halfSum<int>(flow, halves, n);
+    }
+
+    /**
+     * Sums the flow that a list of halves carries into their first vertex, where half h belongs to segment h/2 and
+     * carries the net flow of its segment when it is odd and its opposite when it is even.
+     * Time Complexity: O(N), where N is the number of halves.
+     * @tparam T - the type of the flows
+     * @param flow - the net flow of each segment
+     * @param halves - the halves
+     * @param n - the number of halves
+     * @return the flow entering through the halves minus the flow leaving through them
+     */
+    template <class T>
+    static T halfSum(const vector<T> &flow, const int *halves, size_t n) {
+        T sum = 0;
+        for (size_t i = 0; i < n; i++)
+            sum += (halves[i] & 1) ? flow[halves[i] >> 1] : -flow[halves[i] >> 1];
+        return sum;
+    }
+
+    /**
+     * Sums the products of two arrays of the same size, e.g. the cost of a flow as the flow times the cost of each arc.
+     * Time Complexity: O(N), where N is the size of the arrays.
+     * @param a - the first array
+     * @param b - the second array
+     * @return the sum of a[i] * b[i]
+     */
+    static int sumProducts(const vector<int> &a, const vector<int> &b);
+
+    /**
+     * Sums the products of two arrays of the same size, e.g. the cost of a flow as the flow times the cost of each arc.
+     * Time Complexity: O(N), where N is the size of the arrays.
+     * @tparam T - the type of the first array
+     * @tparam U - the type of the second array and of the result
+     * @param a - the first array
+     * @param b - the second array
+     * @return the sum of a[i] * b[i]
+     */
+    template <class T, class U>
+    static U sumProducts(const vector<T> &a, const vector<U> &b) {
+        U sum = 0;
+        for (size_t i = 0; i < a.size(); i++)
+            sum += (U) a[i] * b[i];
+        return sum;
+    }
+
+private:
+    static const size_t LANES = 8; /**< 32-bit values in an AVX2 register, shorter lists stay inline and scalar */
+    static bool simd; /**< True if the AVX2 kernels are in use */
+
+    /**
+     * AVX2 version of gatherSum, for lists of at least LANES positions.
+     */
+    static int gatherSumSimd(const int *values, const int *indices, size_t n);
+
+    /**
+     * AVX2 version of halfSum, for lists of at least LANES halves.
+     */
+    static int halfSumSimd(const int *flow, const int *halves, size_t n);
+};
+
+#endif //PROJECT_RAILWAY_FLOWKERNELS_H
@@ -0,0 +1,1271 @@
+#include "FlowNetwork.h"
+#include <climits>
+#include <cstdlib>
+#include <cstring>
+#include "FlowKernels.h"
+#include "metrics/Allocations.h"
+#include "metrics/Metrics.h"
+#include "metrics/Trace.h"
+
+enum minCostEngine getDefaultMinCostEngine() {
+    static const enum minCostEngine engine = []() {
+        const char *env = getenv("RAILWAY_MIN_COST_ENGINE");
+        if (env != nullptr && strcmp(env, "bellman-ford") == 0) return BELLMAN_FORD;
+        if (env != nullptr && strcmp(env, "cost-scaling") == 0) return COST_SCALING;
+        return BUCKET_DIJKSTRA;
+    }();
+
+    return engine;
+}
+
+template <class Cap, class Cost>
+BasicFlowNetwork<Cap, Cost>::BasicFlowNetwork(const Graph &gh, const Scenario &scenario) {
+    vector<Vertex *> stations;
+    for (const auto &v: gh.getVertexSet())
+        stations.push_back(v.second);
+
+    build(stations, false, scenario);
+}
+
+template <class Cap, class Cost>
+BasicFlowNetwork<Cap, Cost>::BasicFlowNetwork(const vector<Vertex *> &stations) {
+    build(stations, true, Scenario());
+}
+
+template <class Cap, class Cost>
+BasicFlowNetwork<Cap, Cost>::BasicFlowNetwork(const Graph &gh, const unordered_set<Vertex *> &extremes,
+                                              const Scenario &scenario) : BasicFlowNetwork(gh, scenario) {
+    vector<Vertex *> sorted(extremes.begin(), extremes.end());
+    sort(sorted.begin(), sorted.end(), [](const Vertex *v1, const Vertex *v2) {
+        return v1->getId() < v2->getId();
+    });
+
+    int n = vertices.size();
+    vector<vector<int>> out(n + 1), in(n + 1);
+    for (int v = 0; v < n; v++) {
+        out[v].assign(outArcs.begin() + outStart[v], outArcs.begin() + outStart[v + 1]);
+        in[v].assign(inArcs.begin() + inStart[v], inArcs.begin() + inStart[v + 1]);
+    }
+
+    superSource = n;
+    vertices.push_back(nullptr);
+    component.push_back(0);
+
+    // The new arcs go after the existing ones of each extreme
+    for (Vertex *e: sorted) {
+        int v = indexOf(e);
+        if (v == -1) continue;
+
+        int a = addArc(superSource, v, FlowTraits<Cap>::infinity());
+        int b = addArc(v, superSource, FlowTraits<Cap>::infinity());
+        arcReverse[a] = b;
+        arcReverse[b] = a;
+
+        out[superSource].push_back(a);
+        in[v].push_back(a);
+        out[v].push_back(b);
+        in[superSource].push_back(b);
+    }
+
+    setAdjacency(out, in);
+}
+
+template <class Cap, class Cost>
+void BasicFlowNetwork<Cap, Cost>::build(const vector<Vertex *> &stations, bool induced, const Scenario &scenario) {
+    vertices = stations;
+    sort(vertices.begin(), vertices.end(), [](const Vertex *v1, const Vertex *v2) {
+        return v1->getId() < v2->getId();
+    });
+
+    int n = vertices.size();
+    index.reserve(n);
+    component.resize(n);
+    for (int i = 0; i < n; i++) {
+        index[vertices[i]] = i;
+        component[i] = induced ? 0 : vertices[i]->getComponent();
+    }
+
+    for (Vertex *v: vertices) {
+        for (Edge *e: v->getAdj()) {
+            auto dest = index.find(e->getDest());
+            if (dest == index.end()) continue;
+
+            arcIndex[e] = edges.size();
+            edges.push_back(e);
+            arcOrig.push_back(index[v]);
+            arcDest.push_back(dest->second);
+            arcCapacity.push_back(scenario.getCapacity(e));
+            arcCost.push_back(scenario.getCost(e));
+            arcDisabled.push_back(!induced && scenario.isDisabled(e));
+        }
+    }
+
+    arcReverse.resize(edges.size());
+    for (int a = 0; a < (int) edges.size(); a++) {
+        auto reverse = arcIndex.find(edges[a]->getReverse());
+        arcReverse[a] = reverse == arcIndex.end() ? a : reverse->second;
+    }
+
+    vector<vector<int>> out(n), in(n);
+    for (int v = 0; v < n; v++) {
+        for (Edge *e: vertices[v]->getAdj()) {
+            auto arc = arcIndex.find(e);
+            if (arc != arcIndex.end()) out[v].push_back(arc->second);
+        }
+        for (Edge *e: vertices[v]->getIncoming()) {
+            auto arc = arcIndex.find(e);
+            if (arc != arcIndex.end()) in[v].push_back(arc->second);
+        }
+    }
+
+    setAdjacency(out, in);
+}
+
+template <class Cap, class Cost>
+int BasicFlowNetwork<Cap, Cost>::addArc(int orig, int dest, Cap capacity) {
+    edges.push_back(nullptr);
+    arcOrig.push_back(orig);
+    arcDest.push_back(dest);
+    arcCapacity.push_back(capacity);
+    arcCost.push_back(STANDARD);
+    arcDisabled.push_back(false);
+    arcReverse.push_back(edges.size() - 1);
+    return edges.size() - 1;
+}
+
+template <class Cap, class Cost>
+void BasicFlowNetwork<Cap, Cost>::setAdjacency(const vector<vector<int>> &out, const vector<vector<int>> &in) {
+    outStart.assign(1, 0);
+    inStart.assign(1, 0);
+    outArcs.clear();
+    inArcs.clear();
+
+    for (size_t v = 0; v < out.size(); v++) {
+        outArcs.insert(outArcs.end(), out[v].begin(), out[v].end());
+        inArcs.insert(inArcs.end(), in[v].begin(), in[v].end());
+        outStart.push_back(outArcs.size());
+        inStart.push_back(inArcs.size());
+    }
+}
+
+template <class Cap, class Cost>
+int BasicFlowNetwork<Cap, Cost>::getSize() const {
+    return vertices.size();
+}
+
+template <class Cap, class Cost>
+int BasicFlowNetwork<Cap, Cost>::getSuperSource() const {
+    return superSource;
+}
+
+template <class Cap, class Cost>
+int BasicFlowNetwork<Cap, Cost>::getArcCount() const {
+    return edges.size();
+}
+
+template <class Cap, class Cost>
+int BasicFlowNetwork<Cap, Cost>::indexOf(const Vertex *v) const {
+    auto it = index.find(v);
+    return it == index.end() ? -1 : it->second;
+}
+
+template <class Cap, class Cost>
+Vertex *BasicFlowNetwork<Cap, Cost>::getVertex(int i) const {
+    return vertices[i];
+}
+
+template <class Cap, class Cost>
+Edge *BasicFlowNetwork<Cap, Cost>::getEdge(int arc) const {
+    return edges[arc];
+}
+
+template <class Cap, class Cost>
+int BasicFlowNetwork<Cap, Cost>::getArcOrig(int arc) const {
+    return arcOrig[arc];
+}
+
+template <class Cap, class Cost>
+int BasicFlowNetwork<Cap, Cost>::getArcDest(int arc) const {
+    return arcDest[arc];
+}
+
+template <class Cap, class Cost>
+Cap BasicFlowNetwork<Cap, Cost>::getArcCapacity(int arc) const {
+    return arcCapacity[arc];
+}
+
+template <class Cap, class Cost>
+int BasicFlowNetwork<Cap, Cost>::getArc(const Edge *e) const {
+    auto arc = arcIndex.find(e);
+    return arc == arcIndex.end() ? -1 : arc->second;
+}
+
+template <class Cap, class Cost>
+int BasicFlowNetwork<Cap, Cost>::getArcReverse(int arc) const {
+    return arcReverse[arc];
+}
+
+template <class Cap, class Cost>
+Cost BasicFlowNetwork<Cap, Cost>::getArcCost(int arc) const {
+    return arcCost[arc];
+}
+
+template <class Cap, class Cost>
+bool BasicFlowNetwork<Cap, Cost>::isArcDisabled(int arc) const {
+    return arcDisabled[arc];
+}
+
+template <class Cap, class Cost>
+vector<int> BasicFlowNetwork<Cap, Cost>::getSegments() const {
+    vector<int> segments;
+    for (int a = 0; a < (int) edges.size(); a++)
+        if (arcReverse[a] >= a && edges[a] != nullptr && !arcDisabled[a])
+            segments.push_back(a);
+    return segments;
+}
+
+template <class Cap, class Cost>
+int BasicFlowNetwork<Cap, Cost>::getOutDegree(int v) const {
+    return outStart[v + 1] - outStart[v];
+}
+
+template <class Cap, class Cost>
+int BasicFlowNetwork<Cap, Cost>::getOutArc(int v, int i) const {
+    return outArcs[outStart[v] + i];
+}
+
+template <class Cap, class Cost>
+void BasicFlowNetwork<Cap, Cost>::prepare(Workspace &ws) const {
+    METRIC_TIME(PREPARE_TIME);
+    ws.failed.clear();
+    ws.capacity.clear();
+    ws.cost.clear();
+    ws.flow.assign(edges.size(), 0);
+    ws.path.assign(vertices.size(), -1);
+    ws.visited.assign(vertices.size(), 0);
+    ws.queue.reserve(vertices.size());
+    ws.price.assign(vertices.size(), 0);
+    ws.potential.assign(vertices.size(), 0);
+    if (ws.buckets.getSize() != (int) vertices.size()) ws.buckets.resize(vertices.size());
+    ws.excess.assign(vertices.size(), 0);
+    ws.scaledPrice.assign(vertices.size(), 0);
+    ws.current.assign(vertices.size(), 0);
+    ws.marginalCosts.clear();
+    ws.marginalCosts.reserve(vertices.size());
+    ws.next.clear();
+    ws.reached.clear();
+    ws.stamp = 0;
+}
+
+template <class Cap, class Cost>
+void BasicFlowNetwork<Cap, Cost>::prepare(Workspace &ws, const Scenario &scenario) const {
+    prepare(ws);
+    applyScenario(ws, scenario);
+}
+
+template <class Cap, class Cost>
+void BasicFlowNetwork<Cap, Cost>::applyScenario(Workspace &ws, const Scenario &scenario) const {
+    ws.failed.clear();
+    ws.capacity.clear();
+    ws.cost.clear();
+
+    if (!scenario.getDisabledSegments().empty()) {
+        ws.failed.assign(edges.size(), false);
+        for (Edge *e: scenario.getDisabledSegments()) {
+            int a = getArc(e);
+            if (a != -1) ws.failed[a] = ws.failed[arcReverse[a]] = true;
+        }
+    }
+
+    // The capacities are only copied when the scenario changes some of them
+    if (!scenario.getCapacities().empty()) {
+        ws.capacity = arcCapacity;
+        for (auto &change: scenario.getCapacities()) {
+            int a = getArc(change.first);
+            if (a != -1) ws.capacity[a] = change.second;
+        }
+    }
+
+    if (!scenario.getCosts().empty()) {
+        ws.cost = arcCost;
+        for (auto &change: scenario.getCosts()) {
+            int a = getArc(change.first);
+            if (a != -1) ws.cost[a] = change.second;
+        }
+    }
+}
+
+template <class Cap, class Cost>
+const vector<Cap> &BasicFlowNetwork<Cap, Cost>::getCapacities(const Workspace &ws) const {
+    return ws.capacity.empty() ? arcCapacity : ws.capacity;
+}
+
+template <class Cap, class Cost>
+const vector<Cost> &BasicFlowNetwork<Cap, Cost>::getCosts(const Workspace &ws) const {
+    return ws.cost.empty() ? arcCost : ws.cost;
+}
+
+template <class Cap, class Cost>
+bool BasicFlowNetwork<Cap, Cost>::isSkipped(int a, const Workspace &ws) const {
+    int v = arcOrig[a], w = arcDest[a];
+
+    if (component[v] != 0 && component[w] != component[v])
+        return true;
+
+    if ((v == superSource && w == ws.sink) || a == ws.removedArc || arcReverse[a] == ws.removedArc)
+        return true;
+
+    return !ws.failed.empty() && ws.failed[a];
+}
+
+template <class Cap, class Cost>
+int BasicFlowNetwork<Cap, Cost>::scanForward(int v, int t, const vector<Cap> &capacity, Workspace &ws) const {
+    // Stamps of reached are only current during a bidirectional search, older ones never match
+    bool bidirectional = !ws.reached.empty();
+
+    for (int i = outStart[v]; i < outStart[v + 1]; i++) {
+        int a = outArcs[i];
+        int w = arcDest[a];
+
+        if (isSkipped(a, ws))
+            continue;
+
+        bool isNotFull = FlowTraits<Cap>::isLess(ws.flow[a] + ws.flow[arcReverse[a]], capacity[a]);
+
+        if (ws.visited[w] != ws.stamp && isNotFull && !arcDisabled[a]) {
+            ws.path[w] = a;
+            if (w == t || (bidirectional && ws.reached[w] == ws.stamp))
+                return w;
+
+            ws.visited[w] = ws.stamp;
+            ws.queue.push_back(w);
+        }
+    }
+
+    for (int i = inStart[v]; i < inStart[v + 1]; i++) {
+        int a = inArcs[i];
+        int w = arcOrig[a];
+
+        if (ws.visited[w] != ws.stamp && FlowTraits<Cap>::isLess(0, ws.flow[a]) && !arcDisabled[a]) {
+            ws.path[w] = a;
+            // Only reachable this way when the flow of t was repaired, a plain solve never sends flow out of t
+            if (w == t || (bidirectional && ws.reached[w] == ws.stamp))
+                return w;
+
+            ws.visited[w] = ws.stamp;
+            ws.queue.push_back(w);
+        }
+    }
+
+    return -1;
+}
+
+template <class Cap, class Cost>
+int BasicFlowNetwork<Cap, Cost>::scanBackward(int w, const vector<Cap> &capacity, Workspace &ws) const {
+    for (int i = inStart[w]; i < inStart[w + 1]; i++) {
+        int a = inArcs[i];
+        int v = arcOrig[a];
+
+        if (ws.reached[v] == ws.stamp || isSkipped(a, ws))
+            continue;
+
+        if (FlowTraits<Cap>::isLess(ws.flow[a] + ws.flow[arcReverse[a]], capacity[a]) && !arcDisabled[a]) {
+            ws.next[v] = a;
+            if (ws.visited[v] == ws.stamp)
+                return v;
+
+            ws.reached[v] = ws.stamp;
+            ws.backQueue.push_back(v);
+        }
+    }
+
+    for (int i = outStart[w]; i < outStart[w + 1]; i++) {
+        int a = outArcs[i];
+        int v = arcDest[a];
+
+        if (ws.reached[v] != ws.stamp && FlowTraits<Cap>::isLess(0, ws.flow[a]) && !arcDisabled[a]) {
+            ws.next[v] = a;
+            if (ws.visited[v] == ws.stamp)
+                return v;
+
+            ws.reached[v] = ws.stamp;
+            ws.backQueue.push_back(v);
+        }
+    }
+
+    return -1;
+}
+
+template <class Cap, class Cost>
+bool BasicFlowNetwork<Cap, Cost>::findPath(int s, int t, Workspace &ws) const {
+    if (ws.bidirectional)
+        return findPathBidirectional(s, t, ws);
+
+    // A new stamp marks every vertex as not visited without touching the whole vertex set
+    if (++ws.stamp == 0) {
+        fill(ws.visited.begin(), ws.visited.end(), 0);
+        fill(ws.reached.begin(), ws.reached.end(), 0);
+        ws.stamp = 1;
+    }
+
+    const vector<Cap> &capacity = getCapacities(ws);
+    ws.queue.clear();
+    ws.visited[s] = ws.stamp;
+    ws.path[s] = -1;
+    ws.queue.push_back(s);
+    // Counted locally and added once per search, so the metrics stay out of the inner loop
+    long long scanned = 0;
+    METRIC_ADD(PATH_SEARCHES, 1);
+
+    for (size_t head = 0; head < ws.queue.size(); head++) {
+        int v = ws.queue[head];
+        scanned += outStart[v + 1] - outStart[v] + inStart[v + 1] - inStart[v];
+
+        if (scanForward(v, t, capacity, ws) != -1) {
+            METRIC_ADD(ARCS_SCANNED, scanned);
+            METRIC_ADD(VERTICES_VISITED, ws.queue.size());
+            return true;
+        }
+    }
+
+    METRIC_ADD(ARCS_SCANNED, scanned);
+    METRIC_ADD(VERTICES_VISITED, ws.queue.size());
+    return false;
+}
+
+template <class Cap, class Cost>
+bool BasicFlowNetwork<Cap, Cost>::findPathBidirectional(int s, int t, Workspace &ws) const {
+    if (ws.reached.size() != vertices.size()) {
+        ws.reached.assign(vertices.size(), 0);
+        ws.next.assign(vertices.size(), -1);
+        ws.backQueue.reserve(vertices.size());
+    }
+
+    if (++ws.stamp == 0) {
+        fill(ws.visited.begin(), ws.visited.end(), 0);
+        fill(ws.reached.begin(), ws.reached.end(), 0);
+        ws.stamp = 1;
+    }
+
+    const vector<Cap> &capacity = getCapacities(ws);
+    ws.queue.clear();
+    ws.backQueue.clear();
+    ws.visited[s] = ws.stamp;
+    ws.path[s] = -1;
+    ws.queue.push_back(s);
+    ws.reached[t] = ws.stamp;
+    ws.next[t] = -1;
+    ws.backQueue.push_back(t);
+    long long scanned = 0;
+    METRIC_ADD(PATH_SEARCHES, 1);
+
+    size_t head = 0, backHead = 0;
+    int meet = -1;
+    while (meet == -1 && head < ws.queue.size() && backHead < ws.backQueue.size()) {
+        // No vertex is reached by both searches before they meet, so the first meeting closes a shortest path
+        if (ws.queue.size() - head <= ws.backQueue.size() - backHead) {
+            for (size_t end = ws.queue.size(); head < end && meet == -1; head++) {
+                int v = ws.queue[head];
+                scanned += outStart[v + 1] - outStart[v] + inStart[v + 1] - inStart[v];
+                meet = scanForward(v, t, capacity, ws);
+            }
+        }
+        else {
+            for (size_t end = ws.backQueue.size(); backHead < end && meet == -1; backHead++) {
+                int w = ws.backQueue[backHead];
+                scanned += outStart[w + 1] - outStart[w] + inStart[w + 1] - inStart[w];
+                meet = scanBackward(w, capacity, ws);
+            }
+        }
+    }
+
+    if (meet != -1) {
+        // The arcs from the meeting vertex to t become the rest of the path from s
+        for (int v = meet; v != t;) {
+            int a = ws.next[v];
+            int w = arcOrig[a] == v ? arcDest[a] : arcOrig[a];
+            ws.path[w] = a;
+            v = w;
+        }
+    }
+    else {
+        // Nothing reaches t anymore, the vertices reached from s are the source side of the min cut
+        for (; head < ws.queue.size(); head++) {
+            int v = ws.queue[head];
+            scanned += outStart[v + 1] - outStart[v] + inStart[v + 1] - inStart[v];
+            scanForward(v, t, capacity, ws);
+        }
+    }
+
+    METRIC_ADD(ARCS_SCANNED, scanned);
+    METRIC_ADD(VERTICES_VISITED, ws.queue.size() + ws.backQueue.size());
+    return meet != -1;
+}
+
+template <class Cap, class Cost>
+Cap BasicFlowNetwork<Cap, Cost>::findBottleneck(int t, const Workspace &ws) const {
+    const vector<Cap> &capacity = getCapacities(ws);
+    Cap cap = FlowTraits<Cap>::infinity();
+    int v = t;
+    int a = ws.path[v];
+
+    while (a != -1) {
+        Cap tmp = arcOrig[a] == v ? ws.flow[a] : capacity[a] - ws.flow[a] - ws.flow[arcReverse[a]];
+
+        if (tmp < cap)
+            cap = tmp;
+
+        v = arcOrig[a] == v ? arcDest[a] : arcOrig[a];
+        a = ws.path[v];
+    }
+
+    return cap;
+}
+
+template <class Cap, class Cost>
+void BasicFlowNetwork<Cap, Cost>::augmentFlow(int t, Cap flow, Workspace &ws) const {
+    METRIC_ADD(AUGMENTING_PATHS, 1);
+    int v = t;
+    int a = ws.path[v];
+
+    while (a != -1) {
+        if (arcOrig[a] == v) {
+            ws.flow[a] -= flow;
+            v = arcDest[a];
+        }
+        else {
+            ws.flow[a] += flow;
+            v = arcOrig[a];
+        }
+
+        a = ws.path[v];
+    }
+}
+
+template <class Cap, class Cost>
+Cap BasicFlowNetwork<Cap, Cost>::maxFlow(int s, int t, Workspace &ws) const {
+    METRIC_TIME(MAX_FLOW_TIME);
+    METRIC_ADD(MAX_FLOW_SOLVES, 1);
+    METRIC_LATENCY(EDMONDS_KARP_SOLVE);
+    ALLOCATION_SCOPE(MAX_FLOW_ALLOCATIONS);
+    TraceScope trace("solve", "maxFlow");
+    trace.addArg("source", s);
+    trace.addArg("sink", t);
+    if (ws.flow.size() != edges.size() || ws.visited.size() != vertices.size())
+        prepare(ws);
+    else
+        FlowKernels::clear(ws.flow);
+    ws.sink = t;
+    ws.marginalCosts.clear();
+
+    while (findPath(s, t, ws)) {
+        Cap flow = findBottleneck(t, ws);
+        augmentFlow(t, flow, ws);
+    }
+
+    Cap flow = 0;
+    for (int i = inStart[t]; i < inStart[t + 1]; i++)
+        flow += ws.flow[inArcs[i]];
+
+    return flow;
+}
+
+template <class Cap, class Cost>
+bool BasicFlowNetwork<Cap, Cost>::findCheapestPath(int s, int t, Workspace &ws) const {
+    const vector<Cap> &capacity = getCapacities(ws);
+    const vector<Cost> &costs = getCosts(ws);
+    int n = vertices.size();
+    fill(ws.price.begin(), ws.price.end(), FlowTraits<Cost>::infinity());
+    fill(ws.path.begin(), ws.path.end(), -1);
+    ws.price[s] = 0;
+    long long scanned = 0;
+    METRIC_ADD(PATH_SEARCHES, 1);
+
+    for (int i = 0; i < n; i++) {
+        bool relaxedAnArc = false;
+        scanned += 2 * (long long) edges.size();
+        METRIC_ADD(BELLMAN_FORD_ROUNDS, 1);
+
+        for (int v = 0; v < n; v++) {
+            // Relaxing from an unreached vertex would overflow its infinite price
+            if (ws.price[v] == FlowTraits<Cost>::infinity())
+                continue;
+
+            for (int j = outStart[v]; j < outStart[v + 1]; j++) {
+                int a = outArcs[j];
+                int w = arcDest[a];
+
+                if (isSkipped(a, ws) || arcDisabled[a])
+                    continue;
+
+                bool relaxArc = FlowTraits<Cost>::isLess(ws.price[v] + costs[a], ws.price[w]);
+                bool isNotFull = FlowTraits<Cap>::isLess(ws.flow[a] + ws.flow[arcReverse[a]], capacity[a]);
+
+                if (relaxArc && isNotFull) {
+                    ws.price[w] = ws.price[v] + costs[a];
+                    ws.path[w] = a;
+                    relaxedAnArc = true;
+                }
+            }
+
+            for (int j = inStart[v]; j < inStart[v + 1]; j++) {
+                int a = inArcs[j];
+                int w = arcOrig[a];
+
+                bool hasFlow = FlowTraits<Cap>::isLess(0, ws.flow[a]);
+
+                if (hasFlow && FlowTraits<Cost>::isLess(ws.price[v] - costs[a], ws.price[w])) {
+                    ws.price[w] = ws.price[v] - costs[a];
+                    ws.path[w] = a;
+                    relaxedAnArc = true;
+                }
+            }
+        }
+
+        if (!relaxedAnArc)
+            break;
+    }
+
+    METRIC_ADD(ARCS_SCANNED, scanned);
+    return ws.path[t] != -1;
+}
+
+template <class Cap, class Cost>
+bool BasicFlowNetwork<Cap, Cost>::findCheapestPathBuckets(int s, int t, Workspace &ws) const {
+    fill(ws.price.begin(), ws.price.end(), FlowTraits<Cost>::infinity());
+    fill(ws.path.begin(), ws.path.end(), -1);
+    ws.price[s] = 0;
+    ws.buckets.push(s, 0);
+    long long scanned = 0, settled = 0;
+    METRIC_ADD(PATH_SEARCHES, 1);
+
+    while (!ws.buckets.empty()) {
+        int v = ws.buckets.pop();
+        settled++;
+        if (v == t) break;
+        scanned += (outStart[v + 1] - outStart[v]) + (inStart[v + 1] - inStart[v]);
+        relaxReducedArcs(v, ws);
+    }
+    ws.buckets.clear();
+
+    METRIC_ADD(ARCS_SCANNED, scanned);
+    METRIC_ADD(VERTICES_VISITED, settled);
+    if (ws.path[t] == -1)
+        return false;
+
+    // Vertices not settled before t are at least as far as t, so they gain its price
+    for (size_t v = 0; v < ws.potential.size(); v++)
+        ws.potential[v] += min(ws.price[v], ws.price[t]);
+
+    return true;
+}
+
+template <class Cap, class Cost>
+void BasicFlowNetwork<Cap, Cost>::relaxReducedArcs(int v, Workspace &ws) const {
+    const vector<Cap> &capacity = getCapacities(ws);
+    const vector<Cost> &costs = getCosts(ws);
+
+    for (int j = outStart[v]; j < outStart[v + 1]; j++) {
+        int a = outArcs[j];
+        int w = arcDest[a];
+
+        if (isSkipped(a, ws) || arcDisabled[a] ||
+            !FlowTraits<Cap>::isLess(ws.flow[a] + ws.flow[arcReverse[a]], capacity[a]))
+            continue;
+
+        // Rounding can leave a floating point reduced cost slightly negative, the queue needs it at 0
+        Cost price = ws.price[v] + max<Cost>(0, costs[a] + ws.potential[v] - ws.potential[w]);
+        if (FlowTraits<Cost>::isLess(price, ws.price[w])) {
+            ws.price[w] = price;
+            ws.path[w] = a;
+            ws.buckets.push(w, price);
+        }
+    }
+
+    for (int j = inStart[v]; j < inStart[v + 1]; j++) {
+        int a = inArcs[j];
+        int w = arcOrig[a];
+
+        if (!FlowTraits<Cap>::isLess(0, ws.flow[a]))
+            continue;
+
+        Cost price = ws.price[v] + max<Cost>(0, ws.potential[v] - costs[a] - ws.potential[w]);
+        if (FlowTraits<Cost>::isLess(price, ws.price[w])) {
+            ws.price[w] = price;
+            ws.path[w] = a;
+            ws.buckets.push(w, price);
+        }
+    }
+}
+
+template <class Cap, class Cost>
+int BasicFlowNetwork<Cap, Cost>::findBalancingPath(int s, int t, Workspace &ws) const {
+    fill(ws.price.begin(), ws.price.end(), FlowTraits<Cost>::infinity());
+    fill(ws.path.begin(), ws.path.end(), -1);
+    bool fromExcess = false, shortage = false;
+    for (int v = 0; v < (int) vertices.size(); v++) {
+        if (FlowTraits<Cap>::isLess(0, ws.excess[v])) {
+            ws.price[v] = 0;
+            ws.buckets.push(v, 0);
+            fromExcess = true;
+        }
+        else if (FlowTraits<Cap>::isLess(ws.excess[v], 0)) shortage = true;
+    }
+
+    if (!fromExcess) {
+        if (!shortage) return -1;
+        ws.price[s] = ws.price[t] = 0;
+        ws.buckets.push(s, 0);
+        ws.buckets.push(t, 0);
+    }
+    METRIC_ADD(PATH_SEARCHES, 1);
+
+    int end = -1;
+    while (!ws.buckets.empty()) {
+        int v = ws.buckets.pop();
+        if (FlowTraits<Cap>::isLess(ws.excess[v], 0) || (fromExcess && (v == s || v == t))) {
+            end = v;
+            break;
+        }
+        relaxReducedArcs(v, ws);
+    }
+    ws.buckets.clear();
+
+    if (end == -1)
+        return -1;
+
+    for (size_t v = 0; v < ws.potential.size(); v++)
+        ws.potential[v] += min(ws.price[v], ws.price[end]);
+
+    return end;
+}
+
+template <class Cap, class Cost>
+Cost BasicFlowNetwork<Cap, Cost>::cheapestRoute(int s, int t, Workspace &ws) const {
+    METRIC_LATENCY(CHEAPEST_ROUTE_QUERY);
+    if (ws.flow.size() != edges.size() || ws.price.size() != vertices.size())
+        prepare(ws);
+    ws.sink = -1;
+
+    const vector<Cap> &capacity = getCapacities(ws);
+    const vector<Cost> &costs = getCosts(ws);
+    fill(ws.price.begin(), ws.price.end(), FlowTraits<Cost>::infinity());
+    fill(ws.path.begin(), ws.path.end(), -1);
+    ws.price[s] = 0;
+    ws.buckets.push(s, 0);
+
+    while (!ws.buckets.empty()) {
+        int v = ws.buckets.pop();
+        if (v == t) break;
+
+        for (int j = outStart[v]; j < outStart[v + 1]; j++) {
+            int a = outArcs[j];
+            int w = arcDest[a];
+            if (isSkipped(a, ws) || arcDisabled[a] || !FlowTraits<Cap>::isLess(0, capacity[a]))
+                continue;
+
+            Cost price = ws.price[v] + costs[a];
+            if (FlowTraits<Cost>::isLess(price, ws.price[w])) {
+                ws.price[w] = price;
+                ws.path[w] = a;
+                ws.buckets.push(w, price);
+            }
+        }
+    }
+    ws.buckets.clear();
+
+    return t == -1 ? 0 : ws.price[t];
+}
+
+template <class Cap, class Cost>
+vector<int> BasicFlowNetwork<Cap, Cost>::getRoute(int t, const Workspace &ws) const {
+    vector<int> route;
+    for (int v = t; ws.path[v] != -1; v = arcOrig[ws.path[v]])
+        route.push_back(ws.path[v]);
+    reverse(route.begin(), route.end());
+
+    return route;
+}
+
+template <class Cap, class Cost>
+void BasicFlowNetwork<Cap, Cost>::costScaling(Workspace &ws) const {
+    const vector<Cost> &costs = getCosts(ws);
+    // A min cost flow has no cycles, as every service costs something, so no arc carries more than its value
+    Cap bound = getFlowInto(ws.sink, ws);
+    long long scale = vertices.size() + 1;
+
+    long long epsilon = 0;
+    for (int a = 0; a < (int) edges.size(); a++)
+        epsilon = max(epsilon, (long long) costs[a] * scale);
+
+    fill(ws.scaledPrice.begin(), ws.scaledPrice.end(), 0);
+    fill(ws.excess.begin(), ws.excess.end(), 0);
+    while (epsilon > 1) {
+        epsilon = max(1LL, epsilon / ALPHA);
+        refine(epsilon, scale, bound, ws);
+    }
+}
+
+template <class Cap, class Cost>
+void BasicFlowNetwork<Cap, Cost>::refine(long long epsilon, long long scale, Cap bound, Workspace &ws) const {
+    const vector<Cap> &capacity = getCapacities(ws);
+    const vector<Cost> &costs = getCosts(ws);
+    int n = vertices.size();
+    long long pushes = 0, relabels = 0;
+
+    // The residual arc is a forward, with what is left of its capacity, or its reverse, with its flow
+    auto residual = [&](int a, bool forward) -> Cap {
+        if (!forward) return ws.flow[a];
+        if (isSkipped(a, ws) || arcDisabled[a]) return 0;
+        return min(capacity[a], bound) - ws.flow[a];
+    };
+    auto reducedCost = [&](int a, bool forward) -> long long {
+        long long cost = (long long) costs[a] * scale + ws.scaledPrice[arcOrig[a]] - ws.scaledPrice[arcDest[a]];
+        return forward ? cost : -cost;
+    };
+
+    for (int a = 0; a < (int) edges.size(); a++) {
+        int v = arcOrig[a], w = arcDest[a];
+        long long cost = reducedCost(a, true);
+
+        if (cost < 0) {
+            Cap r = residual(a, true);
+            ws.flow[a] += r;
+            ws.excess[v] -= r;
+            ws.excess[w] += r;
+        }
+        else if (cost > 0) {
+            Cap r = ws.flow[a];
+            ws.flow[a] = 0;
+            ws.excess[w] -= r;
+            ws.excess[v] += r;
+        }
+    }
+
+    // Global price update: the price of each vertex drops by epsilon for each arc of its cheapest residual path to a deficit,
+    // counting the arcs that are admissible or become so after a drop, which sets every price at once instead of one
+    // relabel at a time. The search stops once it reaches every vertex with excess, and the others drop as far as the last
+    auto updatePrices = [&]() {
+        vector<Cost> &distance = ws.price;
+        fill(distance.begin(), distance.end(), FlowTraits<Cost>::infinity());
+        int active = 0;
+        for (int v = 0; v < n; v++) {
+            if (ws.excess[v] < 0) {
+                distance[v] = 0;
+                ws.buckets.push(v, 0);
+            }
+            else if (ws.excess[v] > 0) active++;
+        }
+
+        auto relax = [&](int v, int w, long long cost) {
+            Cost d = distance[w] + (cost < 0 ? 0 : cost / epsilon + 1);
+            if (d < distance[v]) {
+                distance[v] = d;
+                ws.buckets.push(v, d);
+            }
+        };
+
+        Cost reached = 0;
+        while (!ws.buckets.empty() && active > 0) {
+            int w = ws.buckets.pop();
+            reached = distance[w];
+            if (ws.excess[w] > 0) active--;
+
+            // The residual arcs into w are the forwards that end at it and the reverses of the arcs that leave it
+            for (int j = inStart[w]; j < inStart[w + 1]; j++) {
+                int a = inArcs[j];
+                if (residual(a, true) > 0) relax(arcOrig[a], w, reducedCost(a, true));
+            }
+            for (int j = outStart[w]; j < outStart[w + 1]; j++) {
+                int a = outArcs[j];
+                if (residual(a, false) > 0) relax(arcDest[a], w, reducedCost(a, false));
+            }
+        }
+        ws.buckets.clear();
+
+        for (int v = 0; v < n; v++) {
+            ws.scaledPrice[v] -= (long long) min(distance[v], reached) * epsilon;
+            ws.current[v] = 0;
+        }
+    };
+
+    // Active vertices wait in a ring of V slots, as each one is queued at most once
+    vector<int> &ring = ws.queue;
+    ring.resize(n);
+    int head = 0, queued = 0;
+    for (int v = 0; v < n; v++)
+        if (ws.excess[v] > 0) ring[(head + queued++) % n] = v;
+
+    updatePrices();
+    long long sinceUpdate = 0;
+
+    while (queued > 0) {
+        int v = ring[head];
+        head = (head + 1) % n;
+        queued--;
+
+        int outDegree = outStart[v + 1] - outStart[v];
+        int degree = outDegree + inStart[v + 1] - inStart[v];
+
+        while (ws.excess[v] > 0) {
+            if (ws.current[v] == degree) {
+                // No admissible arc left: the price drops to make the best residual arc admissible again
+                long long price = LLONG_MIN;
+                for (int j = 0; j < degree; j++) {
+                    bool forward = j < outDegree;
+                    int a = forward ? outArcs[outStart[v] + j] : inArcs[inStart[v] + j - outDegree];
+                    if (residual(a, forward) > 0)
+                        price = max(price, ws.scaledPrice[v] - reducedCost(a, forward));
+                }
+
+                ws.scaledPrice[v] = price - epsilon;
+                ws.current[v] = 0;
+                relabels++;
+
+                // After about one relabel per vertex, a global update is worth its O(E) search
+                if (++sinceUpdate >= n) {
+                    updatePrices();
+                    sinceUpdate = 0;
+                }
+                continue;
+            }
+
+            int j = ws.current[v];
+            bool forward = j < outDegree;
+            int a = forward ? outArcs[outStart[v] + j] : inArcs[inStart[v] + j - outDegree];
+            Cap r = residual(a, forward);
+
+            if (r > 0 && reducedCost(a, forward) < 0) {
+                int w = forward ? arcDest[a] : arcOrig[a];
+                Cap delta = min(ws.excess[v], r);
+                ws.flow[a] += forward ? delta : -delta;
+                ws.excess[v] -= delta;
+                if (ws.excess[w] <= 0 && ws.excess[w] + delta > 0) ring[(head + queued++) % n] = w;
+                ws.excess[w] += delta;
+                pushes++;
+            }
+            else
+                ws.current[v]++;
+        }
+    }
+
+    METRIC_ADD(PUSHES, pushes);
+    METRIC_ADD(RELABELS, relabels);
+}
+
+template <class Cap, class Cost>
+Cap BasicFlowNetwork<Cap, Cost>::minCostMaxFlow(int s, int t, Workspace &ws) const {
+    // Cost scaling needs integer costs
+    bool scaling = ws.engine == COST_SCALING && FlowTraits<Cost>::exact && FlowTraits<Cap>::exact;
+    METRIC_TIME(MIN_COST_TIME);
+    METRIC_ADD(MIN_COST_SOLVES, 1);
+    METRIC_LATENCY(scaling ? COST_SCALING_SOLVE : SUCCESSIVE_SHORTEST_PATHS_SOLVE);
+    ALLOCATION_SCOPE(MIN_COST_ALLOCATIONS);
+    TraceScope trace("solve", "minCostMaxFlow");
+    trace.addArg("source", s);
+    trace.addArg("sink", t);
+    if (ws.flow.size() != edges.size() || ws.price.size() != vertices.size())
+        prepare(ws);
+    else
+        FlowKernels::clear(ws.flow);
+    fill(ws.potential.begin(), ws.potential.end(), 0);
+    ws.sink = t;
+
+    if (scaling) {
+        while (findPath(s, t, ws)) {
+            Cap flow = findBottleneck(t, ws);
+            augmentFlow(t, flow, ws);
+        }
+        costScaling(ws);
+        ws.marginalCosts.clear();
+    }
+    else
+        successiveCheapestPaths(s, t, FlowTraits<Cap>::infinity(), ws);
+
+    // The cheapest path search doesn't leave the min cut behind, a failed search for any path does
+    findPath(s, t, ws);
+    return getFlowInto(t, ws);
+}
+
+template <class Cap, class Cost>
+Cap BasicFlowNetwork<Cap, Cost>::minCostFlow(int s, int t, Cap target, Workspace &ws) const {
+    METRIC_TIME(MIN_COST_TIME);
+    METRIC_ADD(MIN_COST_SOLVES, 1);
+    METRIC_LATENCY(SUCCESSIVE_SHORTEST_PATHS_SOLVE);
+    ALLOCATION_SCOPE(MIN_COST_ALLOCATIONS);
+    TraceScope trace("solve", "minCostFlow");
+    trace.addArg("source", s);
+    trace.addArg("sink", t);
+    if (ws.flow.size() != edges.size() || ws.price.size() != vertices.size())
+        prepare(ws);
+    else
+        FlowKernels::clear(ws.flow);
+    fill(ws.potential.begin(), ws.potential.end(), 0);
+    ws.sink = t;
+
+    Cap value = successiveCheapestPaths(s, t, target, ws);
+    if (FlowTraits<Cap>::isLess(value, target)) {
+        findPath(s, t, ws);
+        return value;
+    }
+
+    // A new stamp puts every vertex on the sink side, as a flow short of the max has no min cut
+    if (++ws.stamp == 0) {
+        fill(ws.visited.begin(), ws.visited.end(), 0);
+        fill(ws.reached.begin(), ws.reached.end(), 0);
+        ws.stamp = 1;
+    }
+    return value;
+}
+
+template <class Cap, class Cost>
+bool BasicFlowNetwork<Cap, Cost>::reoptimize(int s, int t, Workspace &ws) const {
+    METRIC_TIME(MIN_COST_TIME);
+    METRIC_ADD(MIN_COST_SOLVES, 1);
+    METRIC_LATENCY(WARM_MIN_COST_SOLVE);
+    ALLOCATION_SCOPE(MIN_COST_ALLOCATIONS);
+    TraceScope trace("solve", "reoptimize");
+    trace.addArg("source", s);
+    trace.addArg("sink", t);
+    const vector<Cap> &capacity = getCapacities(ws);
+    const vector<Cost> &costs = getCosts(ws);
+    int m = edges.size();
+    ws.sink = t;
+
+    // First the flow that no longer fits and the flow against the potentials are removed, which can only open forward
+    // arcs, and then the forward arcs against the potentials are saturated: no optimal flow uses both arcs of a segment,
+    // as their reduced costs add up to twice the service, so the second pass never has to empty the other arc
+    for (int a = 0; a < m; a++) {
+        if (!FlowTraits<Cap>::isLess(0, ws.flow[a]))
+            continue;
+
+        Cap other = arcReverse[a] == a ? 0 : ws.flow[arcReverse[a]];
+        Cap limit = isSkipped(a, ws) || arcDisabled[a] ? 0 : max<Cap>(0, capacity[a] - other);
+        if (FlowTraits<Cap>::isLess(limit, ws.flow[a])) ws.flow[a] = limit;
+        if (FlowTraits<Cost>::isLess(0, costs[a] + ws.potential[arcOrig[a]] - ws.potential[arcDest[a]]))
+            ws.flow[a] = 0;
+    }
+    for (int a = 0; a < m; a++) {
+        if (!FlowTraits<Cost>::isLess(costs[a] + ws.potential[arcOrig[a]] - ws.potential[arcDest[a]], 0) ||
+            isSkipped(a, ws) || arcDisabled[a])
+            continue;
+        if (capacity[a] == FlowTraits<Cap>::infinity())
+            return false;
+
+        Cap other = arcReverse[a] == a ? 0 : ws.flow[arcReverse[a]];
+        ws.flow[a] = max<Cap>(ws.flow[a], capacity[a] - other);
+    }
+
+    for (int v = 0; v < (int) vertices.size(); v++)
+        ws.excess[v] = v == s || v == t ? 0 : getFlowInto(v, ws);
+
+    for (int end = findBalancingPath(s, t, ws); end != -1; end = findBalancingPath(s, t, ws)) {
+        int start = end;
+        while (ws.path[start] != -1)
+            start = arcOrig[ws.path[start]] == start ? arcDest[ws.path[start]] : arcOrig[ws.path[start]];
+
+        Cap flow = findBottleneck(end, ws);
+        if (start != s && start != t) flow = min(flow, ws.excess[start]);
+        if (end != s && end != t) flow = min(flow, -ws.excess[end]);
+
+        augmentFlow(end, flow, ws);
+        if (start != s && start != t) ws.excess[start] -= flow;
+        if (end != s && end != t) ws.excess[end] += flow;
+    }
+
+    for (int v = 0; v < (int) vertices.size(); v++)
+        if (FlowTraits<Cap>::isLess(0, ws.excess[v]) || FlowTraits<Cap>::isLess(ws.excess[v], 0)) return false;
+
+    successiveCheapestPaths(s, t, FlowTraits<Cap>::infinity(), ws);
+    ws.marginalCosts.clear();
+    findPath(s, t, ws);
+    return true;
+}
+
+template <class Cap, class Cost>
+Cap BasicFlowNetwork<Cap, Cost>::successiveCheapestPaths(int s, int t, Cap target, Workspace &ws) const {
+    // COST_SCALING lands here only through minCostFlow, which needs the paths
+    bool bellmanFord = ws.engine == BELLMAN_FORD;
+    Cap value = 0;
+    ws.marginalCosts.clear();
+
+    while (FlowTraits<Cap>::isLess(value, target) &&
+           (bellmanFord ? findCheapestPath(s, t, ws) : findCheapestPathBuckets(s, t, ws))) {
+        Cap flow = min(findBottleneck(t, ws), target - value);
+        augmentFlow(t, flow, ws);
+        value += flow;
+
+        // Paths never get cheaper, so a path as cheap as the last one extends its step of the curve
+        Cost cost = getPathCost(t, ws);
+        if (!ws.marginalCosts.empty() && !FlowTraits<Cost>::isLess(ws.marginalCosts.back().second, cost))
+            ws.marginalCosts.back().first += flow;
+        else
+            ws.marginalCosts.emplace_back(flow, cost);
+    }
+
+    return value;
+}
+
+template <class Cap, class Cost>
+Cost BasicFlowNetwork<Cap, Cost>::getPathCost(int t, const Workspace &ws) const {
+    const vector<Cost> &costs = getCosts(ws);
+    Cost cost = 0;
+    int v = t;
+    int a = ws.path[v];
+
+    while (a != -1) {
+        if (arcOrig[a] == v) {
+            cost -= costs[a];
+            v = arcDest[a];
+        }
+        else {
+            cost += costs[a];
+            v = arcOrig[a];
+        }
+
+        a = ws.path[v];
+    }
+
+    return cost;
+}
+
+template <class Cap, class Cost>
+typename BasicFlowNetwork<Cap, Cost>::Result
+BasicFlowNetwork<Cap, Cost>::getMaxFlow(int s, int t, const Scenario &scenario) const {
+    Workspace ws;
+    prepare(ws, scenario);
+    maxFlow(s, t, ws);
+    return getResult(ws);
+}
+
+template <class Cap, class Cost>
+typename BasicFlowNetwork<Cap, Cost>::Result
+BasicFlowNetwork<Cap, Cost>::getMinCostMaxFlow(int s, int t, const Scenario &scenario,
+                                               enum minCostEngine engine) const {
+    Workspace ws;
+    ws.engine = engine;
+    prepare(ws, scenario);
+    minCostMaxFlow(s, t, ws);
+    return getResult(ws);
+}
+
+template <class Cap, class Cost>
+typename BasicFlowNetwork<Cap, Cost>::Result
+BasicFlowNetwork<Cap, Cost>::getMinCostFlow(int s, int t, Cap target, const Scenario &scenario) const {
+    Workspace ws;
+    prepare(ws, scenario);
+    minCostFlow(s, t, target, ws);
+    return getResult(ws);
+}
+
+template <class Cap, class Cost>
+typename BasicFlowNetwork<Cap, Cost>::Result
+BasicFlowNetwork<Cap, Cost>::getResult(const Workspace &ws) const {
+    Result result;
+    result.value = getFlowInto(ws.sink, ws);
+    result.flow = ws.flow;
+
+    result.sourceSide.resize(vertices.size());
+    for (int v = 0; v < (int) vertices.size(); v++)
+        result.sourceSide[v] = isSourceSide(v, ws);
+
+    result.cost = FlowKernels::sumProducts(ws.flow, getCosts(ws));
+    result.marginalCosts = ws.marginalCosts;
+    for (int a = 0; a < (int) edges.size(); a++) {
+        if (result.sourceSide[arcOrig[a]] && !result.sourceSide[arcDest[a]] && !arcDisabled[a] && !isSkipped(a, ws))
+            result.cutArcs.push_back(a);
+    }
+
+    return result;
+}
+
+template <class Cap, class Cost>
+vector<Edge *> BasicFlowNetwork<Cap, Cost>::getUsedEdges(const Result &result) const {
+    vector<Edge *> used;
+    for (int a = 0; a < (int) edges.size(); a++)
+        if (FlowTraits<Cap>::isLess(0, result.flow[a]) && edges[a] != nullptr) used.push_back(edges[a]);
+
+    return used;
+}
+
+template <class Cap, class Cost>
+vector<Edge *> BasicFlowNetwork<Cap, Cost>::getCutEdges(const Result &result) const {
+    vector<Edge *> cut;
+    for (int a: result.cutArcs)
+        if (edges[a] != nullptr) cut.push_back(edges[a]);
+
+    return cut;
+}
+
+template <class Cap, class Cost>
+Cap BasicFlowNetwork<Cap, Cost>::pushFlow(int from, int to, Cap amount, Workspace &ws) const {
+    if (from == to)
+        return amount;
+
+    Cap pushed = 0;
+    while (FlowTraits<Cap>::isLess(pushed, amount) && findPath(from, to, ws)) {
+        Cap flow = min(findBottleneck(to, ws), amount - pushed);
+        augmentFlow(to, flow, ws);
+        pushed += flow;
+    }
+
+    return pushed;
+}
+
+template <class Cap, class Cost>
+Cap BasicFlowNetwork<Cap, Cost>::repairFlow(int s, int t, int arc, Workspace &ws) const {
+    METRIC_TIME(REPAIR_TIME);
+    METRIC_ADD(FLOW_REPAIRS, 1);
+    METRIC_LATENCY(FLOW_REPAIR_SOLVE);
+    ALLOCATION_SCOPE(REPAIR_ALLOCATIONS);
+    TraceScope trace("solve", "repairFlow");
+    trace.addArg("source", s);
+    trace.addArg("sink", t);
+    trace.addArg("arc", arc);
+    int u = arcOrig[arc], w = arcDest[arc];
+    Cap excess = ws.flow[arc] - (arcReverse[arc] == arc ? 0 : ws.flow[arcReverse[arc]]);
+    if (excess < 0) {
+        swap(u, w);
+        excess = -excess;
+    }
+
+    ws.flow[arc] = ws.flow[arcReverse[arc]] = 0;
+    ws.sink = t;
+    ws.removedArc = arc;
+    ws.marginalCosts.clear();
+
+    // Removing the segment leaves u with more flow entering than leaving and w with the opposite
+    Cap remaining = excess - pushFlow(u, w, excess, ws);
+    pushFlow(u, s, remaining, ws);
+    pushFlow(t, w, remaining, ws);
+
+    while (findPath(s, t, ws)) {
+        Cap flow = findBottleneck(t, ws);
+        augmentFlow(t, flow, ws);
+    }
+
+    ws.removedArc = -1;
+    return getFlowInto(t, ws);
+}
+
+template <class Cap, class Cost>
+Cap BasicFlowNetwork<Cap, Cost>::getFlowInto(int t, const Workspace &ws) const {
+    return FlowKernels::gatherSum(ws.flow, inArcs.data() + inStart[t], inStart[t + 1] - inStart[t])
+         - FlowKernels::gatherSum(ws.flow, outArcs.data() + outStart[t], outStart[t + 1] - outStart[t]);
+}
+
+template <class Cap, class Cost>
+bool BasicFlowNetwork<Cap, Cost>::isSourceSide(int v, const Workspace &ws) const {
+    // The last search of maxFlow failed, so it visited exactly the vertices reachable from the source
+    return ws.visited[v] == ws.stamp;
+}
+
+template <class Cap, class Cost>
+void BasicFlowNetwork<Cap, Cost>::applyFlow(const vector<Cap> &flow) const {
+    for (int a = 0; a < (int) edges.size(); a++)
+        if (edges[a] != nullptr) edges[a]->setFlow(flow.empty() ? 0 : (int) flow[a]);
+}
+
+template class BasicFlowNetwork<int, int>;
+template class BasicFlowNetwork<long long, long long>;
+template class BasicFlowNetwork<double, double>;
@@ -0,0 +1,698 @@
+#ifndef PROJECT_RAILWAY_FLOWNETWORK_H
+#define PROJECT_RAILWAY_FLOWNETWORK_H
+
+#include <vector>
+#include <unordered_map>
+#include "BucketQueue.h"
+#include "Graph.h"
+#include "FlowTraits.h"
+#include "Scenario.h"
+
+using namespace std;
+
+/**
+ * Search that finds the cheapest augmenting paths of the min cost solves.
+ */
+enum minCostEngine {
+    BELLMAN_FORD, /**< Bellman-Ford over the residual network, O(V*E) per path */
+    BUCKET_DIJKSTRA, /**< Dijkstra over reduced costs with a bucket queue, O(E + V*log(C)) per path */
+    COST_SCALING /**< Goldberg's cost-scaling push-relabel over a max flow, O(V²*E*log(V*C)) overall */
+};
+
+/**
+ * Gets the engine of the workspaces that don't pick one, so every min cost solve of a run (menus, batch analyses and the
+ * bench) can be switched at once. It is the value of the RAILWAY_MIN_COST_ENGINE environment variable when set to
+ * "bellman-ford", "dijkstra" or "cost-scaling", and BUCKET_DIJKSTRA otherwise.
+ * @return the default engine
+ */
+enum minCostEngine getDefaultMinCostEngine();
+
+/**
+ * Scratch state of a single max flow computation over a BasicFlowNetwork.
+ * Every thread owns its own workspace, so several solves can run at the same time over the same (read-only) network.
+ * @tparam Cap - the type of the capacities and flows
+ * @tparam Cost - the type of the costs
+ */
+template <class Cap, class Cost>
+struct BasicFlowWorkspace {
+    vector<Cap> flow; /**< Flow of each arc */
+    vector<int> path; /**< Arc used to reach each vertex during the last search (-1 if none) */
+    vector<unsigned> visited; /**< Stamp of the last search that visited each vertex */
+    vector<int> queue; /**< BFS queue, reused between searches */
+    unsigned stamp = 0; /**< Stamp of the current search */
+    int sink = -1; /**< Sink of the current solve, whose segment to the super source is never used */
+    int removedArc = -1; /**< Arc whose segment (both directions) is ignored by the searches, -1 if none */
+    vector<char> failed; /**< True for the arcs ignored by the searches (empty if none), set on both arcs of a segment */
+    vector<Cap> capacity; /**< Capacity of each arc when a scenario changes some of them (empty to use the network's) */
+    vector<Cost> cost; /**< Cost of each arc when a scenario changes some of them (empty to use the network's) */
+    vector<Cost> price; /**< Cost of the cheapest path to each vertex found by the last min cost search (reduced by the
+                             potentials with BUCKET_DIJKSTRA) */
+    enum minCostEngine engine = getDefaultMinCostEngine(); /**< Engine of minCostMaxFlow */
+    vector<Cost> potential; /**< Potential of each vertex, keeping the reduced costs of the residual arcs non-negative */
+    BucketQueue<Cost> buckets; /**< Queue of the Dijkstra searches, reused between searches */
+    vector<Cap> excess; /**< Flow entering each vertex minus the flow leaving it, during a refine of COST_SCALING */
+    vector<long long> scaledPrice; /**< Price of each vertex in the costs of COST_SCALING, scaled by V+1 */
+    vector<int> current; /**< Next residual arc of each vertex to try pushing through, during a refine */
+    vector<pair<Cap, Cost>> marginalCosts; /**< Flow sent at each cost per unit by the last min cost solve, cheapest first */
+    bool bidirectional = false; /**< True to search for augmenting paths from both the source and the sink */
+    vector<int> next; /**< Arc that leads each vertex towards the sink during the last bidirectional search */
+    vector<unsigned> reached; /**< Stamp of the last bidirectional search that reached each vertex from the sink */
+    vector<int> backQueue; /**< BFS queue of the search from the sink, reused between searches */
+};
+
+/**
+ * Outcome of a max flow computation over a BasicFlowNetwork, indexed like the network.
+ * The min cut is the one left by the last (failed) search for an augmenting path: the vertices it still reached form the
+ * source side, and the arcs leaving them are saturated, so their capacities add up to the value of the flow.
+ * @tparam Cap - the type of the capacities and flows
+ * @tparam Cost - the type of the costs
+ */
+template <class Cap, class Cost>
+struct BasicFlowResult {
+    Cap value = 0; /**< Value of the flow */
+    Cost cost = 0; /**< Cost of the flow (sum of the flow times the service of each arc) */
+    vector<Cap> flow; /**< Flow of each arc */
+    vector<bool> sourceSide; /**< True for the vertices on the source side of the min cut */
+    vector<int> cutArcs; /**< Arcs from the source side to the sink side (one per segment of the min cut) */
+    vector<pair<Cap, Cost>> marginalCosts; /**< Flow sent at each cost per unit, cheapest first (empty unless it was solved
+                                                by successive cheapest paths) */
+};
+
+/**
+ * Compact, index based snapshot of a Graph, on which every flow algorithm of the project runs.
+ * Arcs mirror the Edge objects of the graph (two directed arcs per segment) and keep the same adjacency order, so the
+ * augmenting paths follow the order in which the segments were read. The flow itself lives in a workspace, which
+ * keeps the network read-only while it is being solved; applyFlow copies a result back to the edges to display it.
+ * The engines are templates over the types of the capacities (and flows) and of the costs, so the same code runs 32-bit
+ * kernels over the railway (FlowNetwork) and 64-bit or floating point ones over models whose totals would overflow an
+ * int (WideFlowNetwork, RealFlowNetwork). FlowTraits gives each type its infinity and comparisons.
+ * @tparam Cap - the type of the capacities and flows
+ * @tparam Cost - the type of the costs
+ */
+template <class Cap, class Cost>
+class BasicFlowNetwork {
+public:
+    typedef BasicFlowWorkspace<Cap, Cost> Workspace; /**< Workspace of the solves over this network */
+    typedef BasicFlowResult<Cap, Cost> Result; /**< Result of the solves over this network */
+
+    /**
+     * Takes a snapshot of the topology and capacities of a graph, with the changes of a scenario: its disabled segments
+     * are disabled arcs and its capacities replace the ones of the graph.
+     * Time Complexity: O(V*log(V) + E), where V is the number of vertices and E is the number of edges.
+     * @param gh - the graph to snapshot
+     * @param scenario - the changes to the graph (none by default)
+     */
+    explicit BasicFlowNetwork(const Graph &gh, const Scenario &scenario = Scenario());
+
+    /**
+     * Takes a snapshot of the subgraph induced by a set of stations: only the segments with both stations in the set are
+     * kept. Searches over it are restricted to the region and ignore the connected components. No scenario applies to it.
+     * Time Complexity: O(S*log(S) + E), where S is the number of stations and E is the number of edges leaving them.
+     * @param stations - the stations of the subgraph
+     */
+    explicit BasicFlowNetwork(const vector<Vertex *> &stations);
+
+    /**
+     * Takes a snapshot of a graph plus a super source: an extra vertex (with no station, in component 0) connected to
+     * every line extreme by a segment of unbounded capacity and the STANDARD service. Solving from the super source
+     * ignores its segment to the sink, so every station can be solved over the same network.
+     * Time Complexity: O(V*log(V) + E), where V is the number of vertices and E is the number of edges.
+     * @param gh - the graph to snapshot
+     * @param extremes - the vertices connected to the super source
+     * @param scenario - the changes to the graph (none by default)
+     */
+    BasicFlowNetwork(const Graph &gh, const unordered_set<Vertex *> &extremes, const Scenario &scenario = Scenario());
+
+    /**
+     * Gets the number of vertices of the network.
+     * @return the number of vertices
+     */
+    int getSize() const;
+
+    /**
+     * Gets the index of the super source.
+     * @return the index of the super source, or -1 if the network has none
+     */
+    int getSuperSource() const;
+
+    /**
+     * Gets the number of (directed) arcs of the network.
+     * @return the number of arcs
+     */
+    int getArcCount() const;
+
+    /**
+     * Gets the index of a vertex of the original graph.
+     * @param v - the vertex
+     * @return the index of the vertex, or -1 if it is not part of the network
+     */
+    int indexOf(const Vertex *v) const;
+
+    /**
+     * Gets the vertex of the original graph with a certain index.
+     * @param i - the index of the vertex
+     * @return the vertex (nullptr for the super source)
+     */
+    Vertex *getVertex(int i) const;
+
+    /**
+     * Gets the edge of the original graph that corresponds to a certain arc.
+     * @param arc - the index of the arc
+     * @return the edge (nullptr for the arcs of the super source)
+     */
+    Edge *getEdge(int arc) const;
+
+    /**
+     * Gets the origin vertex of an arc.
+     * @param arc - the index of the arc
+     * @return the index of the origin vertex
+     */
+    int getArcOrig(int arc) const;
+
+    /**
+     * Gets the destination vertex of an arc.
+     * @param arc - the index of the arc
+     * @return the index of the destination vertex
+     */
+    int getArcDest(int arc) const;
+
+    /**
+     * Gets the capacity of an arc.
+     * @param arc - the index of the arc
+     * @return the capacity of the arc
+     */
+    Cap getArcCapacity(int arc) const;
+
+    /**
+     * Gets the arc that corresponds to an edge of the original graph.
+     * @param e - the edge
+     * @return the index of the arc, or -1 if the edge is not part of the network
+     */
+    int getArc(const Edge *e) const;
+
+    /**
+     * Gets the reverse arc of an arc.
+     * @param arc - the index of the arc
+     * @return the index of the reverse arc
+     */
+    int getArcReverse(int arc) const;
+
+    /**
+     * Gets the cost of sending one unit of flow through an arc (the service of its segment).
+     * @param arc - the index of the arc
+     * @return the cost of the arc
+     */
+    Cost getArcCost(int arc) const;
+
+    /**
+     * Checks if an arc is disabled.
+     * @param arc - the index of the arc
+     * @return true if the arc is disabled, false otherwise
+     */
+    bool isArcDisabled(int arc) const;
+
+    /**
+     * Gets the segments of the railway that are still enabled, i.e. the segments that can fail. Segments of the super
+     * source are not part of the railway, and disabled ones already failed.
+     * Time Complexity: O(E), where E is the number of arcs.
+     * @return an arc of each segment (the one with the lowest index), in increasing order
+     */
+    vector<int> getSegments() const;
+
+    /**
+     * Gets the number of outgoing arcs of a vertex.
+     * @param v - the index of the vertex
+     * @return the number of outgoing arcs
+     */
+    int getOutDegree(int v) const;
+
+    /**
+     * Gets the i-th outgoing arc of a vertex, in adjacency order.
+     * @param v - the index of the vertex
+     * @param i - the position of the arc, in [0, getOutDegree(v))
+     * @return the index of the arc
+     */
+    int getOutArc(int v, int i) const;
+
+    /**
+     * Sizes a workspace for this network, clears its flow and removes any scenario from it.
+     * Time Complexity: O(V+E), where V is the number of vertices and E is the number of edges.
+     * @param ws - the workspace to prepare
+     */
+    void prepare(Workspace &ws) const;
+
+    /**
+     * Prepares a workspace to solve a scenario over this network: the disabled segments of the scenario are skipped by
+     * the searches, and its capacities and costs are used instead of the network's. The network is not modified, so several
+     * scenarios can be solved at the same time over it, each in its own workspace. The scenario stays in the workspace
+     * for the following solves, until the workspace is prepared again.
+     * Time Complexity: O(V+E), where V is the number of vertices and E is the number of edges.
+     * @param ws - the workspace to prepare
+     * @param scenario - the scenario
+     */
+    void prepare(Workspace &ws, const Scenario &scenario) const;
+
+    /**
+     * Replaces the scenario of a prepared workspace, keeping its flow and potentials, e.g. to re-optimize the last solve
+     * after a what-if change (see reoptimize).
+     * Time Complexity: O(E) if the scenario changes capacities or costs, O(D) otherwise, where E is the number of edges and
+     * D is the number of disabled segments.
+     * @param ws - the prepared workspace
+     * @param scenario - the new scenario
+     */
+    void applyScenario(Workspace &ws, const Scenario &scenario) const;
+
+    /**
+     * Calculates the max flow between two vertices, leaving the flow of each arc in the workspace. When s is the super
+     * source, its segment to t (if any) is not used. Neither are the segment of ws.removedArc and the arcs in ws.failed.
+     * With ws.bidirectional, the augmenting paths are searched from both ends (see findPathBidirectional).
+     * Time Complexity: O(V*E²), where V is the number of vertices and E is the number of edges.
+     * @param s - the index of the source vertex
+     * @param t - the index of the sink vertex
+     * @param ws - the workspace used by the computation
+     * @return the max flow between s and t
+     */
+    Cap maxFlow(int s, int t, Workspace &ws) const;
+
+    /**
+     * Calculates the max flow between two vertices that minimizes its cost, leaving the flow of each arc in the workspace.
+     * With BELLMAN_FORD and BUCKET_DIJKSTRA, augments along the cheapest path while there is one, found by Bellman-Ford
+     * over the residual network or by Dijkstra over the costs reduced by the potentials of the vertices (see
+     * findCheapestPathBuckets). With COST_SCALING, finds a max flow and then cancels its costly cycles by cost scaling
+     * (see costScaling); floating point networks use BUCKET_DIJKSTRA instead, since cost scaling needs integer costs.
+     * Time Complexity: O(V*E*F) with BELLMAN_FORD, O((E + V*log(C))*F) with BUCKET_DIJKSTRA and O(V²*E*log(V*C)) with
+     * COST_SCALING, where V is the number of vertices, E is the number of edges, F is the max flow and C is the cost of
+     * the most expensive path (or arc, for COST_SCALING).
+     * @param s - the index of the source vertex
+     * @param t - the index of the sink vertex
+     * @param ws - the workspace used by the computation
+     * @return the max flow between s and t
+     */
+    Cap minCostMaxFlow(int s, int t, Workspace &ws) const;
+
+    /**
+     * Calculates the cheapest flow of a certain value between two vertices (or the max flow, if it is lower), leaving the
+     * flow of each arc in the workspace. Augments along the cheapest path like minCostMaxFlow, but stops as soon as the
+     * target is met, so small targets don't pay for the max flow. Each path costs at least as much per unit as the one
+     * before, so ws.marginalCosts ends up holding the cost of each extra unit. A flow that meets its target leaves no min
+     * cut behind. COST_SCALING, which only works on a max flow, is replaced by BUCKET_DIJKSTRA.
+     * Time Complexity: O(V*E*K) with BELLMAN_FORD and O((E + V*log(C))*K) otherwise, where V is the number of vertices, E
+     * is the number of edges, K is the value of the flow and C is the cost of the most expensive path.
+     * @param s - the index of the source vertex
+     * @param t - the index of the sink vertex
+     * @param target - the value of the flow
+     * @param ws - the workspace used by the computation
+     * @return the value of the flow (the target, or the max flow if it is lower)
+     */
+    Cap minCostFlow(int s, int t, Cap target, Workspace &ws) const;
+
+    /**
+     * Turns the min cost max flow left in a workspace by an earlier solve into the one between two vertices, after the
+     * endpoints or the scenario of the workspace changed, moving only the flow the change affects. The potentials of the
+     * earlier solve keep the reduced costs of most residual arcs non-negative: the flow the new capacities no longer fit
+     * is removed, and arcs whose reduced cost turned negative are saturated (or emptied, if used backwards). This leaves
+     * the flow optimal but out of balance at some vertices (including the old endpoints), so Dijkstra over the reduced
+     * costs sends each excess to the nearest shortage (or to s or t), and s and t cover what is still missing. The flow
+     * is then augmented along the cheapest paths like minCostMaxFlow. Leaves no marginal costs behind.
+     * Time Complexity: O((E + V*log(C))*(K + F)), where V is the number of vertices, E is the number of edges, K is the
+     * flow out of balance after the change, F is the flow added afterwards and C is the cost of the most expensive path.
+     * @param s - the index of the source vertex
+     * @param t - the index of the sink vertex
+     * @param ws - the workspace holding a min cost max flow (from minCostMaxFlow or reoptimize) and its potentials
+     * @return true if the flow of ws is now the min cost max flow between s and t, false if an arc of unbounded capacity
+     * would need to be saturated or some vertex can't be balanced, in which case ws needs a cold start (minCostMaxFlow)
+     */
+    bool reoptimize(int s, int t, Workspace &ws) const;
+
+    /**
+     * Finds the cheapest route between two vertices, for a single train: Dijkstra over the enabled arcs with some capacity,
+     * with a bucket queue, ignoring the flow of the workspace. The route is left in ws.path and the cost of every vertex
+     * settled before t in ws.price. With t = -1 the search reaches every vertex, so ws.price holds the cheapest cost from s
+     * to each of them.
+     * Time Complexity: O(E + V*log(C)), where V is the number of vertices, E is the number of edges and C is the cost of the
+     * most expensive route.
+     * @param s - the index of the source vertex
+     * @param t - the index of the destination vertex, or -1 for all of them
+     * @param ws - the workspace used by the search
+     * @return the cost of the cheapest route from s to t (infinity if t can't be reached, 0 if t is -1)
+     */
+    Cost cheapestRoute(int s, int t, Workspace &ws) const;
+
+    /**
+     * Gets the route to a vertex found by the last cheapestRoute over a workspace.
+     * Time Complexity: O(L), where L is the number of arcs of the route.
+     * @param t - the index of the destination vertex
+     * @param ws - the workspace used by cheapestRoute
+     * @return the arcs of the route, from its source to t (empty if t wasn't reached)
+     */
+    vector<int> getRoute(int t, const Workspace &ws) const;
+
+    /**
+     * Calculates the max flow between two vertices, with its min cut.
+     * Time Complexity: O(V*E²), where V is the number of vertices and E is the number of edges.
+     * @param s - the index of the source vertex
+     * @param t - the index of the sink vertex
+     * @param scenario - changes to the network for this computation only (none by default)
+     * @return the result of the computation
+     */
+    Result getMaxFlow(int s, int t, const Scenario &scenario = Scenario()) const;
+
+    /**
+     * Calculates the max flow between two vertices that minimizes its cost, with its min cut.
+     * Time Complexity: see minCostMaxFlow.
+     * @param s - the index of the source vertex
+     * @param t - the index of the sink vertex
+     * @param scenario - changes to the network for this computation only (none by default)
+     * @param engine - the engine of the computation (getDefaultMinCostEngine() by default)
+     * @return the result of the computation
+     */
+    Result getMinCostMaxFlow(int s, int t, const Scenario &scenario = Scenario(),
+                             enum minCostEngine engine = getDefaultMinCostEngine()) const;
+
+    /**
+     * Calculates the cheapest flow of a certain value between two vertices, with the cost of each extra unit.
+     * Time Complexity: see minCostFlow.
+     * @param s - the index of the source vertex
+     * @param t - the index of the sink vertex
+     * @param target - the value of the flow
+     * @param scenario - changes to the network for this computation only (none by default)
+     * @return the result of the computation
+     */
+    Result getMinCostFlow(int s, int t, Cap target, const Scenario &scenario = Scenario()) const;
+
+    /**
+     * Collects the result of the last computation over a workspace (maxFlow, minCostMaxFlow, minCostFlow or repairFlow).
+     * Time Complexity: O(V+E), where V is the number of vertices and E is the number of edges.
+     * @param ws - the workspace used by the computation
+     * @return the value, flow and min cut of the computation
+     */
+    Result getResult(const Workspace &ws) const;
+
+    /**
+     * Gets the edges of the original graph that carry flow in a result.
+     * Time Complexity: O(E), where E is the number of edges.
+     * @param result - the result
+     * @return the edges with flow
+     */
+    vector<Edge *> getUsedEdges(const Result &result) const;
+
+    /**
+     * Gets the edges of the original graph in the min cut of a result, i.e. the segments that limit the flow.
+     * Time Complexity: O(C), where C is the number of arcs in the cut.
+     * @param result - the result
+     * @return the edges of the cut (arcs of the super source are left out)
+     */
+    vector<Edge *> getCutEdges(const Result &result) const;
+
+    /**
+     * Calculates the max flow between two vertices when a segment fails, starting from a max flow of the intact network
+     * instead of from zero: the flow of the segment is first rerouted around it, what can't be rerouted is sent back to
+     * the source (and taken from the sink), and the result is augmented again.
+     * Time Complexity: O(V*E*L), where V is the number of vertices, E is the number of edges and L is the flow of the segment.
+     * @param s - the index of the source vertex
+     * @param t - the index of the sink vertex
+     * @param arc - an arc of the failed segment
+     * @param ws - the workspace, holding a max flow between s and t (replaced by the new one)
+     * @return the max flow between s and t without the segment
+     */
+    Cap repairFlow(int s, int t, int arc, Workspace &ws) const;
+
+    /**
+     * Gets the net flow that reaches a vertex in a workspace.
+     * Time Complexity: O(D), where D is the degree of the vertex.
+     * @param t - the index of the vertex
+     * @param ws - the workspace holding the flow
+     * @return the flow entering t minus the flow leaving it
+     */
+    Cap getFlowInto(int t, const Workspace &ws) const;
+
+    /**
+     * Checks if a vertex is on the source side of the min cut found by the last maxFlow over a workspace, i.e. if it is
+     * still reachable from the source in the residual network.
+     * @param v - the index of the vertex
+     * @param ws - the workspace used by maxFlow
+     * @return true if the vertex is on the source side, false otherwise
+     */
+    bool isSourceSide(int v, const Workspace &ws) const;
+
+    /**
+     * Copies a flow computed over this network to the edges of the original graph, so it can be displayed.
+     * Time Complexity: O(E), where E is the number of edges.
+     * @param flow - the flow of each arc (empty clears the flow of every edge)
+     */
+    void applyFlow(const vector<Cap> &flow) const;
+
+    friend class MemoryFootprint; /**< Measures the memory used by the network */
+
+protected:
+    static const int ALPHA = 16; /**< Factor by which epsilon shrinks between the refines of COST_SCALING */
+
+    vector<Vertex *> vertices; /**< Vertices of the original graph, sorted by id */
+    unordered_map<const Vertex *, int> index; /**< Index of each vertex of the original graph */
+    vector<int> component; /**< Connected component of each vertex */
+    int superSource = -1; /**< Index of the super source (-1 if none) */
+
+    vector<int> outStart; /**< Start of the outgoing arcs of each vertex in outArcs (size V+1) */
+    vector<int> outArcs; /**< Outgoing arcs of every vertex, in adjacency order */
+    vector<int> inStart; /**< Start of the incoming arcs of each vertex in inArcs (size V+1) */
+    vector<int> inArcs; /**< Incoming arcs of every vertex, in adjacency order */
+
+    vector<int> arcOrig; /**< Origin vertex of each arc */
+    vector<int> arcDest; /**< Destination vertex of each arc */
+    vector<Cap> arcCapacity; /**< Capacity of each arc */
+    vector<Cost> arcCost; /**< Cost of each arc */
+    vector<int> arcReverse; /**< Reverse arc of each arc */
+    vector<char> arcDisabled; /**< Disabled state of each arc */
+    vector<Edge *> edges; /**< Edge of the original graph that corresponds to each arc */
+    unordered_map<const Edge *, int> arcIndex; /**< Arc of each edge of the original graph */
+
+    /**
+     * Builds the network over a set of vertices, keeping only the edges between them.
+     * @param stations - the vertices of the network
+     * @param induced - true for a region subgraph (edges are never disabled and components are ignored)
+     * @param scenario - the changes to the graph
+     */
+    void build(const vector<Vertex *> &stations, bool induced, const Scenario &scenario);
+
+    /**
+     * Adds a directed arc that has no edge in the original graph.
+     * @param orig - the index of the origin vertex
+     * @param dest - the index of the destination vertex
+     * @param capacity - the capacity of the arc
+     * @return the index of the arc
+     */
+    int addArc(int orig, int dest, Cap capacity);
+
+    /**
+     * Fills the outgoing and incoming arrays from per-vertex lists of arcs.
+     * @param out - the outgoing arcs of each vertex, in adjacency order
+     * @param in - the incoming arcs of each vertex, in adjacency order
+     */
+    void setAdjacency(const vector<vector<int>> &out, const vector<vector<int>> &in);
+
+    /**
+     * BFS that finds the shortest augmenting path between s and t over the residual network.
+     * Time Complexity: O(V+E), where V is the number of vertices and E is the number of edges.
+     * @param s - the index of the source vertex
+     * @param t - the index of the sink vertex
+     * @param ws - the workspace used by the search
+     * @return true if a path was found, and false otherwise.
+     */
+    bool findPath(int s, int t, Workspace &ws) const;
+
+    /**
+     * BFS that finds the shortest augmenting path between s and t growing two searches, one forward from s and one
+     * backward from t over the residual network, and expanding a whole level of the smaller frontier at a time. The first
+     * vertex reached by both closes a shortest path, whose part on t's side is then copied to ws.path. On long, sparse
+     * geometry both searches meet after visiting far fewer vertices than a search from s alone. When t's side runs out
+     * first, the search from s is finished anyway, so the workspace keeps the min cut of isSourceSide.
+     * Time Complexity: O(V+E), where V is the number of vertices and E is the number of edges.
+     * @param s - the index of the source vertex
+     * @param t - the index of the sink vertex
+     * @param ws - the workspace used by the search
+     * @return true if a path was found, and false otherwise.
+     */
+    bool findPathBidirectional(int s, int t, Workspace &ws) const;
+
+    /**
+     * Visits the residual neighbours of a vertex of the search from the source, recording the arc that reaches each one.
+     * @param v - the index of the vertex
+     * @param t - the index of the sink vertex
+     * @param capacity - the capacity of each arc
+     * @param ws - the workspace used by the search
+     * @return the first neighbour that is t or was reached from t by the current search, or -1 if none
+     */
+    int scanForward(int v, int t, const vector<Cap> &capacity, Workspace &ws) const;
+
+    /**
+     * Visits the vertices with a residual arc into a vertex of the search from the sink, recording the arc that leads each
+     * one towards the sink.
+     * @param w - the index of the vertex
+     * @param capacity - the capacity of each arc
+     * @param ws - the workspace used by the search
+     * @return the first vertex that was reached from the source by the current search, or -1 if none
+     */
+    int scanBackward(int w, const vector<Cap> &capacity, Workspace &ws) const;
+
+    /**
+     * Bellman-Ford that finds the cheapest augmenting path between s and t over the residual network, where going back
+     * through an arc with flow refunds its cost. There are no negative cycles, since every augmentation follows a
+     * cheapest path. Vertices not reached yet (at an infinite price) relax nothing.
+     * Time Complexity: O(V*E), where V is the number of vertices and E is the number of edges.
+     * @param s - the index of the source vertex
+     * @param t - the index of the sink vertex
+     * @param ws - the workspace used by the search
+     * @return true if a path was found, and false otherwise.
+     */
+    bool findCheapestPath(int s, int t, Workspace &ws) const;
+
+    /**
+     * Dijkstra that finds the cheapest augmenting path between s and t over the residual network, with the cost of each
+     * residual arc (v, w) reduced to cost + potential[v] - potential[w]. The potentials start at 0, as no arc is used
+     * backwards yet and the services are positive, and after each search every vertex gains its reduced price, capped at
+     * the one of t. The arcs of the cheapest path then have a reduced cost of 0 both ways, so the reduced costs stay
+     * non-negative and Dijkstra stays exact. Reduced costs are small integers over the railway, so the queue is a bucket
+     * queue instead of a comparison heap, and the search stops once t leaves it.
+     * Time Complexity: O(E + V*log(C)), where V is the number of vertices, E is the number of edges and C is the reduced
+     * cost of the cheapest path.
+     * @param s - the index of the source vertex
+     * @param t - the index of the sink vertex
+     * @param ws - the workspace used by the search
+     * @return true if a path was found, and false otherwise.
+     */
+    bool findCheapestPathBuckets(int s, int t, Workspace &ws) const;
+
+    /**
+     * Relaxes the residual arcs leaving a vertex settled by a Dijkstra search over the reduced costs, queueing the vertices
+     * they reach for less.
+     * Time Complexity: O(D*log(C)), where D is the degree of the vertex and C is the reduced cost of the search.
+     * @param v - the index of the vertex
+     * @param ws - the workspace used by the search
+     */
+    void relaxReducedArcs(int v, Workspace &ws) const;
+
+    /**
+     * Dijkstra over the reduced costs, like findCheapestPathBuckets, that finds the cheapest path from a vertex with more
+     * flow entering it than leaving it (ws.excess above 0) to one short of flow, s or t; once no vertex has excess, from s
+     * or t to a vertex short of flow. Updates the potentials the same way.
+     * Time Complexity: O(E + V*log(C)), where V is the number of vertices, E is the number of edges and C is the reduced
+     * cost of the path.
+     * @param s - the index of the source vertex
+     * @param t - the index of the sink vertex
+     * @param ws - the workspace used by the search
+     * @return the vertex where the path ends, or -1 if no vertex is out of balance or none can be reached
+     */
+    int findBalancingPath(int s, int t, Workspace &ws) const;
+
+    /**
+     * Augments along the cheapest path, found with the engine of the workspace, until the flow reaches a target or no path
+     * is left, recording the flow sent at each cost per unit in ws.marginalCosts. The last path only sends what the target
+     * still needs.
+     * Time Complexity: see minCostFlow.
+     * @param s - the index of the source vertex
+     * @param t - the index of the sink vertex
+     * @param target - the most flow to send
+     * @param ws - the workspace used by the computation, with the potentials at 0
+     * @return the value of the flow
+     */
+    Cap successiveCheapestPaths(int s, int t, Cap target, Workspace &ws) const;
+
+    /**
+     * Calculates the cost of one unit of flow along the path to t found by the last search: the services of the arcs used
+     * forwards minus the ones of the arcs used backwards, whose flow is refunded.
+     * Time Complexity: O(L), where L is the number of arcs of the path.
+     * @param t - the index of the sink vertex
+     * @param ws - the workspace holding the path
+     * @return the cost per unit of the path
+     */
+    Cost getPathCost(int t, const Workspace &ws) const;
+
+    /**
+     * Turns the max flow of a workspace into a min cost one with Goldberg's cost-scaling push-relabel. Costs are scaled by
+     * V+1, so a flow whose residual arcs all have a reduced cost of at least -1 is optimal, and epsilon, the most negative
+     * reduced cost allowed, starts at the highest scaled cost (every flow meets it with prices of 0) and is divided by
+     * ALPHA before each refine until it reaches 1. Each arc of a segment is its own arc during the refines: no optimal
+     * flow uses both arcs of a segment, as moving a unit back and forth costs twice the service, so the result still fits
+     * the capacity of the segment. Every arc is bounded by the value of the flow, which no arc of a min cost flow
+     * exceeds (it has no cycles, as every service costs something), so unbounded arcs never move more than that.
+     * Time Complexity: O(V²*E*log(V*C)), where V is the number of vertices, E is the number of edges and C is the highest
+     * cost of an arc.
+     * @param ws - the workspace, holding a max flow (replaced by a min cost one of the same value)
+     */
+    void costScaling(Workspace &ws) const;
+
+    /**
+     * Turns an epsilon-optimal flow into an epsilon-optimal one for a smaller epsilon: every residual arc with a negative
+     * reduced cost is saturated, and the excess this leaves on some vertices is then pushed through admissible arcs
+     * (negative reduced cost), first in first out, relabeling a vertex (lowering its price until some arc is admissible)
+     * when it has none. Global price updates, a bucket search back from the vertices left short, reset every price at the
+     * start and then after about V relabels, which spares most of the relabels of long detours.
+     * Time Complexity: O(V²*E), where V is the number of vertices and E is the number of edges.
+     * @param epsilon - the new epsilon, in scaled costs
+     * @param scale - the factor of the costs
+     * @param bound - the most flow any arc needs to carry
+     * @param ws - the workspace holding the flow and the prices
+     */
+    void refine(long long epsilon, long long scale, Cap bound, Workspace &ws) const;
+
+    /**
+     * Gets the capacities used by the solves over a workspace: the ones of its scenario, if it changes any.
+     * @param ws - the workspace
+     * @return the capacity of each arc
+     */
+    const vector<Cap> &getCapacities(const Workspace &ws) const;
+
+    /**
+     * Gets the costs used by the solves over a workspace: the ones of its scenario, if it changes any.
+     * @param ws - the workspace
+     * @return the cost of each arc
+     */
+    const vector<Cost> &getCosts(const Workspace &ws) const;
+
+    /**
+     * Checks if the searches can't use an arc forward: arcs between components, the segment between the super source
+     * and the sink, and the removed segment and failed arcs of the workspace.
+     * @param a - the index of the arc
+     * @param ws - the workspace of the search
+     * @return true if the arc is skipped, false otherwise
+     */
+    bool isSkipped(int a, const Workspace &ws) const;
+
+    /**
+     * Finds the bottleneck of the augmenting path ending in t.
+     * Time Complexity: O(V), where V is the number of vertices.
+     * @param t - the index of the sink vertex
+     * @param ws - the workspace holding the path
+     * @return the bottleneck of the path
+     */
+    Cap findBottleneck(int t, const Workspace &ws) const;
+
+    /**
+     * Augments the flow of all arcs of the path ending in t.
+     * Time Complexity: O(V), where V is the number of vertices.
+     * @param t - the index of the sink vertex
+     * @param flow - the flow to be augmented
+     * @param ws - the workspace holding the path
+     */
+    void augmentFlow(int t, Cap flow, Workspace &ws) const;
+
+    /**
+     * Sends flow between two vertices over the residual network, one shortest path at a time.
+     * Time Complexity: O(V*E*F), where V is the number of vertices, E is the number of edges and F is the amount of flow.
+     * @param from - the index of the vertex the flow leaves
+     * @param to - the index of the vertex the flow reaches
+     * @param amount - the most flow to send
+     * @param ws - the workspace holding the flow
+     * @return the flow that was sent
+     */
+    Cap pushFlow(int from, int to, Cap amount, Workspace &ws) const;
+};
+
+typedef BasicFlowNetwork<int, int> FlowNetwork; /**< 32-bit network, for the railway itself */
+typedef FlowNetwork::Workspace FlowWorkspace; /**< Workspace of the 32-bit network */
+typedef FlowNetwork::Result FlowResult; /**< Result of the 32-bit network */
+
+typedef BasicFlowNetwork<long long, long long> WideFlowNetwork; /**< 64-bit network, for aggregated demand models */
+typedef BasicFlowNetwork<double, double> RealFlowNetwork; /**< Floating point network, for fractional capacities */
+
+#endif //PROJECT_RAILWAY_FLOWNETWORK_H
@@ -0,0 +1,71 @@
+#ifndef PROJECT_RAILWAY_FLOWTRAITS_H
+#define PROJECT_RAILWAY_FLOWTRAITS_H
+
+#include <limits>
+#include <type_traits>
+
+using namespace std;
+
+/**
+ * Arithmetic of the capacities, flows and costs of the flow engines. Integer types compare exactly, and their infinity is
+ * their highest value, which the engines never add to (residual capacities only subtract flows from it, and only the
+ * prices of reached vertices are relaxed). Floating point types compare with a tolerance, so rounding errors never leave
+ * an arc with a tiny residual capacity that the searches would keep augmenting.
+ * The choice is made at compile time, so the integer engines pay nothing for the tolerance.
+ * @tparam T - the type of the values
+ */
+template <class T, bool = is_integral<T>::value>
+struct FlowTraits {
+    static const bool exact = true; /**< True if the comparisons are exact */
+
+    /**
+     * Gets the value of an unbounded capacity, or the price of an unreached vertex.
+     * @return the highest value of T
+     */
+    static constexpr T infinity() {
+        return numeric_limits<T>::max();
+    }
+
+    /**
+     * Compares two values.
+     * @param a - the first value
+     * @param b - the second value
+     * @return true if a is less than b
+     */
+    static constexpr bool isLess(T a, T b) {
+        return a < b;
+    }
+};
+
+template <class T>
+struct FlowTraits<T, false> {
+    static const bool exact = false; /**< True if the comparisons are exact */
+
+    /**
+     * Gets the tolerance of the comparisons, relative to the values of the railway (capacities and services are small).
+     * @return the tolerance
+     */
+    static constexpr T tolerance() {
+        return (T) 1e-9;
+    }
+
+    /**
+     * Gets the value of an unbounded capacity, or the price of an unreached vertex.
+     * @return infinity
+     */
+    static constexpr T infinity() {
+        return numeric_limits<T>::infinity();
+    }
+
+    /**
+     * Compares two values, ignoring differences within the tolerance.
+     * @param a - the first value
+     * @param b - the second value
+     * @return true if a is less than b by more than the tolerance
+     */
+    static constexpr bool isLess(T a, T b) {
+        return a < b - tolerance();
+    }
+};
+
+#endif //PROJECT_RAILWAY_FLOWTRAITS_H
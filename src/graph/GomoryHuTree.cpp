@@ -0,0 +1,55 @@
+#include "GomoryHuTree.h"
+
+GomoryHuTree::GomoryHuTree(const UndirectedFlowNetwork &network, bool bidirectional) {
+    int n = network.getSize();
+    parent.assign(n, 0);
+    parentFlow.assign(n, 0);
+    children.assign(n, vector<int>());
+
+    if (n == 0) return;
+    parent[0] = -1;
+
+    UndirectedFlowWorkspace ws;
+    network.prepare(ws);
+    ws.bidirectional = bidirectional;
+
+    for (int i = 1; i < n; i++) {
+        int p = parent[i];
+        parentFlow[i] = network.maxFlow(i, p, ws);
+
+        // Vertices on i's side of the cut that were hanging from the same parent move under i
+        for (int j = i + 1; j < n; j++) {
+            if (parent[j] == p && network.isSourceSide(j, ws))
+                parent[j] = i;
+        }
+    }
+
+    for (int i = 1; i < n; i++)
+        children[parent[i]].push_back(i);
+}
+
+vector<int> GomoryHuTree::getFlowsFrom(int u) const {
+    vector<int> flows(parent.size(), 0);
+    vector<bool> visited(parent.size(), false);
+    vector<int> stack = {u};
+    visited[u] = true;
+    flows[u] = numeric_limits<int>::max();
+
+    while (!stack.empty()) {
+        int v = stack.back();
+        stack.pop_back();
+
+        auto visit = [&](int w, int flow) {
+            if (visited[w]) return;
+            visited[w] = true;
+            flows[w] = min(flows[v], flow);
+            stack.push_back(w);
+        };
+
+        if (parent[v] != -1) visit(parent[v], parentFlow[v]);
+        for (int c: children[v]) visit(c, parentFlow[c]);
+    }
+
+    flows[u] = 0;
+    return flows;
+}
@@ -0,0 +1,38 @@
+#ifndef PROJECT_RAILWAY_GOMORYHUTREE_H
+#define PROJECT_RAILWAY_GOMORYHUTREE_H
+
+#include <vector>
+#include "UndirectedFlowNetwork.h"
+
+using namespace std;
+
+/**
+ * Flow equivalent tree of an undirected network, built with Gusfield's version of the Gomory-Hu algorithm.
+ * The max flow between any two vertices is the smallest flow on the tree path between them, so all pairs are answered
+ * with V-1 max flow computations instead of V*(V-1)/2.
+ */
+class GomoryHuTree {
+public:
+    /**
+     * Builds the tree of a network.
+     * Time Complexity: O(V²*S²), where V is the number of vertices and S is the number of segments (V-1 max flows).
+     * @param network - the network
+     * @param bidirectional - true to search the augmenting paths of the max flows from both ends
+     */
+    explicit GomoryHuTree(const UndirectedFlowNetwork &network, bool bidirectional = false);
+
+    /**
+     * Calculates the max flow between a vertex and every vertex of the network.
+     * Time Complexity: O(V), where V is the number of vertices.
+     * @param u - the index of the vertex
+     * @return the max flow between u and each vertex (the entry of u itself is 0)
+     */
+    vector<int> getFlowsFrom(int u) const;
+
+private:
+    vector<int> parent; /**< Neighbour of each vertex in the direction of the root (-1 for the root) */
+    vector<int> parentFlow; /**< Max flow between each vertex and its parent */
+    vector<vector<int>> children; /**< Children of each vertex in the tree */
+};
+
+#endif //PROJECT_RAILWAY_GOMORYHUTREE_H
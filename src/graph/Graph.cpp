@@ -1,8 +1,16 @@
 // By: Gonçalo Leão
 
 #include "Graph.h"
+#include "DirectionOptimizingBfs.h"
+#include "metrics/Metrics.h"
 
 
+Graph::Graph() : stations(new StationTable()) {}
+
+StationTable &Graph::getStationTable() {
+    return *stations;
+}
+
 std::unordered_map<string , Vertex *> Graph::getVertexSet() const {
     return vertexSet;
 }
@@ -27,6 +35,25 @@ void Graph::setRegion(enum region r) {
     this->region = r;
 }
 
+map<string, vector<Vertex *>> Graph::getRegionStations(enum region r) const {
+    map<string, vector<Vertex *>> stations;
+    for (const auto &v: vertexSet)
+        stations[getRegionOf(v.second, r)].push_back(v.second);
+
+    for (auto &pa: stations) {
+        sort(pa.second.begin(), pa.second.end(), [](const Vertex *v1, const Vertex *v2) {
+            return v1->getId() < v2->getId();
+        });
+    }
+
+    return stations;
+}
+
+string Graph::getRegionOf(const Vertex *v, enum region r) {
+    if (r == LINE) return v->getLine();
+    if (r == MUNICIPALITIES) return v->getMunicipality();
+    return v->getDistrict();
+}
 
 /*
  * Auxiliary function to find a vertex with a given content.
@@ -52,282 +79,12 @@ void Graph::insertExtremeDistrict(Vertex *v) {
     extremesDistricts.insert(v);
 }
 
-
-
-int Graph::findBottleneck(Vertex* src) const {
-    int cap = numeric_limits<int>::max();
-    int tmp;
-    auto v = src;
-    auto e = v->getPath();
-
-    while (e != nullptr) {
-        tmp = e->getOrig() == v ? e->getFlow() : e->getCapacity() - e->getFlow() - e->getReverse()->getFlow();
-
-        if (tmp < cap)
-            cap = tmp;
-
-        v = e->getOrig() == v ? e->getDest() : e->getOrig();
-
-        e = v->getPath();
-    }
-
-    return cap;
-}
-
-void Graph::augmentFlow(Vertex* dest, int flow) const {
-    auto v = dest;
-    auto e = v->getPath();
-
-    while (e != nullptr) {
-        e->getOrig() == v ? e->setFlow(e->getFlow() - flow) : e->setFlow(e->getFlow() + flow);
-
-        v = e->getOrig() == v ? e->getDest() : e->getOrig();
-
-        e = v->getPath();
-    }
-}
-
-bool Graph::findPath(Vertex* origin , Vertex* dest) const {
-    resetNodes();
-
-    queue<Vertex*> q;
-    origin->setVisited(true);
-    q.push(origin);
-
-    while (!q.empty()) {
-        auto v = q.front();
-        q.pop();
-
-        for (auto e : v->getAdj()) {
-            auto w = e->getDest();
-
-            if (v->getComponent() != 0 && w->getComponent() != v->getComponent())
-                continue;
-
-            bool isNotFull = e->getCapacity() > e->getFlow() + e->getReverse()->getFlow();
-
-            if (!w->isVisited() && isNotFull && !e->getDisabled()) {
-                if (w == dest) {
-                    w->setPath(e);
-                    return true;
-                }
-
-                w->setVisited(true);
-                w->setPath(e);
-                q.push(w);
-            }
-        }
-
-        for (auto e : v->getIncoming()) {
-            auto w = e->getOrig();
-            if (!w->isVisited() && e->getFlow() > 0 && !e->getDisabled()) {
-                w->setVisited(true);
-                w->setPath(e);
-                q.push(w);
-            }
-        }
-    }
-
-    return false;
-}
-
-
-bool Graph::findDistrictPath(Vertex* origin , Vertex* dest ) const {
-    resetNodes();
-
-    queue<Vertex*> q;
-    origin->setVisited(true);
-    q.push(origin);
-
-    while (!q.empty()) {
-        auto v = q.front();
-        q.pop();
-
-        for (auto e : v->getAdj()) {
-            auto w = e->getDest();
-            if(w->getDistrict() != v->getDistrict()){
-                continue;
-            }
-            if (!w->isVisited() && e->getCapacity() > e->getFlow() + e->getReverse()->getFlow()) {
-                if (w == dest) {
-                    w->setPath(e);
-                    return true;
-                }
-
-                w->setVisited(true);
-                w->setPath(e);
-                q.push(w);
-            }
-        }
-
-        for (auto e : v->getIncoming()) {
-            auto w = e->getOrig();
-            if(w->getDistrict() != v->getDistrict()){
-                continue;
-            }
-            if (!w->isVisited() && e->getFlow() > 0) {
-                w->setVisited(true);
-                w->setPath(e);
-                q.push(w);
-            }
-        }
-    }
-
-    return false;
-}
-
-
-bool Graph::findMunPath(Vertex* origin , Vertex* dest ) const {
-    resetNodes();
-
-    queue<Vertex*> q;
-    origin->setVisited(true);
-    q.push(origin);
-
-    while (!q.empty()) {
-        auto v = q.front();
-        q.pop();
-
-        for (auto e : v->getAdj()) {
-            auto w = e->getDest();
-            if(w->getMunicipality() != v->getMunicipality()){
-                continue;
-            }
-            if (!w->isVisited() && e->getCapacity() > e->getFlow() + e->getReverse()->getFlow()) {
-                if (w == dest) {
-                    w->setPath(e);
-                    return true;
-                }
-
-                w->setVisited(true);
-                w->setPath(e);
-                q.push(w);
-            }
-        }
-
-        for (auto e : v->getIncoming()) {
-            auto w = e->getOrig();
-
-            if(w->getMunicipality() != v->getMunicipality()){
-                continue;
-            }
-            if (!w->isVisited() && e->getFlow() > 0) {
-                w->setVisited(true);
-                w->setPath(e);
-                q.push(w);
-            }
-        }
-    }
-
-    return false;
-}
-
-void Graph::districtMaxFlow(const string &origin, const string &dest) const {
-    resetNodes();
-    resetFlow();
-
-    auto s = findVertex(origin);
-    auto t = findVertex(dest);
-
-    while (findDistrictPath(s, t)){
-        int flow = findBottleneck(t);
-        augmentFlow(t, flow);
-    }
-}
-
-void Graph::munMaxFlow(const string &origin, const string &dest) const {
-    resetNodes();
-    resetFlow();
-
-    auto s = findVertex(origin);
-    auto t = findVertex(dest);
-
-    while (findMunPath(s, t)){
-        int flow = findBottleneck(t);
-        augmentFlow(t, flow);
-    }
-}
-
-void Graph::maxFlow(const string &origin, const string &dest) const {
-    resetNodes();
-    resetFlow();
-
-    auto s = findVertex(origin);
-    auto t = findVertex(dest);
-
-    while (findPath(s, t)){
-        int flow = findBottleneck(t);
-        augmentFlow(t, flow);
-    }
-}
-
-
-void Graph::minCostMaxFlow(Vertex *origin, Vertex *dest) const {
-    resetNodes();
-    resetFlow();
-
-    while (findCheapestPath(origin, dest)){
-        int flow = findBottleneck(dest);
-        augmentFlow(dest, flow);
-    }
-}
-
-// No need to check for negative cycles in the Bellman-Ford
-bool Graph::findCheapestPath(Vertex *origin, Vertex *dest) const {
-    resetNodes();
-    bool relaxedAnEdge;
-
-    origin->setPrice(0);
-
-    for (int i = 0; i < getVertexSet().size(); i++) {
-        relaxedAnEdge = false;
-
-        for (const auto& v: getVertexSet()) {
-            Vertex *orig = v.second;
-
-            for (Edge *e: orig->getAdj()) {
-                Vertex *adjNode = e->getDest();
-                Edge *reverse = e->getReverse();
-
-                if (orig->getComponent() != 0 && adjNode->getComponent() != orig->getComponent())
-                    continue;
-
-                bool relaxEdge = adjNode->getPrice() > orig->getPrice() + e->getService();
-                bool isNotFull = e->getCapacity() > e->getFlow() + reverse->getFlow();
-
-                if (relaxEdge && isNotFull) {
-                    adjNode->setPrice(orig->getPrice() + e->getService());
-                    adjNode->setPath(e);
-                    relaxedAnEdge = true;
-                }
-            }
-
-            for (Edge *e: orig->getIncoming()) {
-                Vertex *adjNode = e->getOrig();
-
-                bool relaxEdge = adjNode->getPrice() > orig->getPrice() - e->getService();
-
-                if (e->getFlow() > 0 && relaxEdge) {
-                    adjNode->setPrice(orig->getPrice() - e->getService());
-                    adjNode->setPath(e);
-                    relaxedAnEdge = true;
-                }
-            }
-        }
-
-        if (!relaxedAnEdge)
-            break;
-    }
-
-    return dest->getPath() != nullptr;
-}
-
 bool Graph::addVertex(const string &id) {
     if (findVertex(id) != nullptr)
         return false;
     string lowerid = id;
     transform(lowerid.begin(), lowerid.end(), lowerid.begin(), ::tolower);
-    vertexSet.insert({lowerid, new Vertex(id)});
+    vertexSet.insert({lowerid, new Vertex(*stations, id)});
     return true;
 }
 
@@ -343,12 +100,7 @@ bool Graph::addVertex(Vertex *v) {
 
 bool Graph::removeVertex(const std::string &id) {
     if (findVertex(id) == nullptr) return false;
-    auto v = findVertex(id);
-    v->removeOutgoingEdges();
-    auto lowerId = v->getId();
-    transform(lowerId.begin(), lowerId.end(), lowerId.begin(), ::tolower);
-    vertexSet.erase(lowerId);
-    return true;
+    return removeVertex(findVertex(id));
 }
 
 bool Graph::removeVertex(Vertex *v) {
@@ -357,6 +109,9 @@ bool Graph::removeVertex(Vertex *v) {
     auto lowerId = v->getId();
     transform(lowerId.begin(), lowerId.end(), lowerId.begin(), ::tolower);
     vertexSet.erase(lowerId);
+    // A vertex built in the table of another graph keeps its attributes there
+    if (&v->getStationTable() == stations.get())
+        stations->remove(v->getStation());
     return true;
 }
 
@@ -374,175 +129,17 @@ bool Graph::addBidirectionalEdge(const string &sourc, const string &dest, double
     return true;
 }
 
-void Graph::resetFlow() const {
-    for (const auto& v: getVertexSet()) {
-        for (auto e: v.second->getAdj()) {
-            e->setFlow(0);
-        }
-        for (auto e: v.second->getIncoming()) {
-            e->setFlow(0);
-        }
-    }
-}
-
-void Graph::resetNodes() const {
-    for (auto v: getVertexSet()) {
-        v.second->setVisited(false);
-        v.second->setPath(nullptr);
-        v.second->setPrice(100000); // Can't be the maximum value of an integer as it would overflow when using the Bellman-Ford algorithm
-        v.second->setInQueue(false);
-
-        for (Edge *e: v.second->getAdj()) {
-            e->setVisited(false);
-        }
-    }
-}
-
-int Graph::getMaxFlow(Vertex *v1, Vertex *v2) {
-    maxFlow(v1->getId(), v2->getId());
-    int flow = 0;
-    for (auto e: v2->getIncoming()) flow += e->getFlow();
-    return flow;
-}
-
-int Graph::getMunMaxFlow(Vertex *v1, Vertex *v2) {
-    munMaxFlow(v1->getId(), v2->getId());
-    int flow = 0;
-    for (auto e: v2->getIncoming()) flow += e->getFlow();
-    return flow;
-}
-
-int Graph::getDistrictMaxFlow(Vertex *v1, Vertex *v2) {
-    districtMaxFlow(v1->getId(), v2->getId());
-    int flow = 0;
-    for (auto e: v2->getIncoming()) flow += e->getFlow();
-    return flow;
-}
-
 Graph::~Graph() {
 }
 
-int Graph::computeCost(Vertex *origin) const {
-    int totalCost = 0;
-    queue<Vertex *> q;
-    resetNodes();
-
-    origin->setVisited(true);
-    q.push(origin);
-    Vertex *currNode;
-
-    while (!q.empty()) {
-        currNode = q.front();
-
-        for (Edge *e: currNode->getAdj()) {
-            Vertex *destNode = e->getDest();
-
-            if (e->getFlow() > 0 && !e->getVisited()) {
-                if (!destNode->isVisited()) {
-                    q.push(destNode);
-                    destNode->setVisited(true);
-                }
-                totalCost += e->getFlow() * e->getService();
-                e->setVisited(true);
-            }
-        }
-
-        q.pop();
-    }
-
-    return totalCost;
-}
-
-vector<Edge *> Graph::fetchUsedEdges(vector<Vertex *> result_vector) {
-    vector<Edge *> allEdges;
-
-    queue<Vertex *> q;
-    for (auto e : result_vector) {
-        q.push(e);
-    }
-    auto origin = q.front();
-    resetNodes();
-
-    origin->setVisited(true);
-    q.push(origin);
-    Vertex *currNode;
-
-    while (!q.empty()) {
-        currNode = q.front();
-
-        for (Edge *e: currNode->getAdj()) {
-            Vertex *destNode = e->getDest();
-
-            if (e->getFlow() > 0 && !e->getVisited()) {
-                if (!destNode->isVisited()) {
-                    q.push(destNode);
-                    destNode->setVisited(true);
-                }
-                allEdges.push_back(e);
-                e->setVisited(true);
-            }
-        }
-
-        q.pop();
-    }
-
-    return allEdges;
-}
-
-int Graph::getVertexFlow(Vertex *v) const {
-    int totalFlow = 0;
-    for (Edge *e: v->getIncoming()) {
-        totalFlow += e->getFlow();
-    }
-
-    return totalFlow;
-}
-
-Vertex *Graph::addSuperSource(Vertex* dest) {
-    string superNode = "Super Node";
-
-    addVertex(superNode);
-
-    for (auto e: extremes){
-        if (e != dest) addBidirectionalEdge(superNode, e->getId(), 9999, STANDARD);
-    }
-
-    findVertex(superNode)->setComponent(0);
-
-    return findVertex(superNode);
-}
-
-void Graph::removeSuperSource(Vertex* superSource) {
-    for (Vertex *extreme: extremes) {
-        extreme->removeEdge(superSource->getId());
-    }
-
-    removeVertex(superSource->getId());
-}
-
-void Graph::connectedComponentsDfs(Vertex *src, int i) {
-    src->setVisited(true);
-    src->setComponent(i);
-
-    for (Edge *e: src->getAdj()) {
-        Vertex *dest = e->getDest();
-
-        if (!dest->isVisited()) {
-            connectedComponentsDfs(dest, i);
-        }
-    }
-}
-
 void Graph::setConnectedComponents() {
-    resetNodes();
-    int i = 1;
+    DirectionOptimizingBfs bfs(*this);
 
-    for (const auto& v: vertexSet) {
-        Vertex *vertex = v.second;
+    vector<int> seeds;
+    for (const auto& v: vertexSet)
+        seeds.push_back(bfs.indexOf(v.second));
 
-        if (!vertex->isVisited()) {
-            connectedComponentsDfs(vertex, i);
-            i++;
-        }
-    }
+    vector<int> component = bfs.labelComponents(seeds);
+    for (int v = 0; v < bfs.getSize(); v++)
+        bfs.getVertex(v)->setComponent(component[v]);
 }
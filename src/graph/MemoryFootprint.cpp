@@ -0,0 +1,159 @@
+#include "MemoryFootprint.h"
+#include <iomanip>
+
+size_t Footprint::getStationTotal() const {
+    size_t total = 0;
+    for (size_t bytes: stationBytes) total += bytes;
+    return total;
+}
+
+size_t Footprint::getArcTotal() const {
+    size_t total = 0;
+    for (size_t bytes: arcBytes) total += bytes;
+    return total;
+}
+
+size_t MemoryFootprint::heapBytes(const string &s) {
+    const char *data = s.data();
+    const char *object = reinterpret_cast<const char *>(&s);
+    bool inline_ = data >= object && data < object + sizeof(string);
+    return inline_ ? 0 : s.capacity() + 1;
+}
+
+Footprint MemoryFootprint::measure(const Graph &gh) {
+    Footprint footprint;
+    auto &station = footprint.stationBytes;
+    auto &arc = footprint.arcBytes;
+
+    // The graph itself: lookup by name, extreme sets and region maps
+    station[INDEX_BYTES] += sizeof(Graph) + tableBytes(gh.vertexSet, true);
+    for (auto &pa: gh.vertexSet)
+        station[STRING_BYTES] += heapBytes(pa.first);
+    for (auto *set: {&gh.extremes, &gh.extremesMunicipalities, &gh.extremesDistricts})
+        station[INDEX_BYTES] += tableBytes(*set, false);
+    station[INDEX_BYTES] += heapBytes(gh.region_map);
+    for (auto &map: gh.region_map) {
+        station[INDEX_BYTES] += tableBytes(map, true);
+        for (auto &pa: map)
+            station[INDEX_BYTES] += heapBytes(pa.first) + heapBytes(pa.second);
+    }
+
+    // The station table of the graph: hot region ids and components, and the slots of the cold attributes
+    const StationTable &table = *gh.stations;
+    station[TOPOLOGY_BYTES] += sizeof(StationTable) + heapBytes(table.components);
+    station[STRING_BYTES] += heapBytes(table.attributes);
+    for (int r = 0; r < 3; r++) {
+        station[INDEX_BYTES] += heapBytes(table.regionIds[r]) + tableBytes(table.regionIdOf[r], true);
+        for (auto &pa: table.regionIdOf[r])
+            station[INDEX_BYTES] += heapBytes(pa.first);
+    }
+
+    // The cold strings and townships of the stations of the graph, wherever their table is
+    for (auto &pa: gh.vertexSet) {
+        const StationAttributes &attributes = pa.second->getStationTable().getAttributes(pa.second->getStation());
+        for (const string *s: {&attributes.name, &attributes.district, &attributes.municipality, &attributes.line})
+            station[STRING_BYTES] += heapBytes(*s);
+        // Each list node holds two links and the string
+        for (const string &township: attributes.townships)
+            station[METADATA_BYTES] += 2 * sizeof(void *) + sizeof(string) + heapBytes(township);
+    }
+
+    size_t vertexTopology = sizeof(Vertex::table) + sizeof(Vertex::station) + sizeof(Vertex::adj) +
+                            sizeof(Vertex::incoming);
+    size_t edgeTopology = sizeof(Edge::orig) + sizeof(Edge::dest) + sizeof(Edge::reverse) + sizeof(Edge::capacity) +
+                          sizeof(Edge::service);
+
+    for (auto &pa: gh.vertexSet) {
+        const Vertex *v = pa.second;
+        footprint.stations++;
+
+        station[TOPOLOGY_BYTES] += vertexTopology;
+        station[SCRATCH_BYTES] += sizeof(Vertex) - vertexTopology;
+        arc[TOPOLOGY_BYTES] += heapBytes(v->adj) + heapBytes(v->incoming);
+
+        footprint.arcs += v->adj.size();
+        arc[TOPOLOGY_BYTES] += v->adj.size() * edgeTopology;
+        arc[SCRATCH_BYTES] += v->adj.size() * (sizeof(Edge) - edgeTopology);
+    }
+
+    return footprint;
+}
+
+Footprint MemoryFootprint::measure(const FlowNetwork &network) {
+    Footprint footprint;
+    auto &station = footprint.stationBytes;
+    auto &arc = footprint.arcBytes;
+    footprint.stations = network.vertices.size();
+    footprint.arcs = network.edges.size();
+
+    station[TOPOLOGY_BYTES] += sizeof(FlowNetwork) + heapBytes(network.outStart) + heapBytes(network.inStart) +
+                               heapBytes(network.component);
+    station[INDEX_BYTES] += heapBytes(network.vertices) + tableBytes(network.index, false);
+
+    arc[TOPOLOGY_BYTES] += heapBytes(network.outArcs) + heapBytes(network.inArcs) + heapBytes(network.arcOrig) +
+                           heapBytes(network.arcDest) + heapBytes(network.arcCapacity) + heapBytes(network.arcCost) +
+                           heapBytes(network.arcReverse) + heapBytes(network.arcDisabled);
+    arc[INDEX_BYTES] += heapBytes(network.edges) + tableBytes(network.arcIndex, false);
+
+    // A solve needs one workspace per thread
+    FlowWorkspace ws;
+    network.prepare(ws);
+    station[SCRATCH_BYTES] += sizeof(FlowWorkspace) + heapBytes(ws.path) + heapBytes(ws.visited) + heapBytes(ws.queue) +
+                              heapBytes(ws.price) + heapBytes(ws.potential) + ws.buckets.getHeapBytes() +
+                              heapBytes(ws.excess) + heapBytes(ws.scaledPrice) + heapBytes(ws.current) +
+                              heapBytes(ws.marginalCosts);
+    arc[SCRATCH_BYTES] += heapBytes(ws.flow) + heapBytes(ws.failed) + heapBytes(ws.capacity) + heapBytes(ws.cost);
+
+    return footprint;
+}
+
+Footprint MemoryFootprint::measure(const UndirectedFlowNetwork &network) {
+    Footprint footprint;
+    auto &station = footprint.stationBytes;
+    auto &arc = footprint.arcBytes;
+    footprint.stations = network.vertices.size();
+    footprint.arcs = network.ends.size();
+
+    station[TOPOLOGY_BYTES] += sizeof(UndirectedFlowNetwork) + heapBytes(network.start) + heapBytes(network.component);
+    station[INDEX_BYTES] += heapBytes(network.vertices) + tableBytes(network.index, false);
+
+    arc[TOPOLOGY_BYTES] += heapBytes(network.halves) + heapBytes(network.ends) + heapBytes(network.capacity);
+    arc[INDEX_BYTES] += heapBytes(network.edges);
+
+    UndirectedFlowWorkspace ws;
+    network.prepare(ws);
+    station[SCRATCH_BYTES] += sizeof(UndirectedFlowWorkspace) + heapBytes(ws.path) + heapBytes(ws.visited) +
+                              heapBytes(ws.queue);
+    arc[SCRATCH_BYTES] += heapBytes(ws.flow);
+
+    return footprint;
+}
+
+void MemoryFootprint::print(ostream &out, const string &title, const Footprint &footprint) {
+    static const char *categoryNames[FOOTPRINT_CATEGORY_COUNT] = {"Topology", "Strings", "Metadata", "Scratch state",
+                                                                  "Caches and indexes"};
+
+    ios state(nullptr);
+    state.copyfmt(out);
+    double stations = footprint.stations == 0 ? 1 : footprint.stations;
+    double arcs = footprint.arcs == 0 ? 1 : footprint.arcs;
+
+    out << title << " (" << footprint.stations << " stations, " << footprint.arcs << " directed arcs)" << endl;
+    out << left << setw(20) << "Structure" << right << setw(14) << "Station bytes" << setw(12) << "Arc bytes"
+        << setw(14) << "Per station" << setw(10) << "Per arc" << endl;
+
+    out << fixed << setprecision(1);
+    for (int c = 0; c < FOOTPRINT_CATEGORY_COUNT; c++) {
+        out << left << setw(20) << categoryNames[c] << right << setw(14) << footprint.stationBytes[c] << setw(12)
+            << footprint.arcBytes[c] << setw(14) << footprint.stationBytes[c] / stations << setw(10)
+            << footprint.arcBytes[c] / arcs << endl;
+    }
+
+    double perStation = footprint.getStationTotal() / stations, perArc = footprint.getArcTotal() / arcs;
+    out << left << setw(20) << "Total" << right << setw(14) << footprint.getStationTotal() << setw(12)
+        << footprint.getArcTotal() << setw(14) << perStation << setw(10) << perArc << endl;
+    out << "Compact layout target: " << STATION_TARGET << " B per station (" << (perStation < STATION_TARGET ? "met" : "missed")
+        << "), " << ARC_TARGET << " B per arc (" << (perArc < ARC_TARGET ? "met" : "missed") << ")" << endl;
+
+    out.copyfmt(state);
+}
@@ -0,0 +1,129 @@
+#ifndef PROJECT_RAILWAY_MEMORYFOOTPRINT_H
+#define PROJECT_RAILWAY_MEMORYFOOTPRINT_H
+
+#include <array>
+#include <list>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include "Graph.h"
+#include "FlowNetwork.h"
+#include "UndirectedFlowNetwork.h"
+
+using namespace std;
+
+/**
+ * Kinds of data the memory of the network model is spent on.
+ */
+enum FootprintCategory {
+    TOPOLOGY_BYTES, /**< Adjacency, segment endpoints, capacities and services */
+    STRING_BYTES, /**< Station names, districts, municipalities and lines */
+    METADATA_BYTES, /**< Township lists */
+    SCRATCH_BYTES, /**< Per-algorithm state: visited flags, prices, flows, paths */
+    INDEX_BYTES, /**< Lookups by name or pointer, extreme sets and region maps */
+    FOOTPRINT_CATEGORY_COUNT
+};
+
+/**
+ * Bytes of each category, split between the ones that grow with the stations and the ones that grow with the arcs.
+ */
+struct Footprint {
+    array<size_t, FOOTPRINT_CATEGORY_COUNT> stationBytes{}; /**< Bytes owned by the stations */
+    array<size_t, FOOTPRINT_CATEGORY_COUNT> arcBytes{}; /**< Bytes owned by the directed arcs */
+    size_t stations = 0; /**< Number of stations */
+    size_t arcs = 0; /**< Number of directed arcs */
+
+    /**
+     * Gets the bytes owned by the stations, over every category.
+     * @return the number of bytes
+     */
+    size_t getStationTotal() const;
+
+    /**
+     * Gets the bytes owned by the arcs, over every category.
+     * @return the number of bytes
+     */
+    size_t getArcTotal() const;
+};
+
+/**
+ * Estimates the memory held by the network model, by structure. Sizes are what the structures ask the allocator for
+ * under the libstdc++ layouts (short strings kept inline, hash nodes with a next pointer and, for string keys, a cached
+ * hash), without the allocator's own overhead.
+ */
+class MemoryFootprint {
+public:
+    static const size_t STATION_TARGET = 64; /**< Bytes per station of the compact layout */
+    static const size_t ARC_TARGET = 16; /**< Bytes per directed arc of the compact layout */
+
+    /**
+     * Measures the graph: its stations, segments and the indexes kept by the graph, with its station table and the
+     * attributes of its own vertices.
+     * Time Complexity: O(V+E+T), where V is the number of vertices, E is the number of edges and T is the number of
+     * townships.
+     * @param gh - the graph
+     * @return the footprint of the graph
+     */
+    static Footprint measure(const Graph &gh);
+
+    /**
+     * Measures the CSR snapshot of a network, with the scratch state of one workspace.
+     * Time Complexity: O(1)
+     * @param network - the network
+     * @return the footprint of the network
+     */
+    static Footprint measure(const FlowNetwork &network);
+
+    /**
+     * Measures the CSR snapshot of an undirected network, with the scratch state of one workspace. Each half of a
+     * segment counts as a directed arc, so the bytes per arc compare with the ones of a FlowNetwork.
+     * Time Complexity: O(1)
+     * @param network - the network
+     * @return the footprint of the network
+     */
+    static Footprint measure(const UndirectedFlowNetwork &network);
+
+    /**
+     * Writes a footprint as a table, with the bytes per station and per arc against the compact layout targets.
+     * @param out - the stream to write to
+     * @param title - the title of the table
+     * @param footprint - the footprint
+     */
+    static void print(ostream &out, const string &title, const Footprint &footprint);
+
+private:
+    /**
+     * Gets the bytes a string keeps outside of itself.
+     * @param s - the string
+     * @return 0 for short strings kept inline, the capacity plus the terminator otherwise
+     */
+    static size_t heapBytes(const string &s);
+
+    /**
+     * Gets the bytes a vector keeps outside of itself.
+     * @tparam T - the type of the elements
+     * @param v - the vector
+     * @return the bytes of its capacity
+     */
+    template <class T>
+    static size_t heapBytes(const vector<T> &v) {
+        return v.capacity() * sizeof(T);
+    }
+
+    /**
+     * Gets the bytes a hash table keeps outside of itself, not counting what its keys and values hold.
+     * @tparam Table - the type of the table
+     * @param table - the table
+     * @param cachesHash - true if the nodes keep the hash of their key
+     * @return the bytes of the buckets and nodes
+     */
+    template <class Table>
+    static size_t tableBytes(const Table &table, bool cachesHash) {
+        size_t node = sizeof(void *) + sizeof(typename Table::value_type) + (cachesHash ? sizeof(size_t) : 0);
+        return table.bucket_count() * sizeof(void *) + table.size() * node;
+    }
+};
+
+#endif //PROJECT_RAILWAY_MEMORYFOOTPRINT_H
@@ -0,0 +1,48 @@
+#include "MinCostSession.h"
+
+MinCostSession::MinCostSession(const FlowNetwork &network) : network(network) {
+    network.prepare(ws);
+    ws.engine = BUCKET_DIJKSTRA;
+}
+
+int MinCostSession::solve(int s, int t) {
+    warm = solved && s == source && t == sink && network.reoptimize(s, t, ws);
+    if (warm) {
+        warmSolves++;
+        return network.getFlowInto(t, ws);
+    }
+
+    // The flow of a failed re-optimization is only partly moved, so it starts over
+    coldSolves++;
+    solved = true;
+    source = s;
+    sink = t;
+    return network.minCostMaxFlow(s, t, ws);
+}
+
+int MinCostSession::solve(int s, int t, const Scenario &scenario) {
+    network.applyScenario(ws, scenario);
+    return solve(s, t);
+}
+
+FlowResult MinCostSession::getResult() const {
+    return network.getResult(ws);
+}
+
+bool MinCostSession::isWarm() const {
+    return warm;
+}
+
+int MinCostSession::getWarmSolves() const {
+    return warmSolves;
+}
+
+int MinCostSession::getColdSolves() const {
+    return coldSolves;
+}
+
+void MinCostSession::reset() {
+    network.prepare(ws);
+    solved = false;
+    warm = false;
+}
@@ -0,0 +1,85 @@
+#ifndef PROJECT_RAILWAY_MINCOSTSESSION_H
+#define PROJECT_RAILWAY_MINCOSTSESSION_H
+
+#include "FlowNetwork.h"
+#include "Scenario.h"
+
+/**
+ * Min cost max flows over a network for queries that change little from one to the next, as a planner changes the
+ * capacities or costs of some segments between two stations. The session keeps the workspace of its last solve, with the
+ * optimal flow and the potentials of the vertices, and re-optimizes it for the next query (see FlowNetwork::reoptimize),
+ * so only the flow the change affects moves. It starts cold on its first query, after reset, when the last flow can't
+ * be re-optimized, and when the source or the sink change: then the whole flow is out of balance, and moving it costs
+ * as many searches as a cold solve, plus the repair.
+ * The network must outlive the session.
+ */
+class MinCostSession {
+public:
+    /**
+     * Creates a session over a network, with no solve yet.
+     * @param network - the network
+     */
+    explicit MinCostSession(const FlowNetwork &network);
+
+    /**
+     * Calculates the min cost max flow between two vertices, under the scenario of the last query, re-optimizing the last
+     * solve if it was between the same vertices.
+     * Time Complexity: see FlowNetwork::reoptimize, or FlowNetwork::minCostMaxFlow when it starts cold.
+     * @param s - the index of the source vertex
+     * @param t - the index of the sink vertex
+     * @return the max flow between s and t
+     */
+    int solve(int s, int t);
+
+    /**
+     * Calculates the min cost max flow between two vertices under a scenario, which replaces the one of the last query.
+     * Time Complexity: see FlowNetwork::reoptimize, or FlowNetwork::minCostMaxFlow when it starts cold.
+     * @param s - the index of the source vertex
+     * @param t - the index of the sink vertex
+     * @param scenario - the changes to the network
+     * @return the max flow between s and t
+     */
+    int solve(int s, int t, const Scenario &scenario);
+
+    /**
+     * Collects the result of the last solve.
+     * Time Complexity: O(V+E), where V is the number of vertices and E is the number of edges.
+     * @return the value, flow, cost and min cut of the last solve
+     */
+    FlowResult getResult() const;
+
+    /**
+     * Checks if the last solve re-optimized the one before it.
+     * @return true if it did, false if it started cold
+     */
+    bool isWarm() const;
+
+    /**
+     * Gets the number of solves that re-optimized the one before them.
+     * @return the number of warm solves
+     */
+    int getWarmSolves() const;
+
+    /**
+     * Gets the number of solves that started cold.
+     * @return the number of cold solves
+     */
+    int getColdSolves() const;
+
+    /**
+     * Drops the last flow, so the next solve starts cold, under no scenario.
+     */
+    void reset();
+
+private:
+    const FlowNetwork &network; /**< Network of the solves */
+    FlowWorkspace ws; /**< Workspace of the last solve, with its flow, potentials and scenario */
+    bool solved = false; /**< True if ws holds a min cost max flow */
+    int source = -1; /**< Source of the last solve */
+    int sink = -1; /**< Sink of the last solve */
+    bool warm = false; /**< True if the last solve re-optimized the one before it */
+    int warmSolves = 0; /**< Number of solves that re-optimized the one before them */
+    int coldSolves = 0; /**< Number of solves that started cold */
+};
+
+#endif //PROJECT_RAILWAY_MINCOSTSESSION_H
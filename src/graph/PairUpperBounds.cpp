@@ -0,0 +1,150 @@
+#include "PairUpperBounds.h"
+
+PairUpperBounds::PairUpperBounds(const FlowNetwork &network) {
+    int n = network.getSize();
+    incidentCapacity.assign(n, 0);
+
+    for (int v = 0; v < n; v++) {
+        for (int i = 0; i < network.getOutDegree(v); i++) {
+            int a = network.getOutArc(v, i);
+            if (!network.isArcDisabled(a))
+                incidentCapacity[v] += network.getArcCapacity(a);
+        }
+    }
+
+    vector<bool> bridge = findBridges(network);
+
+    // 2-edge-connected blocks: vertices connected without crossing any bridge
+    block.assign(n, -1);
+    vector<vector<int>> blockVertices;
+    for (int v = 0; v < n; v++) {
+        if (block[v] != -1) continue;
+
+        int b = blockVertices.size();
+        blockVertices.emplace_back();
+        block[v] = b;
+        blockVertices[b].push_back(v);
+
+        for (size_t head = 0; head < blockVertices[b].size(); head++) {
+            int u = blockVertices[b][head];
+            for (int i = 0; i < network.getOutDegree(u); i++) {
+                int a = network.getOutArc(u, i);
+                int w = network.getArcDest(a);
+                if (!network.isArcDisabled(a) && !bridge[a] && block[w] == -1) {
+                    block[w] = b;
+                    blockVertices[b].push_back(w);
+                }
+            }
+        }
+    }
+
+    // Bridge tree: blocks connected by the bridges
+    int nBlocks = blockVertices.size();
+    tree.assign(nBlocks, -1);
+    parent.assign(nBlocks, -1);
+    parentCapacity.assign(nBlocks, 0);
+    depth.assign(nBlocks, 0);
+
+    vector<int> q;
+    for (int root = 0; root < nBlocks; root++) {
+        if (tree[root] != -1) continue;
+
+        tree[root] = root;
+        q.assign(1, root);
+
+        for (size_t head = 0; head < q.size(); head++) {
+            int b = q[head];
+            for (int u: blockVertices[b]) {
+                for (int i = 0; i < network.getOutDegree(u); i++) {
+                    int a = network.getOutArc(u, i);
+                    int c = block[network.getArcDest(a)];
+                    if (!network.isArcDisabled(a) && bridge[a] && tree[c] == -1) {
+                        tree[c] = root;
+                        parent[c] = b;
+                        parentCapacity[c] = network.getArcCapacity(a);
+                        depth[c] = depth[b] + 1;
+                        q.push_back(c);
+                    }
+                }
+            }
+        }
+    }
+}
+
+vector<bool> PairUpperBounds::findBridges(const FlowNetwork &network) {
+    int n = network.getSize();
+    vector<bool> bridge(network.getArcCount(), false);
+    vector<int> disc(n, -1), low(n, 0);
+    int time = 0;
+
+    struct Frame {
+        int v; /**< Vertex being explored */
+        int parentArc; /**< Arc used to reach v (-1 for the root) */
+        int next; /**< Position of the next outgoing arc to explore */
+    };
+    vector<Frame> stack;
+
+    for (int root = 0; root < n; root++) {
+        if (disc[root] != -1) continue;
+
+        disc[root] = low[root] = time++;
+        stack.push_back({root, -1, 0});
+
+        while (!stack.empty()) {
+            Frame &f = stack.back();
+            int v = f.v;
+
+            if (f.next < network.getOutDegree(v)) {
+                int a = network.getOutArc(v, f.next++);
+                int w = network.getArcDest(a);
+
+                // Only the arc pair used to reach v is skipped, parallel segments still count as cycles
+                if (network.isArcDisabled(a) || (f.parentArc != -1 && a == network.getArcReverse(f.parentArc)))
+                    continue;
+
+                if (disc[w] == -1) {
+                    disc[w] = low[w] = time++;
+                    stack.push_back({w, a, 0});
+                }
+                else if (disc[w] < low[v]) {
+                    low[v] = disc[w];
+                }
+            }
+            else {
+                int parentArc = f.parentArc;
+                stack.pop_back();
+
+                if (parentArc != -1) {
+                    int u = network.getArcOrig(parentArc);
+                    if (low[v] < low[u]) low[u] = low[v];
+                    if (low[v] > disc[u]) {
+                        bridge[parentArc] = true;
+                        bridge[network.getArcReverse(parentArc)] = true;
+                    }
+                }
+            }
+        }
+    }
+
+    return bridge;
+}
+
+int PairUpperBounds::getBound(int s, int t) const {
+    int bound = min(incidentCapacity[s], incidentCapacity[t]);
+
+    int a = block[s], b = block[t];
+    if (tree[a] != tree[b])
+        return 0;
+
+    while (a != b) {
+        if (depth[a] < depth[b]) swap(a, b);
+        bound = min(bound, parentCapacity[a]);
+        a = parent[a];
+    }
+
+    return bound;
+}
+
+int PairUpperBounds::getIncidentCapacity(int v) const {
+    return incidentCapacity[v];
+}
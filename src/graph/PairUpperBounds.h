@@ -0,0 +1,59 @@
+#ifndef PROJECT_RAILWAY_PAIRUPPERBOUNDS_H
+#define PROJECT_RAILWAY_PAIRUPPERBOUNDS_H
+
+#include <vector>
+#include "FlowNetwork.h"
+
+using namespace std;
+
+/**
+ * Cheap upper bounds on the max flow between two vertices of a FlowNetwork, used to prune pair searches.
+ * Two bounds are combined:
+ *  - the capacity incident to each endpoint (it also dominates the degree bound, degree * highest capacity);
+ *  - the bridges separating both endpoints: every path between them crosses those segments, so the flow can't exceed
+ *    the smallest of them. Vertices in different connected components get a bound of 0.
+ * Disabled arcs never carry flow, so they are ignored.
+ */
+class PairUpperBounds {
+public:
+    /**
+     * Calculates the incident capacities, the bridges and the bridge tree of a network.
+     * Time Complexity: O(V+E), where V is the number of vertices and E is the number of edges.
+     * @param network - the network
+     */
+    explicit PairUpperBounds(const FlowNetwork &network);
+
+    /**
+     * Gets an upper bound on the max flow between two vertices.
+     * Time Complexity: O(B), where B is the number of bridges between s and t.
+     * @param s - the index of the source vertex
+     * @param t - the index of the sink vertex
+     * @return the upper bound
+     */
+    int getBound(int s, int t) const;
+
+    /**
+     * Gets the total capacity of the enabled arcs leaving a vertex.
+     * @param v - the index of the vertex
+     * @return the incident capacity
+     */
+    int getIncidentCapacity(int v) const;
+
+private:
+    vector<int> incidentCapacity; /**< Capacity of the enabled arcs leaving each vertex */
+    vector<int> block; /**< 2-edge-connected block of each vertex */
+    vector<int> tree; /**< Connected component of each block */
+    vector<int> parent; /**< Parent block in the bridge tree (-1 for roots) */
+    vector<int> parentCapacity; /**< Capacity of the bridge connecting each block to its parent */
+    vector<int> depth; /**< Depth of each block in the bridge tree */
+
+    /**
+     * Finds the bridges of the network with an iterative version of Tarjan's algorithm.
+     * Time Complexity: O(V+E), where V is the number of vertices and E is the number of edges.
+     * @param network - the network
+     * @return true for every arc that is part of a bridge
+     */
+    static vector<bool> findBridges(const FlowNetwork &network);
+};
+
+#endif //PROJECT_RAILWAY_PAIRUPPERBOUNDS_H
@@ -0,0 +1,98 @@
+#include "RegionSolver.h"
+#include <algorithm>
+
+RegionSolver::RegionSolver(const Graph &gh, enum region r, bool bidirectional)
+        : r(r), bidirectional(bidirectional), regionStations(gh.getRegionStations(r)) {}
+
+void RegionSolver::solveExtremePairs(const unordered_set<Vertex *> &extremes, WorkStealingPool &pool) const {
+    map<string, vector<Vertex *>> regionExtremes;
+    for (Vertex *v: extremes)
+        regionExtremes[Graph::getRegionOf(v, r)].push_back(v);
+
+    vector<pair<const vector<Vertex *> *, vector<Vertex *>>> tasks;
+    for (auto &pa: regionExtremes) {
+        auto stations = regionStations.find(pa.first);
+        if (pa.second.size() < 2 || stations == regionStations.end()) continue;
+
+        sort(pa.second.begin(), pa.second.end(), [](const Vertex *v1, const Vertex *v2) {
+            return v1->getId() < v2->getId();
+        });
+        tasks.emplace_back(&stations->second, pa.second);
+    }
+
+    pool.parallelFor<UndirectedFlowWorkspace>(tasks.size(), [this, &tasks](size_t i, UndirectedFlowWorkspace &ws) {
+        UndirectedFlowNetwork network(*tasks[i].first);
+        network.prepare(ws);
+        ws.bidirectional = bidirectional;
+        auto &regionExtremes = tasks[i].second;
+
+        for (size_t j = 0; j < regionExtremes.size(); j++) {
+            for (size_t k = j + 1; k < regionExtremes.size(); k++) {
+                Vertex *v1 = regionExtremes[j], *v2 = regionExtremes[k];
+                if (!(v1->getId() < v2->getId())) continue;
+
+                int flow = network.maxFlow(network.indexOf(v1), network.indexOf(v2), ws);
+                if (v2->getFlow() < flow)
+                    v2->setFlow(flow);
+            }
+        }
+    });
+}
+
+void RegionSolver::solveAllPairs(WorkStealingPool &pool) const {
+    vector<const vector<Vertex *> *> tasks;
+    for (auto &pa: regionStations)
+        if (pa.second.size() >= 2) tasks.push_back(&pa.second);
+
+    pool.parallelFor(tasks.size(), [this, &tasks](size_t i, unsigned) {
+        UndirectedFlowNetwork network(*tasks[i]);
+        GomoryHuTree tree(network, bidirectional);
+        int n = network.getSize();
+
+        // Same order as the keys of the vertex set of the graph
+        vector<string> keys(n);
+        for (int v = 0; v < n; v++) {
+            keys[v] = network.getVertex(v)->getId();
+            transform(keys[v].begin(), keys[v].end(), keys[v].begin(), ::tolower);
+        }
+
+        for (int v1 = 0; v1 < n; v1++) {
+            vector<int> flows = tree.getFlowsFrom(v1);
+            for (int v2 = 0; v2 < n; v2++) {
+                Vertex *station = network.getVertex(v2);
+                if (keys[v1] < keys[v2] && station->getFlow() < flows[v2])
+                    station->setFlow(flows[v2]);
+            }
+        }
+    });
+}
+
+map<string, vector<int>> RegionSolver::getComponentFlows(const Graph &gh, enum region r) {
+    DirectionOptimizingBfs bfs(gh);
+    bfs.restrictTo(r);
+
+    vector<int> seeds;
+    for (auto &pa: gh.getVertexSet())
+        seeds.push_back(bfs.indexOf(pa.second));
+    vector<int> component = bfs.labelComponents(seeds);
+
+    // Labels follow the order of the seeds, so each component is counted at its first station
+    vector<int> size(seeds.size() + 1, 0), highest(seeds.size() + 1, 0);
+    for (int v = 0; v < bfs.getSize(); v++) {
+        size[component[v]]++;
+        highest[component[v]] = max(highest[component[v]], bfs.getVertex(v)->getFlow());
+    }
+
+    map<string, vector<int>> flows;
+    int counted = 0;
+    for (int v: seeds) {
+        auto &regionFlows = flows[Graph::getRegionOf(bfs.getVertex(v), r)];
+        if (component[v] <= counted) continue;
+
+        counted = component[v];
+        if (size[counted] > 1 && highest[counted] > 0)
+            regionFlows.push_back(highest[counted]);
+    }
+
+    return flows;
+}
@@ -0,0 +1,65 @@
+#ifndef PROJECT_RAILWAY_REGIONSOLVER_H
+#define PROJECT_RAILWAY_REGIONSOLVER_H
+
+#include <map>
+#include <unordered_set>
+#include "DirectionOptimizingBfs.h"
+#include "GomoryHuTree.h"
+#include "UndirectedFlowNetwork.h"
+#include "parallel/WorkStealingPool.h"
+
+using namespace std;
+
+/**
+ * Solves the max flows restricted to a region (municipality or district) over the subgraph induced by each region,
+ * instead of searching the whole graph and skipping the vertices of other regions. Regions are independent, so each one
+ * is solved by its own task.
+ */
+class RegionSolver {
+public:
+    /**
+     * Groups the stations of a graph by region.
+     * Time Complexity: O(V*log(V)), where V is the number of vertices.
+     * @param gh - the graph
+     * @param r - the kind of region (MUNICIPALITIES or DISTRICTS)
+     * @param bidirectional - true to search the augmenting paths of the max flows from both ends
+     */
+    RegionSolver(const Graph &gh, enum region r, bool bidirectional = false);
+
+    /**
+     * Calculates the max flow between every pair of extremes (v1, v2) of the same region, with v1's id smaller than v2's,
+     * over the region's subgraph, and stores in the flow attribute of v2 the highest of those flows. The flow attribute of
+     * the other vertices is left untouched.
+     * Time Complexity: O(Σ R*F²*P_R / T), where, for each region, R is the number of stations, F the number of segments and P_R the number of pairs of extremes, and T is the number of threads.
+     * @param extremes - the extremes of the regions
+     * @param pool - the pool that runs the regions
+     */
+    void solveExtremePairs(const unordered_set<Vertex *> &extremes, WorkStealingPool &pool) const;
+
+    /**
+     * Calculates the max flow between every pair of stations (v1, v2) of the same region, with v1's id smaller than v2's
+     * (ignoring case), and stores in the flow attribute of v2 the highest of those flows. Instead of one max flow per
+     * pair, each region builds a Gomory-Hu tree of its subgraph and reads every pair from it.
+     * Time Complexity: O(Σ R²*F² / T), where, for each region, R is the number of stations and F the number of segments, and T is the number of threads.
+     * @param pool - the pool that runs the regions
+     */
+    void solveAllPairs(WorkStealingPool &pool) const;
+
+    /**
+     * Splits every region into its connected components (with a DirectionOptimizingBfs restricted to the region) and
+     * takes the highest flow attribute of the stations of each component with more than one station as its flow.
+     * Components are listed in the order of their first station in the vertex set of the graph.
+     * Time Complexity: O(V*log(V) + E), where V is the number of vertices and E is the number of edges.
+     * @param gh - the graph
+     * @param r - the kind of region
+     * @return the positive flows of the components of each region (every region has an entry)
+     */
+    static map<string, vector<int>> getComponentFlows(const Graph &gh, enum region r);
+
+private:
+    enum region r; /**< Kind of region */
+    bool bidirectional; /**< True to search the augmenting paths from both ends */
+    map<string, vector<Vertex *>> regionStations; /**< Stations of each region, sorted by id */
+};
+
+#endif //PROJECT_RAILWAY_REGIONSOLVER_H
@@ -0,0 +1,71 @@
+#include "Scenario.h"
+#include <algorithm>
+
+void Scenario::disableSegment(Edge *e) {
+    if (disabled.count(e)) return;
+
+    disabledSegments.push_back(e);
+    disabled.insert(e);
+    if (e->getReverse() != nullptr) disabled.insert(e->getReverse());
+}
+
+void Scenario::enableSegment(Edge *e) {
+    if (!disabled.count(e)) return;
+
+    disabled.erase(e);
+    if (e->getReverse() != nullptr) disabled.erase(e->getReverse());
+    disabledSegments.erase(remove_if(disabledSegments.begin(), disabledSegments.end(), [e](Edge *d) {
+        return d == e || d == e->getReverse();
+    }), disabledSegments.end());
+}
+
+void Scenario::setCapacity(Edge *e, int capacity) {
+    capacities[e] = capacity;
+    if (e->getReverse() != nullptr) capacities[e->getReverse()] = capacity;
+}
+
+void Scenario::setCost(Edge *e, int cost) {
+    costs[e] = cost;
+    if (e->getReverse() != nullptr) costs[e->getReverse()] = cost;
+}
+
+void Scenario::clear() {
+    disabledSegments.clear();
+    disabled.clear();
+    capacities.clear();
+    costs.clear();
+}
+
+bool Scenario::isEmpty() const {
+    return disabled.empty() && capacities.empty() && costs.empty();
+}
+
+bool Scenario::isDisabled(const Edge *e) const {
+    return !disabled.empty() && disabled.count(e);
+}
+
+int Scenario::getCapacity(const Edge *e) const {
+    if (capacities.empty()) return e->getCapacity();
+
+    auto it = capacities.find(e);
+    return it == capacities.end() ? e->getCapacity() : it->second;
+}
+
+int Scenario::getCost(const Edge *e) const {
+    if (costs.empty()) return e->getService();
+
+    auto it = costs.find(e);
+    return it == costs.end() ? e->getService() : it->second;
+}
+
+const vector<Edge *> &Scenario::getDisabledSegments() const {
+    return disabledSegments;
+}
+
+const unordered_map<const Edge *, int> &Scenario::getCapacities() const {
+    return capacities;
+}
+
+const unordered_map<const Edge *, int> &Scenario::getCosts() const {
+    return costs;
+}
@@ -0,0 +1,111 @@
+#ifndef PROJECT_RAILWAY_SCENARIO_H
+#define PROJECT_RAILWAY_SCENARIO_H
+
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include "VertexEdge.h"
+
+using namespace std;
+
+/**
+ * What-if overlay over the railway graph: a sparse set of disabled segments and of segments with a different capacity or
+ * cost.
+ * The graph itself is never modified, so any number of scenarios can exist (and be solved) at the same time, and
+ * dropping a scenario needs no restore step. Changes always apply to both directions of a segment.
+ * FlowNetwork applies a scenario either when taking its snapshot or, for many scenarios over the same snapshot, to the
+ * workspace of a solve.
+ */
+class Scenario {
+public:
+    /**
+     * Disables a segment.
+     * Time Complexity: O(1) on average.
+     * @param e - an edge of the segment
+     */
+    void disableSegment(Edge *e);
+
+    /**
+     * Enables a segment again.
+     * Time Complexity: O(D) where D is the number of disabled segments.
+     * @param e - an edge of the segment
+     */
+    void enableSegment(Edge *e);
+
+    /**
+     * Changes the capacity of a segment.
+     * Time Complexity: O(1) on average.
+     * @param e - an edge of the segment
+     * @param capacity - the new capacity
+     */
+    void setCapacity(Edge *e, int capacity);
+
+    /**
+     * Changes the cost of sending one train through a segment, which is otherwise its service.
+     * Time Complexity: O(1) on average.
+     * @param e - an edge of the segment
+     * @param cost - the new cost, positive like the services
+     */
+    void setCost(Edge *e, int cost);
+
+    /**
+     * Removes every change of the scenario.
+     */
+    void clear();
+
+    /**
+     * Checks if the scenario changes nothing.
+     * @return true if there are no changes, false otherwise
+     */
+    bool isEmpty() const;
+
+    /**
+     * Checks if an edge is disabled in the scenario.
+     * Time Complexity: O(1) on average.
+     * @param e - the edge
+     * @return true if the edge is disabled, false otherwise
+     */
+    bool isDisabled(const Edge *e) const;
+
+    /**
+     * Gets the capacity of an edge in the scenario.
+     * Time Complexity: O(1) on average.
+     * @param e - the edge
+     * @return the changed capacity, or the capacity of the edge if it was not changed
+     */
+    int getCapacity(const Edge *e) const;
+
+    /**
+     * Gets the cost of an edge in the scenario.
+     * Time Complexity: O(1) on average.
+     * @param e - the edge
+     * @return the changed cost, or the service of the edge if it was not changed
+     */
+    int getCost(const Edge *e) const;
+
+    /**
+     * Gets the disabled segments, in the order they were disabled.
+     * @return an edge of each disabled segment
+     */
+    const vector<Edge *> &getDisabledSegments() const;
+
+    /**
+     * Gets the changed capacities.
+     * @return the new capacity of each changed edge (both directions of each segment)
+     */
+    const unordered_map<const Edge *, int> &getCapacities() const;
+
+    /**
+     * Gets the changed costs.
+     * @return the new cost of each changed edge (both directions of each segment)
+     */
+    const unordered_map<const Edge *, int> &getCosts() const;
+
+private:
+    vector<Edge *> disabledSegments; /**< An edge of each disabled segment, in the order they were disabled */
+    unordered_set<const Edge *> disabled; /**< Both edges of every disabled segment */
+    unordered_map<const Edge *, int> capacities; /**< Changed capacity of both edges of every changed segment */
+    unordered_map<const Edge *, int> costs; /**< Changed cost of both edges of every changed segment */
+};
+
+#endif //PROJECT_RAILWAY_SCENARIO_H
@@ -0,0 +1,130 @@
+#ifndef PROJECT_RAILWAY_SCENARIOREACHABILITY_H
+#define PROJECT_RAILWAY_SCENARIOREACHABILITY_H
+
+#include <bitset>
+#include <vector>
+#include "FlowNetwork.h"
+
+using namespace std;
+
+/**
+ * Reachability over a FlowNetwork for up to N failure scenarios at once, where each scenario is a set of failed segments.
+ * Every arc holds a bitmask of the scenarios in which it is still up, and a single search propagates the reachable
+ * scenarios of each vertex with word-wide AND/OR: a vertex reaches its neighbour in the scenarios where it is reached and
+ * the arc between them is up. The graph itself is never modified.
+ * A vertex that can't be reached in a scenario has no flow from the source in it, so the searches can be used to skip
+ * flow computations; with the super source as the source, they find the stations cut off from every line extreme.
+ * @tparam N - the number of scenarios (64 for a single machine word, 256 for four)
+ */
+template <size_t N>
+class ScenarioReachability {
+public:
+    typedef bitset<N> Mask; /**< One bit per scenario */
+
+    /**
+     * Constructor, with no failed segments in any scenario.
+     * Time Complexity: O(E), where E is the number of edges.
+     * @param network - the network (disabled arcs are down in every scenario)
+     */
+    explicit ScenarioReachability(const FlowNetwork &network);
+
+    /**
+     * Sets the failed segments of each scenario.
+     * Time Complexity: O(E + F), where E is the number of edges and F is the total number of failed segments.
+     * @param failedArcs - an arc of each failed segment, for each scenario (at most N scenarios)
+     */
+    void setScenarios(const vector<vector<int>> &failedArcs);
+
+    /**
+     * Finds the scenarios in which each vertex can be reached from a source.
+     * Time Complexity: O(N*(V+E)) in the worst case, but usually O(V+E), where V is the number of vertices and E is the
+     * number of edges.
+     * The queue of the search is kept between calls, so a search over a set up object doesn't allocate.
+     * @param source - the index of the source vertex
+     * @param reach - variable that will hold the reachable scenarios of each vertex
+     */
+    void findReachable(int source, vector<Mask> &reach);
+
+    /**
+     * Finds the stations that can't be reached from the super source, i.e. from any line extreme, in a scenario.
+     * Time Complexity: O(V), where V is the number of vertices.
+     * @param reach - the reachable scenarios of each vertex, found from the super source
+     * @param scenario - the scenario
+     * @param disconnected - variable that will hold the indices of the unreachable stations
+     */
+    void getDisconnected(const vector<Mask> &reach, size_t scenario, vector<int> &disconnected) const;
+
+private:
+    const FlowNetwork &network; /**< Network being searched */
+    vector<Mask> up; /**< Scenarios in which each arc is up */
+    vector<Mask> base; /**< Scenarios in which each arc is up when no segment failed */
+    vector<int> changed; /**< Arcs whose mask differs from the base one */
+    vector<int> queue; /**< Vertices to expand by the search */
+    vector<char> queued; /**< True for the vertices in the queue (all false between two searches) */
+};
+
+template <size_t N>
+ScenarioReachability<N>::ScenarioReachability(const FlowNetwork &network) : network(network) {
+    base.assign(network.getArcCount(), Mask());
+    for (int a = 0; a < network.getArcCount(); a++)
+        if (!network.isArcDisabled(a)) base[a].set();
+    up = base;
+}
+
+template <size_t N>
+void ScenarioReachability<N>::setScenarios(const vector<vector<int>> &failedArcs) {
+    // Only the arcs changed by the previous scenarios are restored
+    for (int a: changed)
+        up[a] = base[a];
+    changed.clear();
+
+    for (size_t s = 0; s < failedArcs.size() && s < N; s++) {
+        for (int a: failedArcs[s]) {
+            int reverse = network.getArcReverse(a);
+            up[a].reset(s);
+            up[reverse].reset(s);
+            changed.push_back(a);
+            changed.push_back(reverse);
+        }
+    }
+}
+
+template <size_t N>
+void ScenarioReachability<N>::findReachable(int source, vector<Mask> &reach) {
+    int n = network.getSize();
+    reach.assign(n, Mask());
+    reach[source].set();
+
+    queue.assign(1, source);
+    queued.resize(n, false);
+    queued[source] = true;
+
+    // A vertex goes back to the queue whenever it gains new scenarios, which only happens a few times per vertex
+    for (size_t head = 0; head < queue.size(); head++) {
+        int v = queue[head];
+        queued[v] = false;
+
+        for (int i = 0; i < network.getOutDegree(v); i++) {
+            int a = network.getOutArc(v, i);
+            int w = network.getArcDest(a);
+
+            Mask gained = reach[v] & up[a] & ~reach[w];
+            if (gained.none()) continue;
+
+            reach[w] |= gained;
+            if (!queued[w]) {
+                queued[w] = true;
+                queue.push_back(w);
+            }
+        }
+    }
+}
+
+template <size_t N>
+void ScenarioReachability<N>::getDisconnected(const vector<Mask> &reach, size_t scenario, vector<int> &disconnected) const {
+    disconnected.clear();
+    for (int v = 0; v < network.getSize(); v++)
+        if (v != network.getSuperSource() && !reach[v].test(scenario)) disconnected.push_back(v);
+}
+
+#endif //PROJECT_RAILWAY_SCENARIOREACHABILITY_H
@@ -0,0 +1,110 @@
+#include "SegmentCriticality.h"
+#include <algorithm>
+#include <cstdlib>
+
+SegmentCriticality::SegmentCriticality(const FlowNetwork &network) : network(network), segments(network.getSegments()) {}
+
+size_t SegmentCriticality::getSegmentCount() const {
+    return segments.size();
+}
+
+size_t SegmentCriticality::getCandidateCount() const {
+    size_t count = 0;
+    for (auto &stationList: affected)
+        if (!stationList.empty()) count++;
+    return count;
+}
+
+size_t SegmentCriticality::getEvaluatedCount() const {
+    return evaluated;
+}
+
+void SegmentCriticality::solveBaselines(WorkStealingPool &pool) {
+    stations.clear();
+    for (int v = 0; v < network.getSize(); v++)
+        if (v != network.getSuperSource()) stations.push_back(v);
+
+    baseline.assign(stations.size(), 0);
+    baselineFlows.assign(stations.size(), vector<int>());
+    pool.parallelFor<FlowWorkspace>(stations.size(), [this](size_t i, FlowWorkspace &ws) {
+        baseline[i] = network.maxFlow(network.getSuperSource(), stations[i], ws);
+        baselineFlows[i] = ws.flow;
+    });
+
+    affected.assign(segments.size(), vector<int>());
+    bound.assign(segments.size(), 0);
+    for (size_t i = 0; i < stations.size(); i++) {
+        auto &flow = baselineFlows[i];
+        for (size_t j = 0; j < segments.size(); j++) {
+            int a = segments[j], reverse = network.getArcReverse(a);
+            int net = abs(flow[a] - (reverse == a ? 0 : flow[reverse]));
+            if (net == 0) continue;
+
+            affected[j].push_back(i);
+            bound[j] += min(net, baseline[i]);
+        }
+    }
+}
+
+long SegmentCriticality::evaluate(size_t segment, FlowWorkspace &ws) const {
+    long loss = 0;
+    if (ws.flow.size() != (size_t) network.getArcCount())
+        network.prepare(ws);
+
+    for (int i: affected[segment]) {
+        ws.flow = baselineFlows[i];
+        loss += baseline[i] - network.repairFlow(network.getSuperSource(), stations[i], segments[segment], ws);
+    }
+
+    return loss;
+}
+
+vector<pair<int, long>> SegmentCriticality::rank(WorkStealingPool &pool, int topK, const function<void(int, long)> &report) {
+    solveBaselines(pool);
+
+    size_t wanted = topK > 0 && (size_t) topK < segments.size() ? topK : segments.size();
+    vector<size_t> candidates(segments.size());
+    for (size_t i = 0; i < segments.size(); i++)
+        candidates[i] = i;
+    stable_sort(candidates.begin(), candidates.end(), [this](size_t i, size_t j) {
+        return bound[i] > bound[j];
+    });
+
+    vector<long> loss(segments.size(), 0);
+    vector<size_t> pending; // evaluated segments that are not ranked yet
+    vector<pair<int, long>> ranking;
+    size_t batchSize = 2 * pool.getThreadCount();
+    evaluated = 0;
+
+    auto higherLoss = [&loss](size_t i, size_t j) {
+        return loss[i] > loss[j] || (loss[i] == loss[j] && i < j);
+    };
+
+    for (size_t next = 0; ranking.size() < wanted; next += batchSize) {
+        // Segments without a bound have no loss, so they don't need a repair and can all be taken at once
+        size_t batchEnd = bound[candidates[next]] == 0 ? candidates.size() : min(next + batchSize, candidates.size());
+
+        pool.parallelFor<FlowWorkspace>(batchEnd - next, [&](size_t i, FlowWorkspace &ws) {
+            size_t c = candidates[next + i];
+            if (bound[c] > 0) loss[c] = evaluate(c, ws);
+        });
+
+        for (size_t i = next; i < batchEnd; i++) {
+            if (bound[candidates[i]] > 0) evaluated++;
+            pending.push_back(candidates[i]);
+        }
+        sort(pending.begin(), pending.end(), higherLoss);
+
+        // A pending segment is final once no unevaluated segment can reach its loss
+        long remaining = batchEnd < candidates.size() ? bound[candidates[batchEnd]] : -1;
+        size_t taken = 0;
+        while (taken < pending.size() && ranking.size() < wanted && loss[pending[taken]] > remaining) {
+            ranking.emplace_back(segments[pending[taken]], loss[pending[taken]]);
+            report(ranking.back().first, ranking.back().second);
+            taken++;
+        }
+        pending.erase(pending.begin(), pending.begin() + taken);
+    }
+
+    return ranking;
+}
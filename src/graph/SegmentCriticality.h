@@ -0,0 +1,84 @@
+#ifndef PROJECT_RAILWAY_SEGMENTCRITICALITY_H
+#define PROJECT_RAILWAY_SEGMENTCRITICALITY_H
+
+#include <functional>
+#include <vector>
+#include "FlowNetwork.h"
+#include "parallel/WorkStealingPool.h"
+
+using namespace std;
+
+/**
+ * Ranks the segments of a network by the total loss of station flow their failure causes. The flow of a station is the
+ * max flow from the super source (every line extreme but the station itself) to it.
+ * A segment can only lower the flow of a station if it carries flow in the station's baseline max flow, and by no more
+ * than that flow, so segments unused by every baseline are never evaluated and the rest are evaluated in decreasing
+ * order of that bound. Each evaluation repairs the baseline flows of the affected stations instead of solving them again.
+ */
+class SegmentCriticality {
+public:
+    /**
+     * Finds the enabled segments of a network.
+     * Time Complexity: O(E), where E is the number of edges.
+     * @param network - the network, with a super source
+     */
+    explicit SegmentCriticality(const FlowNetwork &network);
+
+    /**
+     * Ranks the segments with the highest loss. Segments are reported in order as soon as no unevaluated segment can
+     * overtake them, so the top of the ranking is known long before the whole network is evaluated.
+     * Time Complexity: O(V²*E² / T) for the baselines plus O(V*E*L / T) per evaluated segment, where V is the number of
+     * vertices, E is the number of edges, L is the flow of the segment and T is the number of threads.
+     * @param pool - the pool that runs the stations and the segments
+     * @param topK - the number of segments wanted (0 ranks every segment)
+     * @param report - called with the arc of each ranked segment and its loss, in ranking order
+     * @return the ranked segments (an arc of each one and its loss), in decreasing order of loss
+     */
+    vector<pair<int, long>> rank(WorkStealingPool &pool, int topK, const function<void(int, long)> &report);
+
+    /**
+     * Gets the number of segments that can be ranked.
+     * @return the number of segments
+     */
+    size_t getSegmentCount() const;
+
+    /**
+     * Gets the number of segments that carry flow in some baseline of the last ranking, i.e. that could be evaluated.
+     * @return the number of candidate segments
+     */
+    size_t getCandidateCount() const;
+
+    /**
+     * Gets the number of segments evaluated by the last ranking.
+     * @return the number of evaluated segments
+     */
+    size_t getEvaluatedCount() const;
+
+private:
+    const FlowNetwork &network; /**< Network being analysed */
+    vector<int> stations; /**< Index of every station (all vertices but the super source) */
+    vector<int> baseline; /**< Max flow of each station of the intact network */
+    vector<vector<int>> baselineFlows; /**< Flow of each arc in the baseline of each station */
+    vector<int> segments; /**< An arc of each segment */
+    vector<vector<int>> affected; /**< Stations (positions in stations) whose baseline uses each segment */
+    vector<long> bound; /**< Upper bound on the loss of each segment */
+    size_t evaluated = 0; /**< Number of segments evaluated by the last ranking */
+
+    /**
+     * Solves the baseline of every station and finds the stations that use each segment.
+     * Time Complexity: O(V²*E² / T), where V is the number of vertices, E is the number of edges and T is the number of threads.
+     * @param pool - the pool that runs the stations
+     */
+    void solveBaselines(WorkStealingPool &pool);
+
+    /**
+     * Calculates the loss caused by the failure of a segment.
+     * Time Complexity: O(A*V*E*L), where A is the number of affected stations, V is the number of vertices, E is the number of edges and L is the flow of the segment.
+     * @param segment - the position of the segment in segments
+     * @param ws - the workspace used by the repairs
+     * @return the total loss of station flow
+     */
+    long evaluate(size_t segment, FlowWorkspace &ws) const;
+};
+
+#endif //PROJECT_RAILWAY_SEGMENTCRITICALITY_H
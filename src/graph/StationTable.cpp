@@ -0,0 +1,36 @@
+#include "StationTable.h"
+
+int StationTable::add(string name, string district, string municipality, string line, list<string> townships) {
+    int station = (int) attributes.size();
+
+    regionIds[LINE].push_back(internRegion(line, LINE));
+    regionIds[MUNICIPALITIES].push_back(internRegion(municipality, MUNICIPALITIES));
+    regionIds[DISTRICTS].push_back(internRegion(district, DISTRICTS));
+    components.push_back(0);
+    attributes.push_back({move(name), move(district), move(municipality), move(line), move(townships)});
+
+    return station;
+}
+
+void StationTable::remove(int station) {
+    StationAttributes &removed = attributes[station];
+    // Swapping with empty strings gives their buffers back, clear() would keep them
+    for (string *s: {&removed.name, &removed.district, &removed.municipality, &removed.line})
+        string().swap(*s);
+    removed.townships.clear();
+}
+
+void StationTable::shrinkToFit() {
+    attributes.shrink_to_fit();
+    for (auto &ids: regionIds)
+        ids.shrink_to_fit();
+    components.shrink_to_fit();
+}
+
+int StationTable::getSize() const {
+    return (int) attributes.size();
+}
+
+int StationTable::internRegion(const string &name, enum region r) {
+    return regionIdOf[r].emplace(name, (int) regionIdOf[r].size()).first->second;
+}
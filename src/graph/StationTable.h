@@ -0,0 +1,120 @@
+#ifndef PROJECT_RAILWAY_STATIONTABLE_H
+#define PROJECT_RAILWAY_STATIONTABLE_H
+
+#include <list>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using namespace std;
+
+enum region {LINE = 0, MUNICIPALITIES = 1, DISTRICTS = 2};
+
+/**
+ * Descriptive attributes of a station, which no solver reads.
+ */
+struct StationAttributes {
+    string name; /**< Name (id) of the station */
+    string district; /**< District of the station */
+    string municipality; /**< Municipality of the station */
+    string line; /**< Main line of the station */
+    list<string> townships; /**< Townships of the station */
+};
+
+/**
+ * Attributes of the stations of a graph, indexed by station id, so that the vertices only keep what the traversals
+ * touch. Each Graph owns one table, and its vertices keep a pointer to it next to their station id.
+ * The strings live in a cold table of their own. What the traversals do read about a station, its connected component
+ * and the ids of its line, municipality and district, is kept in dense arrays, one per attribute, so comparing the regions
+ * of two stations compares two ints instead of two strings.
+ * Stations are added while the railway is loaded, before any other thread reads the table. Removing a station releases
+ * its strings but not its id, so a vertex that was removed never reads the attributes of a newer station.
+ */
+class StationTable {
+public:
+    /**
+     * Adds a station.
+     * Time Complexity: O(1) amortized.
+     * @param name - the name of the station
+     * @param district - the district of the station
+     * @param municipality - the municipality of the station
+     * @param line - the main line of the station
+     * @param townships - the townships of the station
+     * @return the id of the station
+     */
+    int add(string name, string district, string municipality, string line, list<string> townships);
+
+    /**
+     * Removes a station, releasing the memory of its attributes.
+     * Time Complexity: O(T), where T is the number of townships of the station.
+     * @param station - the id of the station
+     */
+    void remove(int station);
+
+    /**
+     * Gets the descriptive attributes of a station.
+     * @param station - the id of the station
+     * @return the attributes
+     */
+    const StationAttributes &getAttributes(int station) const {
+        return attributes[station];
+    }
+
+    /**
+     * Gets the id of the region of a station. Stations of the same region have the same id.
+     * @param station - the id of the station
+     * @param r - the kind of region
+     * @return the id of the region
+     */
+    int getRegionId(int station, enum region r) const {
+        return regionIds[r][station];
+    }
+
+    /**
+     * Gets the connected component of a station.
+     * @param station - the id of the station
+     * @return the connected component
+     */
+    int getComponent(int station) const {
+        return components[station];
+    }
+
+    /**
+     * Sets the connected component of a station.
+     * @param station - the id of the station
+     * @param component - the connected component
+     */
+    void setComponent(int station, int component) {
+        components[station] = component;
+    }
+
+    /**
+     * Releases the memory reserved for stations that were never added. Called once the railway is loaded.
+     * Time Complexity: O(S), where S is the number of stations.
+     */
+    void shrinkToFit();
+
+    /**
+     * Gets the number of stations added so far, removed ones included.
+     * @return the number of stations
+     */
+    int getSize() const;
+
+    friend class MemoryFootprint; /**< Measures the memory used by the table */
+
+private:
+    vector<StationAttributes> attributes; /**< Cold attributes of each station */
+    vector<int> regionIds[3]; /**< Id of the line, municipality and district of each station */
+    vector<int> components; /**< Connected component of each station */
+    unordered_map<string, int> regionIdOf[3]; /**< Id of each line, municipality and district */
+
+    /**
+     * Gets the id of a region, giving it the next free id if it has none yet.
+     * @param name - the name of the region
+     * @param r - the kind of region
+     * @return the id of the region
+     */
+    int internRegion(const string &name, enum region r);
+};
+
+#endif //PROJECT_RAILWAY_STATIONTABLE_H
@@ -0,0 +1,359 @@
+#include "UndirectedFlowNetwork.h"
+#include "FlowKernels.h"
+#include "metrics/Allocations.h"
+#include "metrics/Metrics.h"
+#include "metrics/Trace.h"
+
+template <class Cap>
+BasicUndirectedFlowNetwork<Cap>::BasicUndirectedFlowNetwork(const Graph &gh, const Scenario &scenario) {
+    vector<Vertex *> stations;
+    for (const auto &v: gh.getVertexSet())
+        stations.push_back(v.second);
+
+    build(stations, false, scenario, nullptr);
+}
+
+template <class Cap>
+BasicUndirectedFlowNetwork<Cap>::BasicUndirectedFlowNetwork(const vector<Vertex *> &stations) {
+    build(stations, true, Scenario(), nullptr);
+}
+
+template <class Cap>
+BasicUndirectedFlowNetwork<Cap>::BasicUndirectedFlowNetwork(const Graph &gh, const unordered_set<Vertex *> &extremes,
+                                                            const Scenario &scenario) {
+    vector<Vertex *> stations;
+    for (const auto &v: gh.getVertexSet())
+        stations.push_back(v.second);
+
+    build(stations, false, scenario, &extremes);
+}
+
+template <class Cap>
+void BasicUndirectedFlowNetwork<Cap>::build(const vector<Vertex *> &stations, bool induced, const Scenario &scenario,
+                                            const unordered_set<Vertex *> *extremes) {
+    vertices = stations;
+    sort(vertices.begin(), vertices.end(), [](const Vertex *v1, const Vertex *v2) {
+        return v1->getId() < v2->getId();
+    });
+
+    int n = vertices.size();
+    index.reserve(n);
+    component.resize(n);
+    for (int i = 0; i < n; i++) {
+        index[vertices[i]] = i;
+        component[i] = induced ? 0 : vertices[i]->getComponent();
+    }
+
+    // Both edges of a segment get a half of it, numbered when the first of them is found
+    unordered_map<const Edge *, int> halfOf;
+    for (int v = 0; v < n; v++) {
+        for (Edge *e: vertices[v]->getAdj()) {
+            auto dest = index.find(e->getDest());
+            if (dest == index.end() || halfOf.count(e) || (!induced && scenario.isDisabled(e))) continue;
+
+            int segment = edges.size();
+            halfOf[e] = 2 * segment;
+            if (e->getReverse() != nullptr) halfOf[e->getReverse()] = 2 * segment + 1;
+
+            edges.push_back(e);
+            ends.push_back(v);
+            ends.push_back(dest->second);
+            capacity.push_back(scenario.getCapacity(e));
+        }
+    }
+
+    vector<vector<int>> out(n);
+    for (int v = 0; v < n; v++) {
+        for (Edge *e: vertices[v]->getAdj()) {
+            auto half = halfOf.find(e);
+            if (half != halfOf.end()) out[v].push_back(half->second);
+        }
+        // An edge with no reverse is still a segment, which its destination leaves through the other half
+        for (Edge *e: vertices[v]->getIncoming()) {
+            auto half = halfOf.find(e);
+            if (half != halfOf.end() && e->getReverse() == nullptr) out[v].push_back(half->second ^ 1);
+        }
+    }
+
+    if (extremes != nullptr) {
+        vector<Vertex *> sorted(extremes->begin(), extremes->end());
+        sort(sorted.begin(), sorted.end(), [](const Vertex *v1, const Vertex *v2) {
+            return v1->getId() < v2->getId();
+        });
+
+        superSource = n;
+        vertices.push_back(nullptr);
+        component.push_back(0);
+        out.emplace_back();
+
+        // The new segments go after the existing ones of each extreme
+        for (Vertex *e: sorted) {
+            auto v = index.find(e);
+            if (v == index.end()) continue;
+
+            int segment = edges.size();
+            edges.push_back(nullptr);
+            ends.push_back(superSource);
+            ends.push_back(v->second);
+            capacity.push_back(FlowTraits<Cap>::infinity());
+            out[superSource].push_back(2 * segment);
+            out[v->second].push_back(2 * segment + 1);
+        }
+    }
+
+    start.assign(1, 0);
+    for (auto &list: out) {
+        halves.insert(halves.end(), list.begin(), list.end());
+        start.push_back(halves.size());
+    }
+}
+
+template <class Cap>
+int BasicUndirectedFlowNetwork<Cap>::getSize() const {
+    return vertices.size();
+}
+
+template <class Cap>
+int BasicUndirectedFlowNetwork<Cap>::getSuperSource() const {
+    return superSource;
+}
+
+template <class Cap>
+int BasicUndirectedFlowNetwork<Cap>::getSegmentCount() const {
+    return edges.size();
+}
+
+template <class Cap>
+int BasicUndirectedFlowNetwork<Cap>::indexOf(const Vertex *v) const {
+    auto it = index.find(v);
+    return it == index.end() ? -1 : it->second;
+}
+
+template <class Cap>
+Vertex *BasicUndirectedFlowNetwork<Cap>::getVertex(int i) const {
+    return vertices[i];
+}
+
+template <class Cap>
+Edge *BasicUndirectedFlowNetwork<Cap>::getEdge(int segment) const {
+    return edges[segment];
+}
+
+template <class Cap>
+void BasicUndirectedFlowNetwork<Cap>::prepare(Workspace &ws) const {
+    METRIC_TIME(PREPARE_TIME);
+    ws.flow.assign(edges.size(), 0);
+    ws.path.assign(vertices.size(), -1);
+    ws.visited.assign(vertices.size(), 0);
+    ws.queue.reserve(vertices.size());
+    ws.next.clear();
+    ws.reached.clear();
+    ws.stamp = 0;
+}
+
+template <class Cap>
+Cap BasicUndirectedFlowNetwork<Cap>::getResidual(int h, const Workspace &ws) const {
+    int v = ends[h], w = ends[h ^ 1];
+    Cap along = (h & 1) ? -ws.flow[h >> 1] : ws.flow[h >> 1];
+
+    if (component[v] != 0 && component[w] != component[v])
+        return along < 0 ? -along : 0;
+
+    return capacity[h >> 1] - along;
+}
+
+template <class Cap>
+int BasicUndirectedFlowNetwork<Cap>::scanForward(int v, int t, Workspace &ws) const {
+    // Stamps of reached are only current during a bidirectional search, older ones never match
+    bool bidirectional = !ws.reached.empty();
+
+    for (int i = start[v]; i < start[v + 1]; i++) {
+        int h = halves[i];
+        int w = ends[h ^ 1];
+
+        if (ws.visited[w] == ws.stamp || (v == superSource && w == ws.sink))
+            continue;
+
+        if (FlowTraits<Cap>::isLess(0, getResidual(h, ws))) {
+            ws.path[w] = h;
+            if (w == t || (bidirectional && ws.reached[w] == ws.stamp))
+                return w;
+
+            ws.visited[w] = ws.stamp;
+            ws.queue.push_back(w);
+        }
+    }
+
+    return -1;
+}
+
+template <class Cap>
+int BasicUndirectedFlowNetwork<Cap>::scanBackward(int w, Workspace &ws) const {
+    for (int i = start[w]; i < start[w + 1]; i++) {
+        // The other half of the segment leaves the neighbour towards w
+        int h = halves[i] ^ 1;
+        int v = ends[h];
+
+        if (ws.reached[v] == ws.stamp || (v == superSource && w == ws.sink))
+            continue;
+
+        if (FlowTraits<Cap>::isLess(0, getResidual(h, ws))) {
+            ws.next[v] = h;
+            if (ws.visited[v] == ws.stamp)
+                return v;
+
+            ws.reached[v] = ws.stamp;
+            ws.backQueue.push_back(v);
+        }
+    }
+
+    return -1;
+}
+
+template <class Cap>
+bool BasicUndirectedFlowNetwork<Cap>::findPath(int s, int t, Workspace &ws) const {
+    if (ws.bidirectional)
+        return findPathBidirectional(s, t, ws);
+
+    // A new stamp marks every vertex as not visited without touching the whole vertex set
+    if (++ws.stamp == 0) {
+        fill(ws.visited.begin(), ws.visited.end(), 0);
+        fill(ws.reached.begin(), ws.reached.end(), 0);
+        ws.stamp = 1;
+    }
+
+    ws.queue.clear();
+    ws.visited[s] = ws.stamp;
+    ws.path[s] = -1;
+    ws.queue.push_back(s);
+    long long scanned = 0;
+    METRIC_ADD(PATH_SEARCHES, 1);
+
+    for (size_t head = 0; head < ws.queue.size(); head++) {
+        int v = ws.queue[head];
+        scanned += start[v + 1] - start[v];
+
+        if (scanForward(v, t, ws) != -1) {
+            METRIC_ADD(ARCS_SCANNED, scanned);
+            METRIC_ADD(VERTICES_VISITED, ws.queue.size());
+            return true;
+        }
+    }
+
+    METRIC_ADD(ARCS_SCANNED, scanned);
+    METRIC_ADD(VERTICES_VISITED, ws.queue.size());
+    return false;
+}
+
+template <class Cap>
+bool BasicUndirectedFlowNetwork<Cap>::findPathBidirectional(int s, int t, Workspace &ws) const {
+    if (ws.reached.size() != vertices.size()) {
+        ws.reached.assign(vertices.size(), 0);
+        ws.next.assign(vertices.size(), -1);
+        ws.backQueue.reserve(vertices.size());
+    }
+
+    if (++ws.stamp == 0) {
+        fill(ws.visited.begin(), ws.visited.end(), 0);
+        fill(ws.reached.begin(), ws.reached.end(), 0);
+        ws.stamp = 1;
+    }
+
+    ws.queue.clear();
+    ws.backQueue.clear();
+    ws.visited[s] = ws.stamp;
+    ws.path[s] = -1;
+    ws.queue.push_back(s);
+    ws.reached[t] = ws.stamp;
+    ws.next[t] = -1;
+    ws.backQueue.push_back(t);
+    long long scanned = 0;
+    METRIC_ADD(PATH_SEARCHES, 1);
+
+    size_t head = 0, backHead = 0;
+    int meet = -1;
+    while (meet == -1 && head < ws.queue.size() && backHead < ws.backQueue.size()) {
+        // No vertex is reached by both searches before they meet, so the first meeting closes a shortest path
+        if (ws.queue.size() - head <= ws.backQueue.size() - backHead) {
+            for (size_t end = ws.queue.size(); head < end && meet == -1; head++) {
+                int v = ws.queue[head];
+                scanned += start[v + 1] - start[v];
+                meet = scanForward(v, t, ws);
+            }
+        }
+        else {
+            for (size_t end = ws.backQueue.size(); backHead < end && meet == -1; backHead++) {
+                int w = ws.backQueue[backHead];
+                scanned += start[w + 1] - start[w];
+                meet = scanBackward(w, ws);
+            }
+        }
+    }
+
+    if (meet != -1) {
+        // The halves from the meeting vertex to t become the rest of the path from s
+        for (int v = meet; v != t; v = ends[ws.next[v] ^ 1])
+            ws.path[ends[ws.next[v] ^ 1]] = ws.next[v];
+    }
+    else {
+        // Nothing reaches t anymore, the vertices reached from s are the source side of the min cut
+        for (; head < ws.queue.size(); head++) {
+            int v = ws.queue[head];
+            scanned += start[v + 1] - start[v];
+            scanForward(v, t, ws);
+        }
+    }
+
+    METRIC_ADD(ARCS_SCANNED, scanned);
+    METRIC_ADD(VERTICES_VISITED, ws.queue.size() + ws.backQueue.size());
+    return meet != -1;
+}
+
+template <class Cap>
+void BasicUndirectedFlowNetwork<Cap>::augmentPath(int t, Workspace &ws) const {
+    METRIC_ADD(AUGMENTING_PATHS, 1);
+    Cap bottleneck = FlowTraits<Cap>::infinity();
+    for (int v = t; ws.path[v] != -1; v = ends[ws.path[v]])
+        bottleneck = min(bottleneck, getResidual(ws.path[v], ws));
+
+    for (int v = t; ws.path[v] != -1; v = ends[ws.path[v]]) {
+        int h = ws.path[v];
+        ws.flow[h >> 1] += (h & 1) ? -bottleneck : bottleneck;
+    }
+}
+
+template <class Cap>
+Cap BasicUndirectedFlowNetwork<Cap>::maxFlow(int s, int t, Workspace &ws) const {
+    METRIC_TIME(MAX_FLOW_TIME);
+    METRIC_ADD(MAX_FLOW_SOLVES, 1);
+    METRIC_LATENCY(EDMONDS_KARP_SOLVE);
+    ALLOCATION_SCOPE(MAX_FLOW_ALLOCATIONS);
+    TraceScope trace("solve", "undirectedMaxFlow");
+    trace.addArg("source", s);
+    trace.addArg("sink", t);
+    if (ws.flow.size() != edges.size() || ws.visited.size() != vertices.size())
+        prepare(ws);
+    else
+        FlowKernels::clear(ws.flow);
+    ws.sink = t;
+
+    while (findPath(s, t, ws))
+        augmentPath(t, ws);
+
+    return getFlowInto(t, ws);
+}
+
+template <class Cap>
+Cap BasicUndirectedFlowNetwork<Cap>::getFlowInto(int t, const Workspace &ws) const {
+    return FlowKernels::halfSum(ws.flow, halves.data() + start[t], start[t + 1] - start[t]);
+}
+
+template <class Cap>
+bool BasicUndirectedFlowNetwork<Cap>::isSourceSide(int v, const Workspace &ws) const {
+    // The last search of maxFlow failed, so it visited exactly the vertices reachable from the source
+    return ws.visited[v] == ws.stamp;
+}
+
+template class BasicUndirectedFlowNetwork<int>;
+template class BasicUndirectedFlowNetwork<long long>;
+template class BasicUndirectedFlowNetwork<double>;
@@ -0,0 +1,233 @@
+#ifndef PROJECT_RAILWAY_UNDIRECTEDFLOWNETWORK_H
+#define PROJECT_RAILWAY_UNDIRECTEDFLOWNETWORK_H
+
+#include <vector>
+#include <unordered_map>
+#include "FlowTraits.h"
+#include "Graph.h"
+#include "Scenario.h"
+
+using namespace std;
+
+/**
+ * Scratch state of a single max flow computation over a BasicUndirectedFlowNetwork.
+ * Every thread owns its own workspace, so several solves can run at the same time over the same (read-only) network.
+ * @tparam Cap - the type of the capacities and flows
+ */
+template <class Cap>
+struct BasicUndirectedFlowWorkspace {
+    vector<Cap> flow; /**< Net flow of each segment, positive from its first end to its second */
+    vector<int> path; /**< Half of the segment used to reach each vertex during the last search (-1 if none) */
+    vector<unsigned> visited; /**< Stamp of the last search that visited each vertex */
+    vector<int> queue; /**< BFS queue, reused between searches */
+    unsigned stamp = 0; /**< Stamp of the current search */
+    int sink = -1; /**< Sink of the current solve, whose segment to the super source is never used */
+    bool bidirectional = false; /**< True to search for augmenting paths from both the source and the sink */
+    vector<int> next; /**< Half that leads each vertex towards the sink during the last bidirectional search */
+    vector<unsigned> reached; /**< Stamp of the last bidirectional search that reached each vertex from the sink */
+    vector<int> backQueue; /**< BFS queue of the search from the sink, reused between searches */
+};
+
+/**
+ * Snapshot of a Graph for max flows in which each segment is a single pair of halves with one signed flow, instead of
+ * the two directed arcs (each with its own flow, scanned forward and backward) of BasicFlowNetwork. Half 2*s leaves the
+ * first end of segment s and half 2*s+1 leaves the second one; the residual capacity of a half is the capacity of the
+ * segment minus the net flow along it. That is the residual network of BasicFlowNetwork with opposite flows cancelled,
+ * so the max flows and min cuts are the same, while a search scans every segment once from each end instead of twice
+ * and the network keeps half the arrays.
+ * Vertices are indexed like in BasicFlowNetwork (sorted by id, super source last), so indices can be shared. Scenarios
+ * only apply when taking the snapshot: disabled segments are left out of it.
+ * @tparam Cap - the type of the capacities and flows
+ */
+template <class Cap>
+class BasicUndirectedFlowNetwork {
+public:
+    typedef BasicUndirectedFlowWorkspace<Cap> Workspace; /**< Workspace of the solves over this network */
+
+    /**
+     * Takes a snapshot of the topology and capacities of a graph, with the changes of a scenario.
+     * Time Complexity: O(V*log(V) + E), where V is the number of vertices and E is the number of edges.
+     * @param gh - the graph to snapshot
+     * @param scenario - the changes to the graph (none by default)
+     */
+    explicit BasicUndirectedFlowNetwork(const Graph &gh, const Scenario &scenario = Scenario());
+
+    /**
+     * Takes a snapshot of the subgraph induced by a set of stations, ignoring the connected components.
+     * Time Complexity: O(S*log(S) + E), where S is the number of stations and E is the number of edges leaving them.
+     * @param stations - the stations of the subgraph
+     */
+    explicit BasicUndirectedFlowNetwork(const vector<Vertex *> &stations);
+
+    /**
+     * Takes a snapshot of a graph plus a super source connected to every line extreme by a segment of unbounded capacity,
+     * which only carries flow away from the super source. Solving from the super source ignores its segment to the sink.
+     * Time Complexity: O(V*log(V) + E), where V is the number of vertices and E is the number of edges.
+     * @param gh - the graph to snapshot
+     * @param extremes - the vertices connected to the super source
+     * @param scenario - the changes to the graph (none by default)
+     */
+    BasicUndirectedFlowNetwork(const Graph &gh, const unordered_set<Vertex *> &extremes,
+                               const Scenario &scenario = Scenario());
+
+    /**
+     * Gets the number of vertices of the network.
+     * @return the number of vertices
+     */
+    int getSize() const;
+
+    /**
+     * Gets the index of the super source.
+     * @return the index of the super source, or -1 if the network has none
+     */
+    int getSuperSource() const;
+
+    /**
+     * Gets the number of segments of the network.
+     * @return the number of segments
+     */
+    int getSegmentCount() const;
+
+    /**
+     * Gets the index of a vertex of the original graph.
+     * @param v - the vertex
+     * @return the index of the vertex, or -1 if it is not part of the network
+     */
+    int indexOf(const Vertex *v) const;
+
+    /**
+     * Gets the vertex of the original graph with a certain index.
+     * @param i - the index of the vertex
+     * @return the vertex (nullptr for the super source)
+     */
+    Vertex *getVertex(int i) const;
+
+    /**
+     * Gets the edge of the original graph from the first end of a segment to the second.
+     * @param segment - the index of the segment
+     * @return the edge (nullptr for the segments of the super source)
+     */
+    Edge *getEdge(int segment) const;
+
+    /**
+     * Sizes a workspace for this network and clears its flow.
+     * Time Complexity: O(V+S), where V is the number of vertices and S is the number of segments.
+     * @param ws - the workspace to prepare
+     */
+    void prepare(Workspace &ws) const;
+
+    /**
+     * Calculates the max flow between two vertices, leaving the net flow of each segment in the workspace. When s is the
+     * super source, its segment to t (if any) is not used. With ws.bidirectional, the augmenting paths are searched from
+     * both ends (see findPathBidirectional).
+     * Time Complexity: O(V*S²), where V is the number of vertices and S is the number of segments.
+     * @param s - the index of the source vertex
+     * @param t - the index of the sink vertex
+     * @param ws - the workspace used by the computation
+     * @return the max flow between s and t
+     */
+    Cap maxFlow(int s, int t, Workspace &ws) const;
+
+    /**
+     * Gets the net flow that reaches a vertex in a workspace.
+     * Time Complexity: O(D), where D is the degree of the vertex.
+     * @param t - the index of the vertex
+     * @param ws - the workspace holding the flow
+     * @return the flow entering t minus the flow leaving it
+     */
+    Cap getFlowInto(int t, const Workspace &ws) const;
+
+    /**
+     * Checks if a vertex is on the source side of the min cut found by the last maxFlow over a workspace.
+     * @param v - the index of the vertex
+     * @param ws - the workspace used by maxFlow
+     * @return true if the vertex is on the source side, false otherwise
+     */
+    bool isSourceSide(int v, const Workspace &ws) const;
+
+    friend class MemoryFootprint; /**< Measures the memory used by the network */
+
+protected:
+    vector<Vertex *> vertices; /**< Vertices of the original graph, sorted by id */
+    unordered_map<const Vertex *, int> index; /**< Index of each vertex of the original graph */
+    vector<int> component; /**< Connected component of each vertex */
+    int superSource = -1; /**< Index of the super source (-1 if none) */
+
+    vector<int> start; /**< Start of the halves leaving each vertex in halves (size V+1) */
+    vector<int> halves; /**< Halves leaving every vertex, in adjacency order */
+    vector<int> ends; /**< Vertex each half leaves (the first and second ends of each segment) */
+    vector<Cap> capacity; /**< Capacity of each segment */
+    vector<Edge *> edges; /**< Edge of the original graph from the first end of each segment to the second */
+
+    /**
+     * Builds the network over a set of vertices, keeping only the enabled segments between them.
+     * @param stations - the vertices of the network
+     * @param induced - true for a region subgraph (components are ignored)
+     * @param scenario - the changes to the graph
+     * @param extremes - the vertices to connect to a super source (nullptr for a network without one)
+     */
+    void build(const vector<Vertex *> &stations, bool induced, const Scenario &scenario,
+               const unordered_set<Vertex *> *extremes);
+
+    /**
+     * Gets the residual capacity of a half: the capacity of its segment minus the net flow along it. Halves into the super
+     * source, like the arcs between components of BasicFlowNetwork, can only take back the flow sent along the segment.
+     * @param h - the index of the half
+     * @param ws - the workspace holding the flow
+     * @return the residual capacity
+     */
+    Cap getResidual(int h, const Workspace &ws) const;
+
+    /**
+     * BFS that finds the shortest augmenting path between s and t over the residual network.
+     * Time Complexity: O(V+S), where V is the number of vertices and S is the number of segments.
+     * @param s - the index of the source vertex
+     * @param t - the index of the sink vertex
+     * @param ws - the workspace used by the search
+     * @return true if a path was found, and false otherwise.
+     */
+    bool findPath(int s, int t, Workspace &ws) const;
+
+    /**
+     * BFS that finds the shortest augmenting path between s and t growing a search forward from s and one backward from
+     * t, a whole level of the smaller frontier at a time, like BasicFlowNetwork::findPathBidirectional. When t's side runs
+     * out first, the search from s is finished anyway, so the workspace keeps the min cut of isSourceSide.
+     * Time Complexity: O(V+S), where V is the number of vertices and S is the number of segments.
+     * @param s - the index of the source vertex
+     * @param t - the index of the sink vertex
+     * @param ws - the workspace used by the search
+     * @return true if a path was found, and false otherwise.
+     */
+    bool findPathBidirectional(int s, int t, Workspace &ws) const;
+
+    /**
+     * Visits the residual neighbours of a vertex of the search from the source, recording the half that reaches each one.
+     * @param v - the index of the vertex
+     * @param t - the index of the sink vertex
+     * @param ws - the workspace used by the search
+     * @return the first neighbour that is t or was reached from t by the current search, or -1 if none
+     */
+    int scanForward(int v, int t, Workspace &ws) const;
+
+    /**
+     * Visits the neighbours with residual capacity into a vertex of the search from the sink, recording the half that
+     * leads each one towards the sink.
+     * @param w - the index of the vertex
+     * @param ws - the workspace used by the search
+     * @return the first neighbour that was reached from the source by the current search, or -1 if none
+     */
+    int scanBackward(int w, Workspace &ws) const;
+
+    /**
+     * Finds the bottleneck of the augmenting path ending in t and augments the flow of its segments by it.
+     * Time Complexity: O(V), where V is the number of vertices.
+     * @param t - the index of the sink vertex
+     * @param ws - the workspace holding the path
+     */
+    void augmentPath(int t, Workspace &ws) const;
+};
+
+typedef BasicUndirectedFlowNetwork<int> UndirectedFlowNetwork; /**< 32-bit undirected network, for the railway */
+typedef UndirectedFlowNetwork::Workspace UndirectedFlowWorkspace; /**< Workspace of the 32-bit undirected network */
+
+#endif //PROJECT_RAILWAY_UNDIRECTEDFLOWNETWORK_H
@@ -4,11 +4,12 @@ using namespace std;
 
 /************************* Vertex  **************************/
 
-Vertex::Vertex(string id, std::string district, std::string municipality, std::string mainLine,
+Vertex::Vertex(StationTable &table, string id, std::string district, std::string municipality, std::string mainLine,
                std::list<std::string> townships)
-        : id(id), district(district), municipality(municipality), main_line(mainLine), townships(townships) {}
+        : table(&table),
+          station(table.add(move(id), move(district), move(municipality), move(mainLine), move(townships))) {}
 
-Vertex::Vertex(std::string id) : id(id) {}
+Vertex::Vertex(StationTable &table, std::string id) : table(&table), station(table.add(move(id), "", "", "", {})) {}
 
 
 /*
@@ -52,40 +53,44 @@ void Vertex::removeOutgoingEdges() {
     }
 }
 
-bool Vertex::operator<(Vertex & vertex) const {
-    return this->price < vertex.price;
+const string &Vertex::getId() const {
+    return table->getAttributes(station).name;
 }
 
-string Vertex::getId() const {
-    return this->id;
+int Vertex::getStation() const {
+    return this->station;
 }
 
-string Vertex::getLine() const {
-    return this->main_line;
+const StationTable &Vertex::getStationTable() const {
+    return *this->table;
 }
 
-string Vertex::getMunicipality() const {
-    return this->municipality;
+const string &Vertex::getLine() const {
+    return table->getAttributes(station).line;
 }
 
-string Vertex::getDistrict() const {
-    return this->district;
+const string &Vertex::getMunicipality() const {
+    return table->getAttributes(station).municipality;
 }
 
-std::vector<Edge*> Vertex::getAdj() const {
-    return this->adj;
+const string &Vertex::getDistrict() const {
+    return table->getAttributes(station).district;
 }
 
-bool Vertex::isVisited() const {
-    return this->visited;
+const list<string> &Vertex::getTownships() const {
+    return table->getAttributes(station).townships;
 }
 
-bool Vertex::isProcessing() const {
-    return this->processing;
+int Vertex::getRegionId(enum region r) const {
+    return table->getRegionId(station, r);
+}
+
+std::vector<Edge*> Vertex::getAdj() const {
+    return this->adj;
 }
 
-Edge *Vertex::getPath() const {
-    return this->path;
+bool Vertex::isVisited() const {
+    return this->visited;
 }
 
 std::vector<Edge *> Vertex::getIncoming() const {
@@ -96,20 +101,12 @@ void Vertex::setVisited(bool visited) {
     this->visited = visited;
 }
 
-void Vertex::setProcesssing(bool processing) {
-    this->processing = processing;
-}
-
-void Vertex::setPath(Edge *path) {
-    this->path = path;
-}
-
 void Vertex::deleteEdge(Edge *edge) {
     Vertex *dest = edge->getDest();
     // Remove the corresponding edge from the incoming list
     auto it = dest->incoming.begin();
     while (it != dest->incoming.end()) {
-        if ((*it)->getOrig()->getId() == id) {
+        if ((*it)->getOrig()->getId() == getId()) {
             it = dest->incoming.erase(it);
         }
         else {
@@ -119,22 +116,6 @@ void Vertex::deleteEdge(Edge *edge) {
     delete edge;
 }
 
-int Vertex::getPrice() const {
-    return price;
-}
-
-void Vertex::setPrice(int price) {
-    this->price = price;
-}
-
-bool Vertex::getInQueue() const {
-    return inQueue;
-}
-
-void Vertex::setInQueue(bool inQueue) {
-    this->inQueue = inQueue;
-}
-
 bool Vertex::operator==(const Vertex &v) {
     return this->getId() == v.getId();
 }
@@ -165,17 +146,17 @@ void Vertex::setDisabledFlow(int disabledFlow) {
 }
 
 int Vertex::getComponent() const {
-    return component;
+    return table->getComponent(station);
 }
 
 void Vertex::setComponent(int component) {
-    this->component = component;
+    table->setComponent(station, component);
 }
 
 /********************** Edge  ****************************/
 
 
-Edge::Edge(Vertex *orig, Vertex *dest, double w): orig(orig), dest(dest), capacity(w) {disabled = false;}
+Edge::Edge(Vertex *orig, Vertex *dest, double w): orig(orig), dest(dest), capacity(w) {}
 
 Vertex * Edge::getDest() const {
     return this->dest;
@@ -202,10 +183,6 @@ int Edge::getService() const {
     return this->service;
 }
 
-bool Edge::getDisabled() const {
-    return this->disabled;
-}
-
 
 void Edge::setReverse(Edge *reverse) {
     this->reverse = reverse;
@@ -219,16 +196,3 @@ void Edge::setService(enum service s) {
     this->service = s;
 }
 
-
-void Edge::setDisabled(bool disabled) {
-    this->disabled = disabled;
-}
-
-bool Edge::getVisited() const {
-    return visited;
-}
-
-void Edge::setVisited(bool visited) {
-    this->visited = visited;
-}
-
@@ -9,6 +9,7 @@
 #include <queue>
 #include <limits>
 #include <algorithm>
+#include "StationTable.h"
 
 using namespace std;
 
@@ -23,26 +24,37 @@ public:
 
     /**
      * Constructor for the Vertex class;
+     * @param table - the station table of the graph the vertex belongs to (see Graph::getStationTable);
      * @param id - the id of the vertex;
      */
-    Vertex(string id);
+    Vertex(StationTable &table, string id);
 
     /**
      * Constructor for the Vertex class;
+     * @param table - the station table of the graph the vertex belongs to (see Graph::getStationTable);
      * @param id - the id of the vertex;
      * @param district - the district of the vertex;
      * @param municipality - the municipality of the vertex;
      * @param mainLine - the main line of the vertex;
      * @param townships - the townships of the vertex;
      */
-    Vertex(string id, string district, string municipality, string mainLine,
+    Vertex(StationTable &table, string id, string district, string municipality, string mainLine,
            list<string> townships);
-    bool operator<(Vertex & vertex) const; // // required by MutablePriorityQueue
 
     /**
      * Returns the id of the vertex;
      */
-    string getId() const;
+    const string &getId() const;
+
+    /**
+     * Returns the id of the station of the vertex in the station table;
+     */
+    int getStation() const;
+
+    /**
+     * Returns the station table that keeps the attributes of the vertex;
+     */
+    const StationTable &getStationTable() const;
 
     /**
      * Returns a vector containing all the adjacent edges of the vertex;
@@ -52,37 +64,35 @@ public:
     /**
      * Returns the line of the vertex;
      */
-    string getLine() const;
+    const string &getLine() const;
 
     /**
      * Returns the district of the vertex;
      */
-    string getDistrict() const;
+    const string &getDistrict() const;
 
     /**
      * Returns the municipality of the vertex;
      */
-    string getMunicipality() const;
+    const string &getMunicipality() const;
 
     /**
-     * Checks if the vertex is visited;
-     * @return true - if the vertex is visited;
-     *         false - if the vertex is not visited;
+     * Returns the townships of the vertex;
      */
-    bool isVisited() const;
+    const list<string> &getTownships() const;
 
     /**
-     * Checks if the vertex is being processed;
-     * @return true - if the vertex is being processed;
-     *         false - if the vertex is not being processed;
+     * Returns the id of the line, municipality or district of the vertex, the same for every vertex of that region;
+     * @param r - the kind of region;
      */
-    bool isProcessing() const;
+    int getRegionId(enum region r) const;
 
     /**
-     * Retrieves the price of the vertex;
-     * @return the price of the vertex;
+     * Checks if the vertex is visited;
+     * @return true - if the vertex is visited;
+     *         false - if the vertex is not visited;
      */
-    int getPrice() const;
+    bool isVisited() const;
 
     /**
      * Retrieves the flow of the vertex;
@@ -91,24 +101,11 @@ public:
     int getFlow() const;
 
     /**
-     * Checks if the vertex is in the queue;
-     * @return true - if the vertex is in the queue;
-     *         false - if the vertex is not in the queue;
+     * Retrieves the max flow that reaches the vertex;
+     * @return the max flow of the vertex;
      */
     int getMaxFlow() const;
 
-    /**
-     * Gets the attribute inQueue;
-     * @return the vertex's inQueue;
-     */
-    bool getInQueue() const;
-
-    /**
-     * Retrieves the path of the vertex;
-     * @return the edge path of the vertex;
-     */
-    Edge *getPath() const;
-
     /**
      * Retrieves the incoming edges of the vertex;
      * @return a vector containing all the incoming edges of the vertex;
@@ -122,37 +119,14 @@ public:
      */
     void setVisited(bool visited);
 
-    /**
-     * Sets the processing attribute of the vertex;
-     * @param processing - true if the vertex is being processed, false if otherwise;
-     */
-    void setProcesssing(bool processing);
-
-    /**
-     * Sets the price attribute of the vertex;
-     * @param price - the price of the vertex;
-     */
-    void setPrice(int price);
-
     /**
      * Sets the flow attribute of the vertex;
      * @param flow - the flow of the vertex;
      */
     void setFlow(int flow);
 
-    /**
-     * Sets the inQueue attribute of the vertex;
-     * @param inQueue - true if the vertex is in the queue, false if otherwise;
-     */
-    void setInQueue(bool inQueue);
     void setMaxFlow(int maxFlow);
 
-    /**
-     * Sets the path attribute of the vertex;
-     * @param path - the edge path of the vertex;
-     */
-    void setPath(Edge *path);
-
     /**
      * Adds an edge from the vertex (this) to the destination vertex, with a given weight;
      * @param dest - the destination vertex;
@@ -199,23 +173,16 @@ public:
      */
     void setComponent(int component);
 
+    friend class MemoryFootprint; /**< Measures the memory used by the station */
+
 protected:
-    string id; /**< The id of the vertex */
+    StationTable *table; /**< Station table of the graph, which keeps the name, region and townships of the station */
+    int station; /**< Id of the station in the station table */
     vector<Edge *> adj; /**< The adjacency vector of the vertex */
 
     // auxiliary fields
-    bool visited = false; /**< Visited state of the vertex */  // used by DFS, BFS, Prim ...
-    // used by Dijkstra
-    bool processing = false;  /**< Processing state of the vertex */
-    int price = 0; /**< Price of the vertex */
+    bool visited = false; /**< Visited state of the vertex */
     int flow = 0; /**< Flow of the vertex */
-    bool inQueue; /**< InQueue state of the vertex */
-    int component;
-
-protected:
-    Edge *path = nullptr; /**< Edge path of the vertex */
-    string name = id, district, municipality, main_line; /**< Name (id), district, municipality and main line of the vertex */
-    list<string> townships; /**< Townships list of the vertex */
     int maxFlow; /**< Vertex's max flow */
     int disabledFlow; /**< Vertex's disabled flow */
 
@@ -279,27 +246,6 @@ public:
      */
     int getService() const;
 
-    /**
-     * Checks if the edge is disabled;
-     * @return true - if the edge is disabled;
-     *         false - if the edge is not disabled;
-     */
-    bool getDisabled() const;
-
-    /**
-     * Checks if the edge is visited;
-     * @return true - if the edge is visited;
-     *         false - if the edge is not visited;
-     */
-    bool getVisited() const;
-
-
-    /**
-     * Sets the visited attribute of the edge;
-     * @param visited - true if the edge is visited, false if otherwise;
-     */
-    void setVisited(bool visited);
-
     /**
      * Sets the reverse attribute of the edge;
      * @param reverse - the reverse edge of the edge;
@@ -318,20 +264,12 @@ public:
      */
     void setService(enum service s);
 
-    /**
-     * Sets the disabled attribute of the edge;
-     * @param disabled - true if the edge is disabled, false if otherwise;
-     */
-    void setDisabled(bool disabled);
+    friend class MemoryFootprint; /**< Measures the memory used by the segment */
+
 protected:
     Vertex * dest; /**< Destination vertex of the edge */
     double capacity; /**< Capacity, or weight, of the edge */
 
-    // auxiliary fields
-    bool selected = false; /**< Selected state of the edge */
-    bool disabled = false; /**< Disabled state of the edge */
-    bool visited = false; /**< Visited state of the edge */
-
     // used for bidirectional edges
     Vertex *orig; /**< Origin vertex of the edge */
     Edge *reverse = nullptr; /**< Reverse edge of the edge */
@@ -10,8 +10,17 @@
 
 
 int main(){
-    Program p;
-    p.run();
+    Trace::setThreadName("main");
+    {
+        Program p;
+        p.run();
+    }
+
+    if (Metrics::hasLatencies()) {
+        cout << endl << "Latencies of this session:" << endl << endl;
+        Metrics::printLatencies(cout);
+    }
+    Trace::write();
 
     return 0;
 }
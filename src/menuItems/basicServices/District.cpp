@@ -35,29 +35,18 @@ void District::execute() {
     }
 
     paginationController(aux);
-
-    for(auto n : railway->getVertexSet()){
-        n.second->setVisited(false);
-    }
 }
 
 
 
 void District::districtFind(){
+    METRIC_LATENCY(REGION_TOP_K_QUERY);
     for(auto n : railway->getVertexSet()){
         n.second->setFlow(0);
     }
-    auto extremesDistrict = railway->getExtremesDistricts();
-    for (auto v1: extremesDistrict) {
-        for (auto v2: extremesDistrict) {
-            if (v1->getDistrict() == v2->getDistrict() && v1->getId() < v2->getId()) {
-                int flow = railway->getDistrictMaxFlow(v1, v2);
-                if(v2->getFlow() < flow){
-                    v2->setFlow(flow);
-                }
-            }
-        }
-    }
+    pool->setProgressCallback(drawProgress);
+    RegionSolver solver(*railway, DISTRICTS);
+    solver.solveExtremePairs(railway->getExtremesDistricts(), *pool);
     auto ConnectedDistricts = connectedComponents();
     for (auto cc : ConnectedDistricts){
         if(district_map.count(cc.first) == 0){
@@ -71,43 +60,9 @@ void District::districtFind(){
 
 
 map<string,vector<int>> District::connectedComponents() {
-    map<string,vector<int>> flows;
-    flows.clear();
-    for(auto v : railway->getVertexSet()){
-        v.second->setVisited(false);
-    }
-
-    for(const auto& v : railway->getVertexSet()){
-        int flow = 0;
-        if(!v.second->isVisited()){
-            dfs(v.second, flow);
-        }
-
-        if (flows.count(v.second->getDistrict()) == 0){
-            flows[v.second->getDistrict()] = vector<int>();
-        }
-        if (flow > 0){
-            flows[v.second->getDistrict()].push_back(flow);
-        }
-    }
-
-    return flows;
+    return RegionSolver::getComponentFlows(*railway, DISTRICTS);
 }
 
-void District::dfs(Vertex* n, int &flow) {
-    n->setVisited(true);
-    for(auto e : n->getAdj()){
-        auto w = e->getDest();
-        if(n->getDistrict() != w->getDistrict()){
-            continue;
-        }
-        if(w->getFlow() > flow){
-            flow = w->getFlow();
-        }
-        if(!w->isVisited()){
-            dfs(w, flow);
-        }
-    }
+District::District(int &currMenuPage, Graph &railway, WorkStealingPool &pool) :  MenuItem(currMenuPage, railway) {
+    this->pool = &pool;
 }
-
-District::District(int &currMenuPage, Graph &railway) :  MenuItem(currMenuPage, railway) {}
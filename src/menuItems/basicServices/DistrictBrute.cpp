@@ -37,30 +37,18 @@ void DistrictBrute::execute() {
     }
 
     paginationController(aux);
-
-    for(auto n : railway->getVertexSet()){
-        n.second->setVisited(false);
-    }
 }
 
 
 
 void DistrictBrute::districtFind(){
+    METRIC_LATENCY(REGION_TOP_K_QUERY);
     for(auto n : railway->getVertexSet()){
         n.second->setFlow(0);
     }
-    for (auto v1: railway->getVertexSet()) {
-        for (auto v2: railway->getVertexSet()) {
-            if (v1.second->getDistrict() == v2.second->getDistrict() && v1.first != v2.first) {
-                if(v1.first < v2.first){
-                    int flow = railway->getDistrictMaxFlow(v1.second, v2.second);
-                    if(v2.second->getFlow() < flow){
-                        v2.second->setFlow(flow);
-                    }
-                }
-            }
-        }
-    }
+    pool->setProgressCallback(drawProgress);
+    RegionSolver solver(*railway, DISTRICTS);
+    solver.solveAllPairs(*pool);
     auto ConnectedDistricts = connectedComponents();
     for (auto cc : ConnectedDistricts){
         if(district_map.count(cc.first) == 0){
@@ -74,43 +62,9 @@ void DistrictBrute::districtFind(){
 
 
 map<string,vector<int>> DistrictBrute::connectedComponents() {
-    map<string,vector<int>> flows;
-    flows.clear();
-    for(auto v : railway->getVertexSet()){
-        v.second->setVisited(false);
-    }
-
-    for(auto v : railway->getVertexSet()){
-        int flow = 0;
-        if(!v.second->isVisited()){
-            dfs(v.second, flow);
-        }
-
-        if (flows.count(v.second->getDistrict()) == 0){
-            flows[v.second->getDistrict()] = vector<int>();
-        }
-        if (flow > 0){
-            flows[v.second->getDistrict()].push_back(flow);
-        }
-    }
-
-    return flows;
+    return RegionSolver::getComponentFlows(*railway, DISTRICTS);
 }
 
-void DistrictBrute::dfs(Vertex* n, int &flow) {
-    n->setVisited(true);
-    for(auto e : n->getAdj()){
-        auto w = e->getDest();
-        if(n->getDistrict() != w->getDistrict()){
-            continue;
-        }
-        if(w->getFlow() > flow){
-            flow = w->getFlow();
-        }
-        if(!w->isVisited()){
-            dfs(w, flow);
-        }
-    }
+DistrictBrute::DistrictBrute(int &currMenuPage, Graph &railway, WorkStealingPool &pool) :  MenuItem(currMenuPage, railway) {
+    this->pool = &pool;
 }
-
-DistrictBrute::DistrictBrute(int &currMenuPage, Graph &railway) :  MenuItem(currMenuPage, railway) {}
@@ -2,19 +2,24 @@
 #define PROJECT_RAILWAY_DISTRICTBRUTE_H
 #include <map>
 #include "graph/Graph.h"
+#include "graph/RegionSolver.h"
 #include "menuItems/general/MenuItem.h"
 #include "utils.h"
+#include "parallel/WorkStealingPool.h"
+#include "metrics/Metrics.h"
 
 class DistrictBrute: public MenuItem {
     map<string , int> district_map; /**< Map of districts and their respective ids */
+    WorkStealingPool *pool; /**< Pool shared by the analyses of the program */
 public:
 
     /**
      * Constructor
      * @param currMenuPage - The current menu page
      * @param gh - The railway graph
+     * @param pool - The pool shared by the analyses of the program
      */
-    DistrictBrute(int &currMenuPage, Graph &gh);
+    DistrictBrute(int &currMenuPage, Graph &gh, WorkStealingPool &pool);
 
     /**
      * Runs the districtFind() function and draws a simple paginated menu to display all the districts and their respective flows;
@@ -23,23 +28,16 @@ public:
 
     /**
      * Finds the connected components of the graph based on the district of the vertices and calculates the max flow of each component;
-     * Time Complexity: O(V(V+E)), where V is the number of vertices in the graph and E is the number of edges in the graph;
+     * Time Complexity: O(V*log(V) + E), where V is the number of vertices in the graph and E is the number of edges in the graph;
      * @return a map of the districts and their respective max flows;
      */
     map<string,vector<int>> connectedComponents();
 
-    /**
-     * Applies a DFS to the graph, starting at the vertex n, and returns the maximum flow of the graph;
-     * Time Complexity: O(V+E), where V is the number of vertices in the graph and E is the number of edges in the graph;
-     * @param n - the vertex to start the DFS
-     * @param flow - the maximum flow of the graph
-     */
-    void dfs(Vertex *n, int &flow);
-
     /**
      * Calculates the maximum flow for each possible vertex pair of a certain district and stores it in the vertex's flow attribute;
      * After that, it calls the connectedComponents() function to calculate the maximum flow of each district;
-     * Time Complexity: O(V*E²*P), where V is the number of vertices in the graph, E is the number of edges in the graph and P is the number of possible vertex pairs;
+     * The flows of all pairs of a district are read from a Gomory-Hu tree of its subgraph, one district per task;
+     * Time Complexity: O(V + Σ R²*F² / T), where, for each district, R is the number of stations and F the number of segments, and T is the number of threads;
      */
     void districtFind();
 };
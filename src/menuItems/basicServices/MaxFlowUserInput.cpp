@@ -13,10 +13,15 @@ void MaxFlowUserInput::execute() {
     cout << "\033[34mInsert the name of the destination station: " << "\033[0m";
     fetchStation(&dest,railway);
 
-    auto flow = railway->getMaxFlow(orig, dest);
+    FlowNetwork network(*railway);
+    FlowResult result;
+    {
+        METRIC_LATENCY(MAX_FLOW_QUERY);
+        result = network.getMaxFlow(network.indexOf(orig), network.indexOf(dest));
+    }
+    network.applyFlow(result.flow);
+
     drawResults();
-    drawFlow(flow);
-    vector<Vertex*> vertexes;
-    vertexes.push_back(orig);
-    drawFooter(railway->fetchUsedEdges(vertexes));
+    drawFlow(result.value);
+    drawFooter(network.getUsedEdges(result));
 }
\ No newline at end of file
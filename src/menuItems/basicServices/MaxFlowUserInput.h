@@ -4,6 +4,7 @@
 #include "graph/Graph.h"
 #include "menuItems/general/MenuItem.h"
 #include "utils.h"
+#include "metrics/Metrics.h"
 using namespace std;
 
 
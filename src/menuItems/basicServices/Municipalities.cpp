@@ -36,31 +36,18 @@ void Municipalities::execute() {
     }
 
     paginationController(aux);
-
-    for(auto n : railway->getVertexSet()){
-        n.second->setVisited(false);
-    }
 }
 
 
 void Municipalities::municipalitiesFind(){
+    METRIC_LATENCY(REGION_TOP_K_QUERY);
     for(auto n : railway->getVertexSet()){
         n.second->setFlow(0);
     }
 
-    auto extremesMun = railway->getExtremesMunicipalities();
-    for (auto v1: extremesMun) {
-        for (auto v2: extremesMun) {
-            if (v1->getMunicipality() == v2->getMunicipality() && v1->getId() != v2->getId()) {
-                if(v1->getId() < v2->getId()){
-                    int flow = railway->getMunMaxFlow(v1, v2);
-                    if(v2->getFlow() < flow){
-                        v2->setFlow(flow);
-                    }
-                }
-            }
-        }
-    }
+    pool->setProgressCallback(drawProgress);
+    RegionSolver solver(*railway, MUNICIPALITIES);
+    solver.solveExtremePairs(railway->getExtremesMunicipalities(), *pool);
     auto ConnectedMunicipalities = connectedComponents();
     for (auto cc : ConnectedMunicipalities){
         if(mun_map.count(cc.first) == 0){
@@ -73,42 +60,9 @@ void Municipalities::municipalitiesFind(){
 }
 
 map<string,vector<int>> Municipalities::connectedComponents() {
-    map<string,vector<int>> flows;
-    flows.clear();
-    for(auto v : railway->getVertexSet()){
-        v.second->setVisited(false);
-    }
-
-    for(auto v : railway->getVertexSet()){
-        int flow = 0;
-        if(!v.second->isVisited()){
-            dfs(v.second, flow);
-        }
-        if (flows.count(v.second->getMunicipality()) == 0){
-            flows[v.second->getMunicipality()] = vector<int>();
-        }
-        if (flow > 0){
-            flows[v.second->getMunicipality()].push_back(flow);
-        }
-    }
-
-    return flows;
+    return RegionSolver::getComponentFlows(*railway, MUNICIPALITIES);
 }
 
-void Municipalities::dfs(Vertex* n, int &flow) {
-    n->setVisited(true);
-    for(auto e : n->getAdj()){
-        auto w = e->getDest();
-        if(n->getMunicipality() != w->getMunicipality()){
-            continue;
-        }
-        if(w->getFlow() > flow){
-            flow = w->getFlow();
-        }
-        if(!w->isVisited()){
-            dfs(w, flow);
-        }
-    }
+Municipalities::Municipalities(int &currMenuPage, Graph &railway, WorkStealingPool &pool) :  MenuItem(currMenuPage, railway) {
+    this->pool = &pool;
 }
-
-Municipalities::Municipalities(int &currMenuPage, Graph &railway) :  MenuItem(currMenuPage, railway) {}
@@ -36,30 +36,18 @@ void MunicipalitiesBrute::execute() {
     }
 
     paginationController(aux);
-
-    for(auto n : railway->getVertexSet()){
-        n.second->setVisited(false);
-    }
 }
 
 
 void MunicipalitiesBrute::municipalitiesFind(){
+    METRIC_LATENCY(REGION_TOP_K_QUERY);
     for(auto n : railway->getVertexSet()){
         n.second->setFlow(0);
     }
 
-    for (auto v1: railway->getVertexSet()) {
-        for (auto v2: railway->getVertexSet()) {
-            if (v1.second->getMunicipality() == v2.second->getMunicipality() && v1.first != v2.first) {
-                if(v1.first < v2.first){
-                    int flow = railway->getMunMaxFlow(v1.second, v2.second);
-                    if(v2.second->getFlow() < flow){
-                        v2.second->setFlow(flow);
-                    }
-                }
-            }
-        }
-    }
+    pool->setProgressCallback(drawProgress);
+    RegionSolver solver(*railway, MUNICIPALITIES);
+    solver.solveAllPairs(*pool);
     auto ConnectedMunicipalities = connectedComponents();
     for (auto cc : ConnectedMunicipalities){
         if(mun_map.count(cc.first) == 0){
@@ -72,42 +60,9 @@ void MunicipalitiesBrute::municipalitiesFind(){
 }
 
 map<string,vector<int>> MunicipalitiesBrute::connectedComponents() {
-    map<string,vector<int>> flows;
-    flows.clear();
-    for(auto v : railway->getVertexSet()){
-        v.second->setVisited(false);
-    }
-
-    for(auto v : railway->getVertexSet()){
-        int flow = 0;
-        if(!v.second->isVisited()){
-            dfs(v.second, flow);
-        }
-        if (flows.count(v.second->getMunicipality()) == 0){
-            flows[v.second->getMunicipality()] = vector<int>();
-        }
-        if (flow > 0){
-            flows[v.second->getMunicipality()].push_back(flow);
-        }
-    }
-
-    return flows;
+    return RegionSolver::getComponentFlows(*railway, MUNICIPALITIES);
 }
 
-void MunicipalitiesBrute::dfs(Vertex* n, int &flow) {
-    n->setVisited(true);
-    for(auto e : n->getAdj()){
-        auto w = e->getDest();
-        if(n->getMunicipality() != w->getMunicipality()){
-            continue;
-        }
-        if(w->getFlow() > flow){
-            flow = w->getFlow();
-        }
-        if(!w->isVisited()){
-            dfs(w, flow);
-        }
-    }
+MunicipalitiesBrute::MunicipalitiesBrute(int &currMenuPage, Graph &railway, WorkStealingPool &pool) :  MenuItem(currMenuPage, railway) {
+    this->pool = &pool;
 }
-
-MunicipalitiesBrute::MunicipalitiesBrute(int &currMenuPage, Graph &railway) :  MenuItem(currMenuPage, railway) {}
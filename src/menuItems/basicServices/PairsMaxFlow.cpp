@@ -1,25 +1,105 @@
 
 #include "PairsMaxFlow.h"
+#include <atomic>
+#include <mutex>
 
-PairsMaxFlow::PairsMaxFlow(int &currMenuPage, Graph &railway) : MenuItem(currMenuPage, railway){}
+PairsMaxFlow::PairsMaxFlow(int &currMenuPage, Graph &railway, WorkStealingPool &pool) : MenuItem(currMenuPage, railway){
+    this->pool = &pool;
+}
 
 
+void PairsMaxFlow::solvePairs(const FlowNetwork &network, int topK) {
+    METRIC_LATENCY(MAX_FLOW_QUERY);
+    auto extremeSet = railway->getExtremes();
+    vector<Vertex*> extremes(extremeSet.begin(), extremeSet.end());
+    sort(extremes.begin(), extremes.end(), [](Vertex *v1, Vertex *v2) {
+        return v1->getId() < v2->getId();
+    });
+
+    vector<pair<pair<Vertex*, Vertex*>, int>> pairs;
+    for (size_t i = 0; i < extremes.size(); i++) {
+        for (size_t j = i + 1; j < extremes.size(); j++) {
+            pairs.push_back({{extremes[i], extremes[j]}, 0});
+        }
+    }
+
+    // Candidates are solved by decreasing upper bound
+    PairUpperBounds bounds(network);
+    vector<int> bound(pairs.size());
+    vector<size_t> candidates(pairs.size());
+    for (size_t i = 0; i < pairs.size(); i++) {
+        bound[i] = bounds.getBound(network.indexOf(pairs[i].first.first), network.indexOf(pairs[i].first.second));
+        candidates[i] = i;
+    }
+    stable_sort(candidates.begin(), candidates.end(), [&bound](size_t i, size_t j) {
+        return bound[i] > bound[j];
+    });
+
+    pool->setProgressCallback(drawProgress);
+    vector<FlowWorkspace> workspaces(pool->getThreadCount());
+    vector<FlowResult> flows(pairs.size());
+    vector<char> solved(pairs.size(), false);
+    priority_queue<int, vector<int>, greater<int>> topFlows; // the k highest flows found so far
+    mutex topLock;
+    atomic<int> kthBest(0); // lower bound of the top-k flows, pairs bounded below it can't enter the top
+    atomic<int> best(0);
+    atomic<size_t> cursor(0), solvedCount(0);
+
+    // Every task takes the next candidate, so the pairs start by decreasing bound whichever worker runs them
+    pool->parallelFor(candidates.size(), [&](size_t, unsigned worker) {
+        size_t c = candidates[cursor++];
+        auto &pa = pairs[c];
+        if (topK > 0 && bound[c] < kthBest.load()) return;
+
+        if (bound[c] > 0) {
+            auto &ws = workspaces[worker];
+            pa.second = network.maxFlow(network.indexOf(pa.first.first), network.indexOf(pa.first.second), ws);
+
+            // Only the flows that can still be the highest are kept for the detailed output
+            int current = best.load();
+            while (pa.second > current && !best.compare_exchange_weak(current, pa.second));
+            if (pa.second >= current)
+                flows[c] = network.getResult(ws);
+        }
+        solved[c] = true;
+        solvedCount++;
+
+        if (topK > 0) {
+            lock_guard<mutex> guard(topLock);
+            topFlows.push(pa.second);
+            if ((int) topFlows.size() > topK) topFlows.pop();
+            if ((int) topFlows.size() == topK) kthBest = topFlows.top();
+        }
+    });
+    solvedPairs = solvedCount;
+
+    vector<size_t> order;
+    for (size_t i = 0; i < pairs.size(); i++)
+        if (solved[i]) order.push_back(i);
+    stable_sort(order.begin(), order.end(), [&pairs](size_t i, size_t j) {
+        return sortResultVector(pairs[i], pairs[j]);
+    });
+
+    result_vector.clear();
+    result_flows.clear();
+    for (size_t i: order) {
+        result_vector.push_back(pairs[i]);
+        result_flows.push_back(pairs[i].second == best.load() ? move(flows[i]) : FlowResult());
+        // Pairs bounded at 0 are not solved, but their empty flow is still shown when no pair has a higher one
+        if (pairs[i].second == best.load() && result_flows.back().flow.empty())
+            result_flows.back().flow.assign(network.getArcCount(), 0);
+    }
+    totalPairs = pairs.size();
+}
+
 void PairsMaxFlow::execute() {
     cin.ignore(2000, '\n');
     system("clear");
-    auto extremes = railway->getExtremes();
-    result_vector.clear();
-    int flow = 0;
-    for (auto v1: extremes){
-        for (auto v2: extremes){
-            if (v1->getId() < v2->getId()){
-                pair<Vertex*, Vertex*> insidePair = {v1, v2};
-                flow = railway->getMaxFlow(v1, v2);
-                this->result_vector.emplace_back(insidePair, flow);
-            }
-        }
-    }
-    std::sort(result_vector.begin(), result_vector.end(), sortResultVector);
+
+    FlowNetwork network(*railway);
+    solvePairs(network, 1);
+
+    if (result_vector.empty()) return;
 
     drawResults();
     drawFlow(result_vector[0].second);
@@ -31,5 +111,5 @@ void PairsMaxFlow::execute() {
         if (pa.second == result_vector[0].second) cout << "|\033[100m   -->   " << s << string(36 - getLen(s), ' ') << "\033[0m|\n";
     }
 
-    drawFooterCombinations(result_vector, railway);
-}
\ No newline at end of file
+    drawFooterCombinations(result_vector, result_flows, network);
+}
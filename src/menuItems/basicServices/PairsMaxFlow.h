@@ -2,27 +2,48 @@
 #define PROJECT_RAILWAY_PAIRSMAXFLOW_H
 
 #include "graph/Graph.h"
+#include "graph/FlowNetwork.h"
+#include "graph/PairUpperBounds.h"
 #include "menuItems/general/MenuItem.h"
+#include "parallel/WorkStealingPool.h"
 #include <iomanip>
 #include "utils.h"
+#include "metrics/Metrics.h"
 
 using namespace std;
 
 
 class PairsMaxFlow : public MenuItem{
-private:
+protected:
     vector<pair<pair<Vertex*, Vertex*>, int>> result_vector; /**< Vector containing the pairs of stations and their max flow*/
+    vector<FlowResult> result_flows; /**< Flow and min cut of the pairs of result_vector with the highest max flow (empty for the others) */
+    size_t solvedPairs = 0; /**< Number of pairs whose max flow was calculated by the last search */
+    size_t totalPairs = 0; /**< Number of pairs of extremes considered by the last search */
+    WorkStealingPool *pool; /**< Pool shared by the analyses of the program */
+
+    /**
+     * Branch-and-bound search for the pairs of extremes with the highest max flow. Pairs are solved in parallel, by
+     * decreasing upper bound (see PairUpperBounds), in a single run of the pool, and a pair is skipped when the k-th best flow
+     * found so far is already higher than its bound, so the top-k pairs (and every pair tied with the k-th) are exactly the ones an
+     * exhaustive search would find. Fills result_vector with the solved pairs sorted by decreasing flow (pairs with the
+     * same flow keep the alphabetical order of their stations);
+     * Time Complexity: O(V*E²*P/T), where V is the number of vertices, E is the number of edges, P is the number of pairs and T the number of threads.
+     * @param network - snapshot of the railway graph
+     * @param topK - number of pairs needed (0 solves every pair)
+     */
+    void solvePairs(const FlowNetwork &network, int topK);
 public:
     /**
      * Constructor
      * @param currMenuPage - The current menu page
      * @param gh - The railway graph
+     * @param pool - The pool shared by the analyses of the program
      */
-    PairsMaxFlow(int &currMenuPage, Graph &gh);
+    PairsMaxFlow(int &currMenuPage, Graph &gh, WorkStealingPool &pool);
 
     /**
      * Calculates the max flow between all possible pairs of stations belonging to the extremes vector;
-     * Time Complexity: O(V*E²*P), where V is the number of vertices, E is the number of edges and P is the number of extreme vertices.
+     * Time Complexity: O(V*E²*P/T), where V is the number of vertices, E is the number of edges, P is the number of extreme vertices and T the number of threads.
      */
     void execute() override;
 };
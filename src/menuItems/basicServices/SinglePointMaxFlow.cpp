@@ -5,27 +5,22 @@ SinglePointMaxFlow::SinglePointMaxFlow(int &currMenuPage, Graph &railway) : Menu
 void SinglePointMaxFlow::execute() {
     system("clear");
     Vertex *dest = nullptr;
-    auto vertexSet = railway->getVertexSet();
-    auto extremes = railway->getExtremes();
-    int flow;
 
     cin.ignore(2000, '\n');
 
     cout << "\033[34mInsert the name of the destination station: " << "\033[0m";
     fetchStation(&dest,railway);
 
-    Vertex *superSource = railway->addSuperSource(dest);
-
-    // running maxflow on super node to destiny
-    flow = railway->getMaxFlow(superSource, dest);
-
-    railway->removeSuperSource(superSource);
+    // running maxflow from a super source connected to every extreme to the destination
+    FlowNetwork network(*railway, railway->getExtremes());
+    FlowResult result;
+    {
+        METRIC_LATENCY(SINGLE_POINT_QUERY);
+        result = network.getMaxFlow(network.getSuperSource(), network.indexOf(dest));
+    }
+    network.applyFlow(result.flow);
 
     drawResults();
-    drawFlow(flow);
-    vector<Vertex*> vertexes;
-    for (auto e: extremes){
-        if (e != dest) vertexes.push_back(e);
-    }
-    drawFooter(railway->fetchUsedEdges(vertexes));
+    drawFlow(result.value);
+    drawFooter(network.getUsedEdges(result));
 }
\ No newline at end of file
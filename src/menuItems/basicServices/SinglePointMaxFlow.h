@@ -4,6 +4,7 @@
 
 #include "menuItems/general/MenuItem.h"
 #include "utils.h"
+#include "metrics/Metrics.h"
 
 class SinglePointMaxFlow : public MenuItem{
 private:
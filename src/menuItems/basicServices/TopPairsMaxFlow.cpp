@@ -0,0 +1,40 @@
+#include "TopPairsMaxFlow.h"
+
+TopPairsMaxFlow::TopPairsMaxFlow(int &currMenuPage, Graph &railway, WorkStealingPool &pool) : PairsMaxFlow(currMenuPage, railway, pool) {}
+
+void TopPairsMaxFlow::execute() {
+    system("clear");
+    size_t nExtremes = railway->getExtremes().size();
+    int nPairs = nExtremes * (nExtremes - 1) / 2;
+
+    if (nPairs == 0) return;
+
+    int topK = 0;
+    bool is_valid = false;
+
+    while(!is_valid){
+        cout << "\033[34mInsert the number of pairs that will be displayed [1-" << nPairs << "]: " << "\033[0m";
+        getInput(topK);
+
+        if (topK <= 0 || topK > nPairs){
+            cout << endl;
+            cout << "\033[31m - Invalid input - " << "\033[0m";
+            cout << endl;
+            cout << endl;
+            continue;
+        } else {
+            is_valid = true;
+        }
+    }
+
+    FlowNetwork network(*railway);
+    solvePairs(network, topK);
+
+    vector<pair<pair<Vertex*, Vertex*>, int>> aux;
+    for (auto &pa: result_vector) {
+        if ((int) aux.size() >= topK && pa.second < aux.back().second) break;
+        aux.push_back(pa);
+    }
+
+    topPairs(aux);
+}
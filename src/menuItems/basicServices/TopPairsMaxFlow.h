@@ -0,0 +1,25 @@
+#ifndef PROJECT_RAILWAY_TOPPAIRSMAXFLOW_H
+#define PROJECT_RAILWAY_TOPPAIRSMAXFLOW_H
+
+#include "PairsMaxFlow.h"
+
+class TopPairsMaxFlow : public PairsMaxFlow {
+public:
+    /**
+     * Constructor
+     * @param currMenuPage - The current menu page
+     * @param gh - The railway graph
+     * @param pool - The pool shared by the analyses of the program
+     */
+    TopPairsMaxFlow(int &currMenuPage, Graph &gh, WorkStealingPool &pool);
+
+    /**
+     * Asks the user for k and shows the k pairs of extremes with the highest max flow (and the pairs tied with the k-th),
+     * using the branch-and-bound search of PairsMaxFlow;
+     * Time Complexity: O(V*E²*P/T), where V is the number of vertices, E is the number of edges, P is the number of pairs and T the number of threads.
+     */
+    void execute() override;
+};
+
+
+#endif //PROJECT_RAILWAY_TOPPAIRSMAXFLOW_H
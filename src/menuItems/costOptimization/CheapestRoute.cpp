@@ -0,0 +1,37 @@
+#include "CheapestRoute.h"
+
+CheapestRoute::CheapestRoute(int &currMenuPage, Graph &railway) : MenuItem(currMenuPage, railway) {}
+
+void CheapestRoute::execute() {
+    system("clear");
+    Vertex *orig = nullptr, *dest = nullptr;
+
+    cin.ignore(2000, '\n');
+    cout << "\033[34mInsert the name of the origin station: " << "\033[0m";
+    fetchStation(&orig,railway);
+
+    cout << "\033[34mInsert the name of the destination station: " << "\033[0m";
+    fetchStation(&dest,railway);
+
+    FlowNetwork network(*railway);
+    FlowWorkspace ws;
+    int cost = network.cheapestRoute(network.indexOf(orig), network.indexOf(dest), ws);
+
+    if (cost == FlowTraits<int>::infinity()) {
+        cout << "\033[31mStation " << orig->getId() << " can't reach station " << dest->getId()<< "\033[0m" << endl << endl;
+        return;
+    }
+
+    // The route is shown as the flow of a single train
+    vector<int> flow(network.getArcCount(), 0);
+    vector<Edge *> route;
+    for (int a: network.getRoute(network.indexOf(dest), ws)) {
+        flow[a] = 1;
+        route.push_back(network.getEdge(a));
+    }
+    network.applyFlow(flow);
+
+    drawResults();
+    drawCost(cost);
+    drawFooter(route, true);
+}
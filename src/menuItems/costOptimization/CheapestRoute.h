@@ -0,0 +1,28 @@
+#ifndef PROJECT_RAILWAY_CHEAPESTROUTE_H
+#define PROJECT_RAILWAY_CHEAPESTROUTE_H
+
+#include "graph/Graph.h"
+#include "menuItems/general/MenuItem.h"
+#include "utils.h"
+
+class CheapestRoute : public MenuItem {
+public:
+    /**
+     * Constructor
+     * @param currMenuPage - The current menu page
+     * @param railway - The railway graph
+     */
+    CheapestRoute(int &currMenuPage, Graph &railway);
+
+    /**
+     * Asks for user input for the name of both the origin and destination stations and shows the cheapest route between
+     * them for a single train, with its cost
+     * Time Complexity: O(E + V*log(C)), where V is the number of vertices, E is the number of edges and C is the cost of
+     * the route.
+     */
+    void execute() override;
+
+};
+
+
+#endif
@@ -0,0 +1,35 @@
+#include "ExtremeCosts.h"
+#include "graph/CheapestCostMatrix.h"
+
+ExtremeCosts::ExtremeCosts(int &currMenuPage, Graph &railway, WorkStealingPool &pool) : MenuItem(currMenuPage, railway) {
+    this->pool = &pool;
+}
+
+void ExtremeCosts::execute() {
+    system("clear");
+    auto extremeSet = railway->getExtremes();
+    vector<Vertex*> extremes(extremeSet.begin(), extremeSet.end());
+    sort(extremes.begin(), extremes.end(), [](Vertex *v1, Vertex *v2) {
+        return v1->getId() < v2->getId();
+    });
+
+    FlowNetwork network(*railway);
+    vector<int> stations;
+    for (Vertex *v: extremes)
+        stations.push_back(network.indexOf(v));
+
+    pool->setProgressCallback(drawProgress);
+    CheapestCostMatrix matrix(network, stations, *pool);
+
+    vector<pair<pair<Vertex*, Vertex*>, int>> pairs;
+    for (int i = 0; i < matrix.getSize(); i++) {
+        for (int j = i + 1; j < matrix.getSize(); j++) {
+            int cost = matrix.getCost(i, j);
+            if (cost != FlowTraits<int>::infinity())
+                pairs.push_back({{extremes[i], extremes[j]}, cost});
+        }
+    }
+    stable_sort(pairs.begin(), pairs.end(), sortResultVector);
+
+    topPairs(pairs, "Cost");
+}
@@ -0,0 +1,33 @@
+#ifndef PROJECT_RAILWAY_EXTREMECOSTS_H
+#define PROJECT_RAILWAY_EXTREMECOSTS_H
+
+#include "graph/Graph.h"
+#include "menuItems/general/MenuItem.h"
+#include "utils.h"
+#include "parallel/WorkStealingPool.h"
+
+class ExtremeCosts : public MenuItem {
+private:
+    WorkStealingPool *pool; /**< Pool shared by the analyses of the program */
+
+public:
+    /**
+     * Constructor
+     * @param currMenuPage - The current menu page
+     * @param railway - The railway graph
+     * @param pool - The pool shared by the analyses of the program
+     */
+    ExtremeCosts(int &currMenuPage, Graph &railway, WorkStealingPool &pool);
+
+    /**
+     * Calculates the cost of the cheapest route between every pair of line extremes, in parallel, and shows the pairs from
+     * the most expensive to the cheapest
+     * Time Complexity: O(K*(E + V*log(C)) + K²*log(K)), where K is the number of extremes, V is the number of vertices, E
+     * is the number of edges and C is the cost of the most expensive route.
+     */
+    void execute() override;
+
+};
+
+
+#endif
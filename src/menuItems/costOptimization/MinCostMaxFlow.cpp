@@ -5,7 +5,6 @@ MinCostMaxFlow::MinCostMaxFlow(int &currMenuPage, Graph &railway) : MenuItem(cur
 void MinCostMaxFlow::execute() {
     system("clear");
     Vertex *orig = nullptr, *dest = nullptr;
-    int cost, flow;
 
     cin.ignore(2000, '\n');
     cout << "\033[34mInsert the name of the origin station: " << "\033[0m";
@@ -14,22 +13,79 @@ void MinCostMaxFlow::execute() {
     cout << "\033[34mInsert the name of the destination station: " << "\033[0m";
     fetchStation(&dest,railway);
 
-    railway->minCostMaxFlow(orig, dest);
+    if (network == nullptr) {
+        network.reset(new FlowNetwork(*railway));
+        session.reset(new MinCostSession(*network));
+    }
+    scenario.clear();
+
+    while (true) {
+        FlowResult result;
+        {
+            METRIC_LATENCY(MIN_COST_QUERY);
+            session->solve(network->indexOf(orig), network->indexOf(dest), scenario);
+            result = session->getResult();
+        }
+        network->applyFlow(result.flow);
 
-    cost = railway->computeCost(orig);
-    flow = railway->getVertexFlow(dest);
+        if (result.value > 0) {
+            if (session->isWarm())
+                cout << "\033[33mRe-optimized from the last query\033[0m" << endl;
+            drawResults();
+            drawCost(result.cost);
+            drawFlow(result.value);
+            drawFooter(network->getUsedEdges(result), true);
+        }
+        else {
+            cout << "\033[31mStation " << orig->getId() << " can't reach station " << dest->getId()<< "\033[0m" << endl << endl;
+        }
 
-    if (flow > 0) {
-        drawResults();
-        drawCost(cost);
-        drawFlow(flow);
-        vector<Vertex*> vertexes;
-        vertexes.push_back(orig);
-        drawFooter(railway->fetchUsedEdges(vertexes), true);
+        string option;
+        cout << endl << "\033[33mChange the capacity [k] or the cost [c] of a segment, or return [q]: \033[0m";
+        cin >> option;
+        while (option != "k" && option != "K" && option != "c" && option != "C" && option != "q" && option != "Q") {
+            cout << "\033[31mPlease choose k, c or q: \033[0m";
+            cin >> option;
+        }
+
+        if (option == "q" || option == "Q") break;
+        changeSegment(option == "c" || option == "C");
     }
-    else {
-        cout << "\033[31mStation " << orig->getId() << " can't reach station " << dest->getId()<< "\033[0m" << endl << endl;
+}
+
+void MinCostMaxFlow::changeSegment(bool cost) {
+    system("clear");
+    Edge *segment = nullptr;
+
+    cin.ignore(2000, '\n');
+    while (segment == nullptr) {
+        Vertex *orig = nullptr, *dest = nullptr;
+        cout << "\033[34mInsert the name of the origin station of the segment: \033[0m";
+        fetchStation(&orig, railway);
+
+        cout << "\033[34mInsert the name of the destination station of the segment: \033[0m";
+        fetchStation(&dest, railway);
+
+        for (Edge *e: orig->getAdj()) {
+            if (e->getDest() == dest) {
+                segment = e;
+                break;
+            }
+        }
+
+        if (segment == nullptr)
+            cout << "\033[31mThere is no edge between the two stations\033[0m" << endl << endl;
     }
 
-}
+    int value = 0;
+    cout << "\033[34mInsert the new " << (cost ? "cost" : "capacity") << " of the segment: \033[0m";
+    getInput(value);
+    while (value <= 0) {
+        cout << "\033[31mPlease input a positive number: \033[0m";
+        getInput(value);
+    }
 
+    if (cost) scenario.setCost(segment, value);
+    else scenario.setCapacity(segment, value);
+    system("clear");
+}
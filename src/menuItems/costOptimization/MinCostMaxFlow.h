@@ -1,9 +1,12 @@
 #ifndef PROJECT_RAILWAY_MINCOSTMAXFLOW_H
 #define PROJECT_RAILWAY_MINCOSTMAXFLOW_H
 
+#include <memory>
 #include "graph/Graph.h"
+#include "graph/MinCostSession.h"
 #include "menuItems/general/MenuItem.h"
 #include "utils.h"
+#include "metrics/Metrics.h"
 
 class MinCostMaxFlow : public MenuItem {
 public:
@@ -15,11 +18,22 @@ public:
     MinCostMaxFlow(int &currMenuPage, Graph &railway);
 
     /**
-     * Asks for user input for the name of both the origin and destination stations and calculates the minimum cost path that provides the max flow between the two stations
-     * Time Complexity: O(V*E²), where V is the number of vertices and E is the number of edges.
+     * Asks for user input for the name of both the origin and destination stations and calculates the minimum cost path that provides the max flow between the two stations.
+     * Then lets the user change the capacity or cost of segments and see the new flow, which is re-optimized from the last one.
+     * Time Complexity: O((E + V*log(C))*F), where V is the number of vertices, E is the number of edges, F is the max flow and C is the cost of the most expensive path.
      */
     void execute() override;
 
+private:
+    unique_ptr<FlowNetwork> network; /**< Network of the railway, taken on the first query */
+    unique_ptr<MinCostSession> session; /**< Session of the queries, which keeps the last flow between them */
+    Scenario scenario; /**< What-if changes of the current query */
+
+    /**
+     * Asks for a segment and a new capacity or cost for it, and adds the change to the scenario.
+     * @param cost - true to change the cost of the segment, false to change its capacity
+     */
+    void changeSegment(bool cost);
 };
 
 
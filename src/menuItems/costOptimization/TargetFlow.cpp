@@ -0,0 +1,58 @@
+#include "TargetFlow.h"
+
+TargetFlow::TargetFlow(int &currMenuPage, Graph &railway) : MenuItem(currMenuPage, railway) {}
+
+void TargetFlow::execute() {
+    system("clear");
+    Vertex *orig = nullptr, *dest = nullptr;
+
+    cin.ignore(2000, '\n');
+    cout << "\033[34mInsert the name of the origin station: " << "\033[0m";
+    fetchStation(&orig,railway);
+
+    cout << "\033[34mInsert the name of the destination station: " << "\033[0m";
+    fetchStation(&dest,railway);
+
+    int target = 0;
+    cout << "\033[34mInsert the number of trains to move: " << "\033[0m";
+    getInput(target);
+    while (target <= 0) {
+        cout << "\033[31mPlease input a positive number of trains: \033[0m";
+        getInput(target);
+    }
+
+    FlowNetwork network(*railway);
+    FlowResult result;
+    {
+        METRIC_LATENCY(MIN_COST_QUERY);
+        result = network.getMinCostFlow(network.indexOf(orig), network.indexOf(dest), target);
+    }
+    network.applyFlow(result.flow);
+
+    if (result.value == 0) {
+        cout << "\033[31mStation " << orig->getId() << " can't reach station " << dest->getId()<< "\033[0m" << endl << endl;
+        return;
+    }
+
+    if (result.value < target)
+        cout << endl << "\033[31mOnly " << result.value << " trains can move between the stations\033[0m" << endl;
+    drawMarginalCosts(result.marginalCosts);
+
+    drawResults();
+    drawCost(result.cost);
+    drawFlow(result.value);
+    drawFooter(network.getUsedEdges(result), true);
+}
+
+void TargetFlow::drawMarginalCosts(const vector<pair<int, int>> &marginalCosts) {
+    cout << endl << "\033[34mCost of each extra train:\033[0m" << endl;
+
+    int trains = 0;
+    for (auto &step: marginalCosts) {
+        cout << "\033[33m  Trains " << trains + 1;
+        if (step.first > 1) cout << "-" << trains + step.first;
+        cout << ": \033[0m" << step.second << " each" << endl;
+        trains += step.first;
+    }
+    cout << endl;
+}
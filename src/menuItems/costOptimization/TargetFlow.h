@@ -0,0 +1,35 @@
+#ifndef PROJECT_RAILWAY_TARGETFLOW_H
+#define PROJECT_RAILWAY_TARGETFLOW_H
+
+#include "graph/Graph.h"
+#include "menuItems/general/MenuItem.h"
+#include "utils.h"
+#include "metrics/Metrics.h"
+
+class TargetFlow : public MenuItem {
+public:
+    /**
+     * Constructor
+     * @param currMenuPage - The current menu page
+     * @param railway - The railway graph
+     */
+    TargetFlow(int &currMenuPage, Graph &railway);
+
+    /**
+     * Asks for user input for the name of both the origin and destination stations and the number of trains to move
+     * between them, and shows the cheapest way to move them, with the cost of each extra train
+     * Time Complexity: O((E + V*log(C))*K), where V is the number of vertices, E is the number of edges, K is the number of
+     * trains and C is the cost of the most expensive path.
+     */
+    void execute() override;
+
+private:
+    /**
+     * Draws the cost of each extra train, one line per cost.
+     * @param marginalCosts - the number of trains moved at each cost per train, cheapest first
+     */
+    static void drawMarginalCosts(const vector<pair<int, int>> &marginalCosts);
+};
+
+
+#endif
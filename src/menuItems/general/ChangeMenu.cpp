@@ -1,8 +1,10 @@
 #include "ChangeMenu.h"
 
-ChangeMenu::ChangeMenu(int &currMenuPage, Graph &railway, int nextMenu) : MenuItem(currMenuPage, railway)
+ChangeMenu::ChangeMenu(int &currMenuPage, Graph &railway, int nextMenu, Scenario *scenario, WorkStealingPool *pool) : MenuItem(currMenuPage, railway)
 {
     this->nextMenu = nextMenu;
+    this->scenario = scenario;
+    this->pool = pool;
 }
 
 void ChangeMenu::pickEdgesToDisable() {
@@ -44,8 +46,7 @@ void ChangeMenu::pickEdgesToDisable() {
         bool not_found = true;
         for (Edge *e: orig->getAdj()){
             if (e->getDest() == dest){
-                e->setDisabled(true);
-                e->getReverse()->setDisabled(true);
+                scenario->disableSegment(e);
                 not_found = false;
                 pickedAnEdge = true;
                 break;
@@ -61,32 +62,23 @@ void ChangeMenu::pickEdgesToDisable() {
 }
 
 void ChangeMenu::enableAllEdges() {
-    for (const auto& v: railway->getVertexSet()) {
-        for (Edge *e: v.second->getAdj()) {
-            e->setDisabled(false);
-        }
-    }
+    scenario->clear();
 }
 
 void ChangeMenu::execute() {
-    if (nextMenu == 3) {
-        auto vertexSet = railway->getVertexSet();
-        auto extremes = railway->getExtremes();
-
-        for (auto &pa: vertexSet){
-            Vertex *superSource = railway->addSuperSource(pa.second);
-
-            pa.second->setMaxFlow(railway->getMaxFlow(superSource, pa.second));
+    if (nextMenu == 3 && scenario != nullptr && pool != nullptr) {
+        UndirectedFlowNetwork network(*railway, railway->getExtremes());
+        vector<Vertex *> stations;
+        for (auto &pa: railway->getVertexSet())
+            stations.push_back(pa.second);
 
-            for (Vertex *extreme: extremes) {
-                extreme->removeEdge("Super Node");
-            }
-
-            railway->removeVertex("Super Node");
-        }
+        pool->setProgressCallback(drawProgress);
+        pool->parallelFor<UndirectedFlowWorkspace>(stations.size(), [&](size_t i, UndirectedFlowWorkspace &ws) {
+            stations[i]->setMaxFlow(network.maxFlow(network.getSuperSource(), network.indexOf(stations[i]), ws));
+        });
 
         pickEdgesToDisable();
     }
-    if (*currMenuPage == 3) enableAllEdges();
+    if (*currMenuPage == 3 && scenario != nullptr) enableAllEdges();
     *(this->currMenuPage) = nextMenu;
 }
\ No newline at end of file
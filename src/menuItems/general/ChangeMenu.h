@@ -3,6 +3,9 @@
 
 #include "MenuItem.h"
 #include "utils.h"
+#include "parallel/WorkStealingPool.h"
+#include "graph/Scenario.h"
+#include "graph/UndirectedFlowNetwork.h"
 
 using namespace std;
 
@@ -12,14 +15,20 @@ private:
     /** @var Menu to change to */
     int nextMenu;
 
+    /** @var Segments disabled for the reduced connectivity menu (nullptr if the menu item doesn't change them) */
+    Scenario *scenario;
+
+    /** @var Pool shared by the analyses of the program (nullptr if the menu item doesn't run any) */
+    WorkStealingPool *pool;
+
     /**
-     * Let's the user choose the edges that he wants to disable in the whole graph for future algorithms of reduced
+     * Let's the user choose the edges that he wants to disable in the scenario used by the algorithms of reduced
      * connectivity
      */
     void pickEdgesToDisable();
 
     /**
-     * Enables all edges of the graph
+     * Enables all edges again, by clearing the scenario
      */
     void enableAllEdges();
 
@@ -29,12 +38,14 @@ public:
      * @param currMenuPage current page of the menu
      * @param database database that stores all the information
      * @param nextMenu the page we want to change to
+     * @param scenario the scenario of the reduced connectivity menu, when entering or leaving it
+     * @param pool the pool shared by the analyses of the program, when entering the reduced connectivity menu
      */
-    ChangeMenu(int &currMenuPage, Graph &railway, int nextMenu);
+    ChangeMenu(int &currMenuPage, Graph &railway, int nextMenu, Scenario *scenario = nullptr, WorkStealingPool *pool = nullptr);
 
     /**
      * Changes to the menu of the value nextMenu. If it corresponds to the menu of reduced connectivity then maximum
-     * flow that reaches each station is calculated beforehand
+     * flow that reaches each station is calculated beforehand, one station per task
      */
     void execute() override;
 };
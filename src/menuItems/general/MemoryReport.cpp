@@ -0,0 +1,17 @@
+#include "MemoryReport.h"
+
+MemoryReport::MemoryReport(int &currMenuPage, Graph &railway) : MenuItem(currMenuPage, railway) {}
+
+void MemoryReport::execute() {
+    system("clear");
+
+    MemoryFootprint::print(cout, "\033[34mRailway graph\033[0m", MemoryFootprint::measure(*railway));
+    cout << endl;
+    FlowNetwork network(*railway, railway->getExtremes());
+    MemoryFootprint::print(cout, "\033[34mFlow network\033[0m", MemoryFootprint::measure(network));
+
+    string dummy;
+    cin.ignore(2000, '\n');
+    cout << endl << "\033[33mInput anything to continue: \033[0m";
+    getline(cin, dummy);
+}
@@ -0,0 +1,27 @@
+#ifndef PROJECT_RAILWAY_MEMORYREPORT_H
+#define PROJECT_RAILWAY_MEMORYREPORT_H
+
+#include "graph/Graph.h"
+#include "graph/FlowNetwork.h"
+#include "graph/MemoryFootprint.h"
+#include "menuItems/general/MenuItem.h"
+
+class MemoryReport : public MenuItem {
+public:
+    /**
+     * Constructor
+     * @param currMenuPage - The current menu page
+     * @param railway - The railway graph
+     */
+    MemoryReport(int &currMenuPage, Graph &railway);
+
+    /**
+     * Shows the memory used by the railway graph and by its flow network, by structure, per station and per arc.
+     * Time Complexity: O(V+E+T), where V is the number of vertices, E is the number of edges and T is the number of
+     * townships.
+     */
+    void execute() override;
+};
+
+
+#endif //PROJECT_RAILWAY_MEMORYREPORT_H
@@ -0,0 +1,36 @@
+#include "SolverMetrics.h"
+
+SolverMetrics::SolverMetrics(int &currMenuPage, Graph &railway) : MenuItem(currMenuPage, railway) {}
+
+void SolverMetrics::execute() {
+    system("clear");
+
+    if (Metrics::isEnabled()) {
+        string name = Metrics::getLastAnalysisName();
+        if (name.empty()) {
+            cout << "\033[31mNo analysis has used a solver yet\033[0m" << endl;
+        }
+        else {
+            cout << "\033[34mLast analysis: " << name << "\033[0m" << endl << endl;
+            Metrics::print(cout, Metrics::getLastAnalysis());
+        }
+
+        cout << endl << "\033[34mSince the program started:\033[0m" << endl << endl;
+    }
+    Metrics::print(cout, Metrics::collect());
+
+    if (Metrics::hasLatencies()) {
+        cout << endl << "\033[34mLatencies since the program started:\033[0m" << endl << endl;
+        Metrics::printLatencies(cout);
+    }
+
+    if (Allocations::isTracking()) {
+        cout << endl << "\033[34mAllocations:\033[0m" << endl << endl;
+        Allocations::print(cout);
+    }
+
+    string dummy;
+    cin.ignore(2000, '\n');
+    cout << endl << "\033[33mInput anything to continue: \033[0m";
+    getline(cin, dummy);
+}
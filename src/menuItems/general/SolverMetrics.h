@@ -0,0 +1,28 @@
+#ifndef PROJECT_RAILWAY_SOLVERMETRICS_H
+#define PROJECT_RAILWAY_SOLVERMETRICS_H
+
+#include "graph/Graph.h"
+#include "menuItems/general/MenuItem.h"
+#include "metrics/Allocations.h"
+#include "metrics/Metrics.h"
+
+class SolverMetrics : public MenuItem {
+public:
+    /**
+     * Constructor
+     * @param currMenuPage - The current menu page
+     * @param railway - The railway graph
+     */
+    SolverMetrics(int &currMenuPage, Graph &railway);
+
+    /**
+     * Shows the solver metrics of the last analysis that used a solver, the totals since the program started, the
+     * latency percentiles of the queries and solvers and, when they are tracked, the allocations.
+     * Time Complexity: O(T + L*B), where T is the number of threads that ran solvers, L is the number of latency
+     * histograms and B is the number of buckets of each one.
+     */
+    void execute() override;
+};
+
+
+#endif //PROJECT_RAILWAY_SOLVERMETRICS_H
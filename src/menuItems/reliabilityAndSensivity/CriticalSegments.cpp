@@ -0,0 +1,48 @@
+#include "CriticalSegments.h"
+
+CriticalSegments::CriticalSegments(int &currMenuPage, Graph &gh, Scenario &scenario, WorkStealingPool &pool) : MenuItem(currMenuPage, gh){
+    this->scenario = &scenario;
+    this->pool = &pool;
+}
+
+void CriticalSegments::execute() {
+    int topK;
+    system("clear");
+
+    FlowNetwork network(*railway, railway->getExtremes(), *scenario);
+    SegmentCriticality criticality(network);
+    int nSegments = criticality.getSegmentCount();
+
+    if (nSegments == 0) return;
+
+    cout << "\033[34mPlease input how many segments you would like the top-k report to have (1-" << nSegments << "): \033[0m";
+    getInput(topK);
+    while (0 >= topK || topK > nSegments) {
+        cout << "\033[31mPlease input a valid number (1-" << nSegments << "): \033[0m";
+        getInput(topK);
+    }
+    cout << endl;
+
+    vector<pair<pair<Vertex*, Vertex*>, int>> report;
+    // The segments are printed as soon as they are ranked, instead of the progress of each run
+    pool->setProgressCallback(nullptr);
+    {
+        METRIC_LATENCY(SEGMENT_FAILURE_QUERY);
+        criticality.rank(*pool, topK, [&](int arc, long loss) {
+            Edge *e = network.getEdge(arc);
+            report.push_back({{e->getOrig(), e->getDest()}, (int) loss});
+
+            auto s = e->getOrig()->getId() + " <-> " + e->getDest()->getId();
+            cout << "\033[33m" << report.size() << ". \033[0m" << s << "\033[34m (loss: " << loss << ")\033[0m" << endl;
+        });
+    }
+
+    cout << endl << "\033[32mEvaluated " << criticality.getEvaluatedCount() << " of " << nSegments << " segments\033[0m" << endl;
+
+    string dummy;
+    cin.ignore(2000, '\n');
+    cout << "\033[33mInput anything to continue: \033[0m";
+    getline(cin, dummy);
+
+    topPairs(report, "Loss");
+}
@@ -0,0 +1,36 @@
+#ifndef PROJECT_RAILWAY_CRITICALSEGMENTS_H
+#define PROJECT_RAILWAY_CRITICALSEGMENTS_H
+
+#include "graph/Graph.h"
+#include "graph/SegmentCriticality.h"
+#include "menuItems/general/MenuItem.h"
+#include "utils.h"
+#include "parallel/WorkStealingPool.h"
+#include "graph/Scenario.h"
+#include "metrics/Metrics.h"
+
+class CriticalSegments : public MenuItem{
+private:
+    Scenario *scenario; /**< Scenario with the edges disabled by the user */
+    WorkStealingPool *pool; /**< Pool shared by the analyses of the program */
+
+public:
+    /**
+     * Constructor
+     * @param currMenuPage - The current menu page
+     * @param gh - The railway graph
+     * @param scenario - The scenario with the edges disabled by the user
+     * @param pool - The pool shared by the analyses of the program
+     */
+    CriticalSegments(int &currMenuPage, Graph &gh, Scenario &scenario, WorkStealingPool &pool);
+
+    /**
+     * Ranks the k segments of the whole network whose failure causes the highest total loss of flow to the stations,
+     * printing each one as soon as its position is known, and then shows the ranking;
+     * Time Complexity: O(V²*E² / T), where V is the number of vertices, E is the number of edges and T is the number of threads.
+     */
+    void execute() override;
+};
+
+
+#endif //PROJECT_RAILWAY_CRITICALSEGMENTS_H
@@ -0,0 +1,174 @@
+#include "RandomFailures.h"
+#include <algorithm>
+#include <iomanip>
+
+RandomFailures::RandomFailures(int &currMenuPage, Graph &gh, Scenario &scenario, WorkStealingPool &pool) : MenuItem(currMenuPage, gh){
+    this->scenario = &scenario;
+    this->pool = &pool;
+}
+
+void RandomFailures::fetchParameters(double &probability, double &tolerance) {
+    cout << "\033[34mPlease input the probability of failure of each segment, in % (0-100): \033[0m";
+    getInput(probability);
+    while (0 >= probability || probability >= 100) {
+        cout << "\033[31mPlease input a valid probability (0-100): \033[0m";
+        getInput(probability);
+    }
+
+    cout << "\033[34mPlease input the tolerance of the estimates, in % of their value (0-100): \033[0m";
+    getInput(tolerance);
+    while (0 >= tolerance || tolerance >= 100) {
+        cout << "\033[31mPlease input a valid tolerance (0-100): \033[0m";
+        getInput(tolerance);
+    }
+
+    probability /= 100;
+    tolerance /= 100;
+}
+
+void RandomFailures::drawDistribution(const FailureSimulation &simulation) {
+    const SampleStats &stats = simulation.getStats(0);
+    int baseline = simulation.getBaseline(0);
+
+    cout << endl << "\033[33mCapacity without failures: \033[0m" << baseline << endl;
+    cout << "\033[33mExpected capacity: \033[0m" << stats.getMean() << " ± " << stats.getHalfWidth() << endl;
+    cout << "\033[33mProbability of a lower capacity: \033[0m" << stats.getProbabilityBelow(baseline) * 100 << "%" << endl;
+    cout << "\033[33mProbability of no connection: \033[0m" << stats.getProbabilityBelow(1) * 100 << "%" << endl;
+
+    cout << endl << "\033[34mDistribution of the capacity:\033[0m" << endl;
+    for (auto it = stats.histogram.rbegin(); it != stats.histogram.rend(); it++)
+        cout << "\033[33m" << setw(6) << it->first << "\033[0m  " << (double) it->second / stats.samples * 100 << "%" << endl;
+}
+
+void RandomFailures::drawTopStations(const FailureSimulation &simulation, const vector<Vertex *> &stations, int topK) {
+    vector<size_t> order(stations.size());
+    vector<double> loss(stations.size());
+    for (size_t i = 0; i < stations.size(); i++) {
+        order[i] = i;
+        loss[i] = simulation.getBaseline(i) - simulation.getStats(i).getMean();
+    }
+    stable_sort(order.begin(), order.end(), [&loss](size_t i, size_t j) {
+        return loss[i] > loss[j];
+    });
+
+    cout << endl;
+    for (int k = 0; k < topK; k++) {
+        size_t i = order[k];
+        const SampleStats &stats = simulation.getStats(i);
+
+        cout << "\033[33m" << k + 1 << ". \033[0m" << stations[i]->getId() << "\033[34m (expected loss: " << loss[i]
+             << " ± " << stats.getHalfWidth() << ", probability of a loss: "
+             << stats.getProbabilityBelow(simulation.getBaseline(i)) * 100 << "%)\033[0m" << endl;
+    }
+}
+
+void RandomFailures::drawCutOffStations(const FailureSimulation &simulation, const FlowNetwork &network,
+                                        const vector<Vertex *> &stations, int topK) {
+    vector<size_t> order;
+    double expected = 0;
+    for (size_t i = 0; i < stations.size(); i++) {
+        long count = simulation.getCutOffCount(network.indexOf(stations[i]));
+        expected += count;
+        if (count > 0) order.push_back(i);
+    }
+    stable_sort(order.begin(), order.end(), [&simulation, &network, &stations](size_t i, size_t j) {
+        return simulation.getCutOffCount(network.indexOf(stations[i])) > simulation.getCutOffCount(network.indexOf(stations[j]));
+    });
+
+    long samples = simulation.getSampleCount();
+    cout << endl << "\033[33mExpected stations cut off from every line extreme: \033[0m" << expected / samples << endl;
+    for (int k = 0; k < topK && k < (int) order.size(); k++) {
+        size_t i = order[k];
+        cout << "\033[33m" << k + 1 << ". \033[0m" << stations[i]->getId() << "\033[34m (probability of being cut off: "
+             << (double) simulation.getCutOffCount(network.indexOf(stations[i])) / samples * 100 << "%)\033[0m" << endl;
+    }
+}
+
+void RandomFailures::execute() {
+    int mode, topK = 0;
+    double probability = 0, tolerance = 0;
+    system("clear");
+
+    cout << "\033[34m[1] Capacity between two stations" << endl << "[2] Throughput of every station\033[0m" << endl << endl;
+    cout << "\033[34mInsert an option: \033[0m";
+    getInput(mode);
+    while (mode != 1 && mode != 2) {
+        cout << "\033[31mPlease input a valid option (1-2): \033[0m";
+        getInput(mode);
+    }
+
+    vector<Vertex *> stations;
+    vector<pair<int, int>> queries;
+    FlowNetwork network = mode == 1 ? FlowNetwork(*railway, *scenario) : FlowNetwork(*railway, railway->getExtremes(), *scenario);
+
+    if (mode == 1) {
+        Vertex *orig = nullptr, *dest = nullptr;
+        cin.ignore(2000, '\n');
+        system("clear");
+        cout << "\033[34mInsert the name of the origin station: " << "\033[0m";
+        fetchStation(&orig, railway);
+
+        cout << "\033[34mInsert the name of the destination station: " << "\033[0m";
+        fetchStation(&dest, railway);
+
+        queries.emplace_back(network.indexOf(orig), network.indexOf(dest));
+    }
+    else {
+        for (const auto &v: railway->getVertexSet())
+            stations.push_back(v.second);
+        sort(stations.begin(), stations.end(), [](Vertex *s1, Vertex *s2) {
+            return s1->getId() < s2->getId();
+        });
+
+        for (Vertex *v: stations)
+            queries.emplace_back(network.getSuperSource(), network.indexOf(v));
+
+        cout << "\033[34mPlease input how many stations you would like the top-k report to have (1-" << stations.size() << "): \033[0m";
+        getInput(topK);
+        while (0 >= topK || topK > (int) stations.size()) {
+            cout << "\033[31mPlease input a valid number (1-" << stations.size() << "): \033[0m";
+            getInput(topK);
+        }
+    }
+
+    fetchParameters(probability, tolerance);
+
+    FailureSimulation simulation(network, queries, vector<double>(network.getArcCount(), probability));
+    // The samples drawn so far are printed after each round, instead of the progress of each run
+    pool->setProgressCallback(nullptr);
+
+    cout << endl << fixed << setprecision(2);
+    bool converged;
+    {
+        METRIC_LATENCY(SEGMENT_FAILURE_QUERY);
+        converged = simulation.run(*pool, tolerance, MAX_SAMPLES, [&simulation, &queries]() {
+            double widest = 0;
+            for (size_t q = 0; q < queries.size(); q++) {
+                const SampleStats &stats = simulation.getStats(q);
+                if (stats.getMean() > 0) widest = max(widest, stats.getHalfWidth() / stats.getMean());
+            }
+
+            cout << "\r\033[34mSamples: " << simulation.getSampleCount() << " (widest interval: ± " << widest * 100 << "%)   \033[0m" << flush;
+        });
+    }
+    cout << endl;
+
+    if (!converged)
+        cout << "\033[31mThe intervals are still wider than the tolerance after " << MAX_SAMPLES << " samples\033[0m" << endl;
+    cout << "\033[32mDrew " << simulation.getSampleCount() << " samples over " << simulation.getSegmentCount()
+         << " segments, repairing " << simulation.getSolveCount() << " max flows (" << simulation.getUnreachableCount()
+         << " more were cut off)\033[0m" << endl;
+
+    if (mode == 1)
+        drawDistribution(simulation);
+    else {
+        drawTopStations(simulation, stations, topK);
+        drawCutOffStations(simulation, network, stations, topK);
+    }
+    cout << defaultfloat << setprecision(6);
+
+    string dummy;
+    cin.ignore(2000, '\n');
+    cout << endl << "\033[33mInput anything to continue: \033[0m";
+    getline(cin, dummy);
+}
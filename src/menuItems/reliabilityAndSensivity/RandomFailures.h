@@ -0,0 +1,70 @@
+#ifndef PROJECT_RAILWAY_RANDOMFAILURES_H
+#define PROJECT_RAILWAY_RANDOMFAILURES_H
+
+#include "graph/Graph.h"
+#include "graph/FailureSimulation.h"
+#include "menuItems/general/MenuItem.h"
+#include "utils.h"
+#include "parallel/WorkStealingPool.h"
+#include "graph/Scenario.h"
+#include "metrics/Metrics.h"
+
+class RandomFailures : public MenuItem{
+private:
+    static const long MAX_SAMPLES = 1000000; /**< Most samples drawn by a simulation */
+    Scenario *scenario; /**< Scenario with the edges disabled by the user */
+    WorkStealingPool *pool; /**< Pool shared by the analyses of the program */
+
+    /**
+     * Asks the user for the failure probability of the segments and the tolerance of the simulation.
+     * @param probability - variable that will hold the failure probability of each segment
+     * @param tolerance - variable that will hold the tolerance, relative to the estimates
+     */
+    static void fetchParameters(double &probability, double &tolerance);
+
+    /**
+     * Shows the distribution of the capacity between two stations.
+     * @param simulation - the simulation, with a single query
+     */
+    static void drawDistribution(const FailureSimulation &simulation);
+
+    /**
+     * Shows the k stations with the highest expected loss of throughput.
+     * @param simulation - the simulation, with a query per station
+     * @param stations - the station of each query
+     * @param topK - the number of stations to show
+     */
+    static void drawTopStations(const FailureSimulation &simulation, const vector<Vertex *> &stations, int topK);
+
+    /**
+     * Shows the expected number of stations cut off from every line extreme and the k stations cut off most often.
+     * @param simulation - the simulation, with a query per station from the super source
+     * @param network - the network of the simulation
+     * @param stations - the station of each query
+     * @param topK - the number of stations to show
+     */
+    static void drawCutOffStations(const FailureSimulation &simulation, const FlowNetwork &network,
+                                   const vector<Vertex *> &stations, int topK);
+
+public:
+    /**
+     * Constructor
+     * @param currMenuPage - The current menu page
+     * @param gh - The railway graph
+     * @param scenario - The scenario with the edges disabled by the user
+     * @param pool - The pool shared by the analyses of the program
+     */
+    RandomFailures(int &currMenuPage, Graph &gh, Scenario &scenario, WorkStealingPool &pool);
+
+    /**
+     * Simulates independent random failures of every segment, with a probability chosen by the user, and estimates either
+     * the distribution of the capacity between two stations or the expected throughput of every station (with the stations
+     * most often cut off from every line extreme), until the confidence intervals are within the chosen tolerance;
+     * Time Complexity: O(N*(S + F*V*E²) / T), where N is the number of samples, S is the number of segments, F is the number
+     * of queries affected by each sample, V is the number of vertices, E is the number of edges and T is the number of threads.
+     */
+    void execute() override;
+};
+
+
+#endif //PROJECT_RAILWAY_RANDOMFAILURES_H
@@ -1,6 +1,8 @@
 #include "ReducedConnectivityMaxFlow.h"
 
-ReducedConnectivityMaxFlow::ReducedConnectivityMaxFlow(int &currMenuPage, Graph &gh) : MenuItem(currMenuPage, gh){}
+ReducedConnectivityMaxFlow::ReducedConnectivityMaxFlow(int &currMenuPage, Graph &gh, Scenario &scenario) : MenuItem(currMenuPage, gh){
+    this->scenario = &scenario;
+}
 
 void ReducedConnectivityMaxFlow::execute() {
     string amount;
@@ -17,13 +19,18 @@ void ReducedConnectivityMaxFlow::execute() {
         fetchStation(&dest,railway);
         break;
     }
-    int flow = railway->getMaxFlow(orig,dest);
+    FlowNetwork network(*railway);
+    FlowResult result;
+    {
+        METRIC_LATENCY(SEGMENT_FAILURE_QUERY);
+        result = network.getMaxFlow(network.indexOf(orig), network.indexOf(dest), *scenario);
+    }
+    network.applyFlow(result.flow);
+
     drawResults();
-    drawFlow(flow);
-    vector<Vertex*> vertexes;
-    vertexes.push_back(orig);
-    if (flow > 0){
-        drawFooter(railway->fetchUsedEdges(vertexes));
+    drawFlow(result.value);
+    if (result.value > 0){
+        drawFooter(network.getUsedEdges(result));
     }
     else{
         cout << "|\033[40m<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<\033[0m|\n"
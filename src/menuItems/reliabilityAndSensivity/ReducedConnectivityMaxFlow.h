@@ -5,18 +5,22 @@
 #include "graph/Graph.h"
 #include "menuItems/general/MenuItem.h"
 #include "utils.h"
+#include "graph/Scenario.h"
+#include "metrics/Metrics.h"
 
 class ReducedConnectivityMaxFlow : public MenuItem{
 private:
     int currMenuPage; /**< The current menu page */
+    Scenario *scenario; /**< Scenario with the edges disabled by the user */
 
 public:
     /**
      * Constructor
      * @param currMenuPage - The current menu page
      * @param gh - The railway graph
+     * @param scenario - The scenario with the edges disabled by the user
      */
-    ReducedConnectivityMaxFlow(int &currMenuPage, Graph &gh);
+    ReducedConnectivityMaxFlow(int &currMenuPage, Graph &gh, Scenario &scenario);
 
     /**
      * Calculates the max flow between two stations when some of the edges were set as disabled;
@@ -1,6 +1,8 @@
 #include "TopSegmentFailure.h"
 
-TopSegmentFailure::TopSegmentFailure(int &currMenuPage, Graph &gh) : MenuItem(currMenuPage, gh){
+TopSegmentFailure::TopSegmentFailure(int &currMenuPage, Graph &gh, Scenario &scenario, WorkStealingPool &pool) : MenuItem(currMenuPage, gh){
+    this->scenario = &scenario;
+    this->pool = &pool;
     getAllStations();
 }
 
@@ -8,21 +10,16 @@ bool sortResultVector(const pair<Vertex*, int> &p1, const pair<Vertex*, int> &p2
     return (p1.second > p2.second);
 }
 
-void TopSegmentFailure::disabledEdgesMaxFlow() {
-    auto vertexSet = railway->getVertexSet();
-    auto extremes = railway->getExtremes();
+void TopSegmentFailure::disabledEdgesMaxFlow(Edge *pickedEdge) {
+    METRIC_LATENCY(SEGMENT_FAILURE_QUERY);
+    Scenario picked;
+    picked.disableSegment(pickedEdge);
+    UndirectedFlowNetwork network(*railway, railway->getExtremes(), picked);
 
-    for (auto &pa: vertexSet){
-        Vertex *superSource = railway->addSuperSource(pa.second);
-
-        pa.second->setDisabledFlow(railway->getMaxFlow(superSource, pa.second));
-
-        for (Vertex *extreme: extremes) {
-            extreme->removeEdge("Super Node");
-        }
-
-        railway->removeVertex("Super Node");
-    }
+    pool->setProgressCallback(drawProgress);
+    pool->parallelFor<UndirectedFlowWorkspace>(stations.size(), [&](size_t i, UndirectedFlowWorkspace &ws) {
+        stations[i]->setDisabledFlow(network.maxFlow(network.getSuperSource(), network.indexOf(stations[i]), ws));
+    });
 }
 
 void TopSegmentFailure::execute() {
@@ -31,14 +28,6 @@ void TopSegmentFailure::execute() {
     int topK;
     system("clear");
 
-    disabledEdges = fetchDisabledEdges();
-
-    vector<Edge*> v;
-
-    for (auto e: disabledEdges) {
-        v.push_back(e);
-    }
-
     cout << "\033[34mPlease input how many stations you would like the top-k report to have (1-" << stations.size() << "): \033[0m";
     getInput(topK);
     while ( 0 >= topK || topK > stations.size()) {
@@ -47,14 +36,8 @@ void TopSegmentFailure::execute() {
     }
 
     topVertexes.reserve(topK);
-    Edge *pickedEdge = pickAnEdge(v);
-    auto vertexSet = railway->getVertexSet();
-    enableEdges();
-
-    pickedEdge->setDisabled(true);
-    pickedEdge->getReverse()->setDisabled(true);
-
-    disabledEdgesMaxFlow();
+    Edge *pickedEdge = pickAnEdge(scenario->getDisabledSegments());
+    disabledEdgesMaxFlow(pickedEdge);
 
     sort(stations.begin(), stations.end(), [](Vertex* s1, Vertex* s2) {
         return s1->getMaxFlow() - s1->getDisabledFlow() > s2->getMaxFlow() - s2->getDisabledFlow();
@@ -65,39 +48,9 @@ void TopSegmentFailure::execute() {
     }
 
     topNode(topVertexes);
-
-    disableEdges();
-}
-
-set<Edge*> TopSegmentFailure::fetchDisabledEdges() {
-    set<Edge*> allDisabledEdges;
-
-    for (const auto& v: railway->getVertexSet()) {
-        for (Edge *e: v.second->getAdj()) {
-            if (e->getDisabled() && allDisabledEdges.find(e->getReverse()) == allDisabledEdges.end()) {
-                allDisabledEdges.insert(e);
-            }
-        }
-    }
-
-    return allDisabledEdges;
-}
-
-void TopSegmentFailure::enableEdges() {
-    for (Edge *e: disabledEdges) {
-        e->setDisabled(false);
-        e->getReverse()->setDisabled(false);
-    }
 }
 
 void TopSegmentFailure::getAllStations() {
     for (const auto& v: railway->getVertexSet())
         stations.push_back(v.second);
 }
-
-void TopSegmentFailure::disableEdges() {
-    for (Edge *e: disabledEdges) {
-        e->setDisabled(true);
-        e->getReverse()->setDisabled(true);
-    }
-}
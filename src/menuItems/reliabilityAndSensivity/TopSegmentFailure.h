@@ -5,36 +5,22 @@
 #include "graph/Graph.h"
 #include "menuItems/general/MenuItem.h"
 #include "utils.h"
+#include "parallel/WorkStealingPool.h"
+#include "graph/Scenario.h"
+#include "graph/UndirectedFlowNetwork.h"
+#include "metrics/Metrics.h"
 
 class TopSegmentFailure : public MenuItem{
 private:
     int currMenuPage; /**< The current menu page */
     
     /**
-     * Calculates the max flow on a single station for all stations of the graph;
-     * Time Complexity: O(V*E²), where V is the number of vertices and E is the number of edges.
-     * @return
-     */
-    void disabledEdgesMaxFlow();
-
-    /**
-     * Fetches all disabled edges of the graph;
-     * Time Complexity: O(E), where E is the number of edges.
-     * @return a set containing all disabled edges
-     */
-    set<Edge*> fetchDisabledEdges();
-
-    /**
-     * Enables certain disabled edges;
-     * Time Complexity: O(D), where D is the number of edges in the disabled edges set.
-     */
-    void enableEdges();
-
-    /**
-     * Disables certain enabled edges;
-     * Time Complexity: O(D), where D is the number of edges in the disabled edges set.
+     * Calculates the max flow on a single station for all stations of the graph when only the picked edge is disabled,
+     * one station per task;
+     * Time Complexity: O(V²*E² / T), where V is the number of vertices, E is the number of edges and T is the number of threads.
+     * @param pickedEdge - the disabled edge
      */
-    void disableEdges();
+    void disabledEdgesMaxFlow(Edge *pickedEdge);
 
     /**
      * Fetches all stations and adds them to the stations vector.
@@ -42,15 +28,18 @@ private:
      */
     void getAllStations();
 
-    set<Edge*> disabledEdges; /**< Set containing the disabled edges */
+    Scenario *scenario; /**< Scenario with the edges disabled by the user */
+    WorkStealingPool *pool; /**< Pool shared by the analyses of the program */
     vector<Vertex*> stations; /**< Vector containing the stations of the graph */
 public:
     /**
      * Constructor
      * @param currMenuPage - The current menu page
      * @param gh - The railway graph
+     * @param scenario - The scenario with the edges disabled by the user
+     * @param pool - The pool shared by the analyses of the program
      */
-    TopSegmentFailure(int &currMenuPage, Graph &gh);
+    TopSegmentFailure(int &currMenuPage, Graph &gh, Scenario &scenario, WorkStealingPool &pool);
 
     /**
      * Calculates which stations would be most affected by the selected edges being disabled;
@@ -0,0 +1,89 @@
+#include <cstdlib>
+#include <new>
+#include "Allocations.h"
+
+// Replacements of the global allocation functions that count every allocation in Allocations.
+// Each block starts with a header holding its size, so the frees can be counted too. The header is 16 bytes long to keep
+// the alignment malloc gives.
+
+namespace {
+    const size_t HEADER = 16; /**< Bytes in front of each block, holding its size */
+
+    const bool linked = Allocations::startTracking(); /**< Marks the tracking as on as soon as the program starts */
+
+    /**
+     * Allocates a block and counts it.
+     * @param bytes - the size of the block
+     * @return the block, or nullptr if there is no memory left
+     */
+    void *allocate(size_t bytes) {
+        if (bytes == 0) bytes = 1;
+
+        void *raw;
+        while ((raw = malloc(bytes + HEADER)) == nullptr) {
+            new_handler handler = get_new_handler();
+            if (handler == nullptr) return nullptr;
+            handler();
+        }
+
+        *static_cast<size_t *>(raw) = bytes;
+        Allocations::onAllocate(bytes);
+        return static_cast<char *>(raw) + HEADER;
+    }
+
+    /**
+     * Frees a block and counts it.
+     * @param block - the block (may be nullptr)
+     */
+    void release(void *block) {
+        if (block == nullptr) return;
+
+        void *raw = static_cast<char *>(block) - HEADER;
+        Allocations::onFree(*static_cast<size_t *>(raw));
+        free(raw);
+    }
+}
+
+void *operator new(size_t bytes) {
+    void *block = allocate(bytes);
+    if (block == nullptr) throw bad_alloc();
+    return block;
+}
+
+void *operator new[](size_t bytes) {
+    void *block = allocate(bytes);
+    if (block == nullptr) throw bad_alloc();
+    return block;
+}
+
+void *operator new(size_t bytes, const nothrow_t &) noexcept {
+    return allocate(bytes);
+}
+
+void *operator new[](size_t bytes, const nothrow_t &) noexcept {
+    return allocate(bytes);
+}
+
+void operator delete(void *block) noexcept {
+    release(block);
+}
+
+void operator delete[](void *block) noexcept {
+    release(block);
+}
+
+void operator delete(void *block, size_t) noexcept {
+    release(block);
+}
+
+void operator delete[](void *block, size_t) noexcept {
+    release(block);
+}
+
+void operator delete(void *block, const nothrow_t &) noexcept {
+    release(block);
+}
+
+void operator delete[](void *block, const nothrow_t &) noexcept {
+    release(block);
+}
@@ -0,0 +1,104 @@
+#include "Allocations.h"
+#include <iomanip>
+
+thread_local Allocations::ThreadCounters Allocations::local;
+bool Allocations::tracking = false;
+Allocations::SiteCounters Allocations::sites[ALLOCATION_SITE_COUNT];
+mutex Allocations::actionLock;
+string Allocations::lastActionName;
+AllocationStats Allocations::lastAction;
+
+bool Allocations::isTracking() {
+    return tracking;
+}
+
+bool Allocations::startTracking() {
+    tracking = true;
+    return true;
+}
+
+AllocationStats Allocations::getSite(AllocationSite site) {
+    AllocationStats stats;
+    stats.count = sites[site].count.load(memory_order_relaxed);
+    stats.bytes = sites[site].bytes.load(memory_order_relaxed);
+    stats.peak = sites[site].peak.load(memory_order_relaxed);
+    return stats;
+}
+
+long long Allocations::getSiteCalls(AllocationSite site) {
+    return sites[site].calls.load(memory_order_relaxed);
+}
+
+long long Allocations::getSolverCalls() {
+    long long calls = 0;
+    for (int s = 0; s < ALLOCATION_SITE_COUNT; s++)
+        calls += getSiteCalls((AllocationSite) s);
+
+    return calls;
+}
+
+void Allocations::setLastAction(const string &name, const AllocationStats &stats) {
+    lock_guard<mutex> guard(actionLock);
+    lastActionName = name;
+    lastAction = stats;
+}
+
+void Allocations::print(ostream &out) {
+    static const char *siteNames[ALLOCATION_SITE_COUNT] = {"Max flow", "Min cost max flow", "Flow repair"};
+
+    if (!tracking) {
+        out << "Allocations are not tracked (build with -DRAILWAY_ALLOC_TRACKING=ON)" << endl;
+        return;
+    }
+
+    ios state(nullptr);
+    state.copyfmt(out);
+
+    {
+        lock_guard<mutex> guard(actionLock);
+        if (!lastActionName.empty())
+            out << "Last action (" << lastActionName << "): " << lastAction.count << " allocations, "
+                << lastAction.bytes << " bytes, peak " << lastAction.peak << " bytes" << endl << endl;
+    }
+
+    out << left << setw(20) << "Solver call" << right << setw(10) << "Calls" << setw(14) << "Allocs/call"
+        << setw(14) << "Bytes/call" << setw(14) << "Peak bytes" << endl;
+    for (int s = 0; s < ALLOCATION_SITE_COUNT; s++) {
+        long long calls = getSiteCalls((AllocationSite) s);
+        AllocationStats stats = getSite((AllocationSite) s);
+        out << left << setw(20) << siteNames[s] << right << setw(10) << calls << fixed << setprecision(2)
+            << setw(14) << (calls == 0 ? 0.0 : (double) stats.count / calls)
+            << setw(14) << (calls == 0 ? 0.0 : (double) stats.bytes / calls) << setw(14) << stats.peak << endl;
+    }
+
+    out.copyfmt(state);
+}
+
+Allocations::Scope::Scope() : site(-1), start(local) {
+    local.peak = local.live;
+}
+
+Allocations::Scope::Scope(AllocationSite site) : Scope() {
+    this->site = site;
+}
+
+Allocations::Scope::~Scope() {
+    AllocationStats stats = getStats();
+    if (local.peak < start.peak) local.peak = start.peak;
+    if (site == -1) return;
+
+    SiteCounters &counters = sites[site];
+    counters.calls.fetch_add(1, memory_order_relaxed);
+    counters.count.fetch_add(stats.count, memory_order_relaxed);
+    counters.bytes.fetch_add(stats.bytes, memory_order_relaxed);
+    long long current = counters.peak.load(memory_order_relaxed);
+    while (stats.peak > current && !counters.peak.compare_exchange_weak(current, stats.peak, memory_order_relaxed));
+}
+
+AllocationStats Allocations::Scope::getStats() const {
+    AllocationStats stats;
+    stats.count = local.count - start.count;
+    stats.bytes = local.bytes - start.bytes;
+    stats.peak = local.peak - start.live;
+    return stats;
+}
@@ -0,0 +1,173 @@
+#ifndef PROJECT_RAILWAY_ALLOCATIONS_H
+#define PROJECT_RAILWAY_ALLOCATIONS_H
+
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include "Metrics.h"
+
+using namespace std;
+
+/**
+ * Solver calls whose allocations are accounted for separately.
+ */
+enum AllocationSite {
+    MAX_FLOW_ALLOCATIONS, /**< Max flow computations (Edmonds-Karp) */
+    MIN_COST_ALLOCATIONS, /**< Min cost max flow computations */
+    REPAIR_ALLOCATIONS, /**< Max flows repaired after a segment failed */
+    ALLOCATION_SITE_COUNT
+};
+
+/**
+ * Allocations made while a scope was open.
+ */
+struct AllocationStats {
+    long long count = 0; /**< Number of allocations */
+    long long bytes = 0; /**< Bytes allocated */
+    long long peak = 0; /**< Highest number of bytes alive at once, above the ones alive when the scope started */
+};
+
+/**
+ * Accounting of the heap allocations of every thread. The counting itself is done by replacements of the global
+ * operator new and delete, which live in AllocationHooks.cpp and are only linked into the executables that want them:
+ * always into the bench, and into the program when it is built with -DRAILWAY_ALLOC_TRACKING=ON. Without the hooks
+ * every scope reports no allocations.
+ * Memory freed by a different thread than the one that allocated it is charged to the thread that frees it.
+ */
+class Allocations {
+public:
+    /**
+     * Counters of a single thread. Trivial, so the hooks can use them before and after the thread runs its constructors.
+     */
+    struct ThreadCounters {
+        long long count; /**< Number of allocations */
+        long long bytes; /**< Bytes allocated */
+        long long live; /**< Bytes allocated and not yet freed */
+        long long peak; /**< Highest value of live since the innermost scope started */
+    };
+
+    /**
+     * Checks if the allocation hooks were linked in.
+     * @return true if allocations are being counted, false otherwise
+     */
+    static bool isTracking();
+
+    /**
+     * Marks the allocation hooks as linked in. Called by the hooks themselves.
+     * @return true
+     */
+    static bool startTracking();
+
+    /**
+     * Counts an allocation of the calling thread. Must not allocate.
+     * @param bytes - the size of the allocation
+     */
+    static void onAllocate(size_t bytes) {
+        ThreadCounters &counters = local;
+        counters.count++;
+        counters.bytes += bytes;
+        counters.live += bytes;
+        if (counters.live > counters.peak) counters.peak = counters.live;
+    }
+
+    /**
+     * Counts a deallocation of the calling thread. Must not allocate.
+     * @param bytes - the size of the allocation being freed
+     */
+    static void onFree(size_t bytes) {
+        local.live -= bytes;
+    }
+
+    /**
+     * Gets the allocations of a solver call site, over all its calls.
+     * @param site - the call site
+     * @return the allocations, with the highest peak of a single call
+     */
+    static AllocationStats getSite(AllocationSite site);
+
+    /**
+     * Gets the number of calls of a solver call site.
+     * @param site - the call site
+     * @return the number of calls
+     */
+    static long long getSiteCalls(AllocationSite site);
+
+    /**
+     * Gets the number of calls of every solver call site.
+     * @return the number of calls
+     */
+    static long long getSolverCalls();
+
+    /**
+     * Records the allocations of a menu action.
+     * @param name - the name of the action
+     * @param stats - the allocations of the action
+     */
+    static void setLastAction(const string &name, const AllocationStats &stats);
+
+    /**
+     * Writes the allocations of the last menu action that used a solver and of every solver call site.
+     * @param out - the stream to write to
+     */
+    static void print(ostream &out);
+
+    /**
+     * Counts the allocations of the calling thread while it is open. Scopes can be nested.
+     */
+    class Scope {
+    public:
+        /**
+         * Starts counting.
+         */
+        Scope();
+
+        /**
+         * Starts counting on behalf of a solver call site, which gets the allocations when the scope ends.
+         * @param site - the call site
+         */
+        explicit Scope(AllocationSite site);
+
+        /**
+         * Stops counting, restoring the peak of the enclosing scope.
+         */
+        ~Scope();
+
+        /**
+         * Gets the allocations made since the scope started.
+         * @return the allocations
+         */
+        AllocationStats getStats() const;
+
+    private:
+        int site; /**< Call site that gets the allocations (-1 if none) */
+        ThreadCounters start; /**< Counters of the thread when the scope started */
+    };
+
+private:
+    /**
+     * Allocations of a solver call site, updated by every thread.
+     */
+    struct SiteCounters {
+        atomic<long long> calls; /**< Number of calls */
+        atomic<long long> count; /**< Number of allocations */
+        atomic<long long> bytes; /**< Bytes allocated */
+        atomic<long long> peak; /**< Highest peak of a single call */
+    };
+
+    static thread_local ThreadCounters local; /**< Counters of the calling thread */
+    static bool tracking; /**< True if the hooks were linked in */
+    static SiteCounters sites[ALLOCATION_SITE_COUNT]; /**< Allocations of each solver call site */
+    static mutex actionLock; /**< Protects the last action */
+    static string lastActionName; /**< Name of the last menu action */
+    static AllocationStats lastAction; /**< Allocations of the last menu action */
+};
+
+#ifdef RAILWAY_METRICS
+#define ALLOCATION_SCOPE(site) Allocations::Scope METRIC_CONCAT(allocationScope, __LINE__)(site)
+#else
+#define ALLOCATION_SCOPE(site) ((void) 0)
+#endif
+
+#endif //PROJECT_RAILWAY_ALLOCATIONS_H
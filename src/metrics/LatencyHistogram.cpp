@@ -0,0 +1,75 @@
+#include "LatencyHistogram.h"
+#include <limits>
+
+LatencyHistogram::LatencyHistogram() : count(0), max(0), firstStart(numeric_limits<long long>::max()), lastEnd(0) {
+    for (auto &bucket: counts)
+        bucket = 0;
+}
+
+int LatencyHistogram::getBucket(long long nanos) {
+    if (nanos < 2 * SUB_BUCKETS)
+        return nanos < 0 ? 0 : (int) nanos;
+
+    int highestBit = 63 - __builtin_clzll((unsigned long long) nanos);
+    int shift = highestBit - SUB_BUCKET_BITS;
+    // nanos >> shift is in [SUB_BUCKETS, 2*SUB_BUCKETS), so every power of two gets SUB_BUCKETS consecutive buckets
+    return shift * SUB_BUCKETS + (int) (nanos >> shift);
+}
+
+long long LatencyHistogram::getHighestInBucket(int bucket) {
+    if (bucket < 2 * SUB_BUCKETS)
+        return bucket;
+
+    int shift = bucket / SUB_BUCKETS - 1;
+    long long lowest = (long long) (bucket - shift * SUB_BUCKETS) << shift;
+    return lowest + (1LL << shift) - 1;
+}
+
+void LatencyHistogram::record(long long start, long long nanos) {
+    counts[getBucket(nanos)].fetch_add(1, memory_order_relaxed);
+    count.fetch_add(1, memory_order_relaxed);
+
+    long long current = max.load(memory_order_relaxed);
+    while (nanos > current && !max.compare_exchange_weak(current, nanos, memory_order_relaxed));
+
+    current = firstStart.load(memory_order_relaxed);
+    while (start < current && !firstStart.compare_exchange_weak(current, start, memory_order_relaxed));
+
+    current = lastEnd.load(memory_order_relaxed);
+    while (start + nanos > current && !lastEnd.compare_exchange_weak(current, start + nanos, memory_order_relaxed));
+}
+
+long long LatencyHistogram::getCount() const {
+    return count.load(memory_order_relaxed);
+}
+
+long long LatencyHistogram::getMax() const {
+    return max.load(memory_order_relaxed);
+}
+
+long long LatencyHistogram::getPercentile(double percentile) const {
+    long long total = getCount();
+    if (total == 0) return 0;
+
+    // The rank of the percentile, rounded up so that p100 is the highest latency
+    long long rank = (long long) (percentile / 100 * total + 0.999999);
+    if (rank < 1) rank = 1;
+
+    long long seen = 0;
+    for (int b = 0; b < BUCKETS; b++) {
+        seen += counts[b].load(memory_order_relaxed);
+        if (seen >= rank) {
+            long long highest = getHighestInBucket(b);
+            return highest < getMax() ? highest : getMax();
+        }
+    }
+
+    return getMax();
+}
+
+double LatencyHistogram::getThroughput() const {
+    long long span = lastEnd.load(memory_order_relaxed) - firstStart.load(memory_order_relaxed);
+    if (getCount() == 0 || span <= 0) return 0;
+
+    return getCount() * 1e9 / span;
+}
@@ -0,0 +1,82 @@
+#ifndef PROJECT_RAILWAY_LATENCYHISTOGRAM_H
+#define PROJECT_RAILWAY_LATENCYHISTOGRAM_H
+
+#include <atomic>
+
+using namespace std;
+
+/**
+ * Histogram of latencies with a bounded relative error, in the style of HdrHistogram.
+ * Latencies below 2*SUB_BUCKETS nanoseconds have a bucket each. Above that, every power of two is split into SUB_BUCKETS
+ * buckets of equal width, so a percentile is never off by more than 1/SUB_BUCKETS of its value (about 1.6%) while the
+ * whole range of a long long fits in a few thousand counters.
+ * Any number of threads can record at the same time.
+ */
+class LatencyHistogram {
+public:
+    static const int SUB_BUCKET_BITS = 6; /**< Bits of a latency kept exactly */
+    static const int SUB_BUCKETS = 1 << SUB_BUCKET_BITS; /**< Buckets per power of two */
+    static const int BUCKETS = (64 - SUB_BUCKET_BITS) * SUB_BUCKETS; /**< Buckets covering every positive long long */
+
+    /**
+     * Constructor, with no latencies.
+     */
+    LatencyHistogram();
+
+    /**
+     * Records a latency.
+     * Time Complexity: O(1)
+     * @param start - the start of the measurement, in nanoseconds since an origin shared by every measurement
+     * @param nanos - the latency, in nanoseconds
+     */
+    void record(long long start, long long nanos);
+
+    /**
+     * Gets the number of recorded latencies.
+     * @return the number of latencies
+     */
+    long long getCount() const;
+
+    /**
+     * Gets the highest recorded latency.
+     * @return the highest latency, in nanoseconds
+     */
+    long long getMax() const;
+
+    /**
+     * Gets the latency below which a percentage of the recorded latencies fall.
+     * Time Complexity: O(B), where B is the number of buckets.
+     * @param percentile - the percentage, between 0 and 100
+     * @return the latency, in nanoseconds (0 if nothing was recorded)
+     */
+    long long getPercentile(double percentile) const;
+
+    /**
+     * Gets the number of latencies recorded per second, between the start of the first one and the end of the last one.
+     * @return the throughput, in latencies per second
+     */
+    double getThroughput() const;
+
+private:
+    atomic<long long> counts[BUCKETS]; /**< Number of latencies in each bucket */
+    atomic<long long> count; /**< Number of latencies */
+    atomic<long long> max; /**< Highest latency */
+    atomic<long long> firstStart; /**< Earliest start of a measurement */
+    atomic<long long> lastEnd; /**< Latest end of a measurement */
+
+    /**
+     * Gets the bucket of a latency.
+     * @param nanos - the latency, in nanoseconds
+     * @return the index of the bucket
+     */
+    static int getBucket(long long nanos);
+
+    /**
+     * Gets the highest latency that falls in a bucket.
+     * @param bucket - the index of the bucket
+     * @return the latency, in nanoseconds
+     */
+    static long long getHighestInBucket(int bucket);
+};
+
+#endif //PROJECT_RAILWAY_LATENCYHISTOGRAM_H
@@ -0,0 +1,223 @@
+#include "Metrics.h"
+#include <algorithm>
+#include <iomanip>
+
+mutex Metrics::registryLock;
+vector<const Metrics::ThreadBlock *> Metrics::registry;
+MetricsSnapshot Metrics::finished;
+MetricsSnapshot Metrics::analysisStart;
+string Metrics::analysisName;
+MetricsSnapshot Metrics::lastAnalysis;
+string Metrics::lastAnalysisName;
+LatencyHistogram Metrics::latencies[LATENCY_COUNT];
+const chrono::steady_clock::time_point Metrics::origin = chrono::steady_clock::now();
+
+MetricsSnapshot MetricsSnapshot::operator-(const MetricsSnapshot &before) const {
+    MetricsSnapshot diff;
+    for (int c = 0; c < COUNTER_COUNT; c++)
+        diff.counters[c] = counters[c] - before.counters[c];
+    for (int t = 0; t < TIMER_COUNT; t++) {
+        diff.nanos[t] = nanos[t] - before.nanos[t];
+        diff.calls[t] = calls[t] - before.calls[t];
+    }
+
+    return diff;
+}
+
+bool MetricsSnapshot::isEmpty() const {
+    for (long long value: counters)
+        if (value != 0) return false;
+    for (long long value: calls)
+        if (value != 0) return false;
+
+    return true;
+}
+
+Metrics::ThreadBlock::ThreadBlock() {
+    for (auto &value: counters) value = 0;
+    for (auto &value: nanos) value = 0;
+    for (auto &value: calls) value = 0;
+
+    lock_guard<mutex> guard(registryLock);
+    registry.push_back(this);
+}
+
+Metrics::ThreadBlock::~ThreadBlock() {
+    lock_guard<mutex> guard(registryLock);
+    addTo(finished);
+    registry.erase(find(registry.begin(), registry.end(), this));
+}
+
+void Metrics::ThreadBlock::addTo(MetricsSnapshot &snapshot) const {
+    for (int c = 0; c < COUNTER_COUNT; c++)
+        snapshot.counters[c] += counters[c].load(memory_order_relaxed);
+    for (int t = 0; t < TIMER_COUNT; t++) {
+        snapshot.nanos[t] += nanos[t].load(memory_order_relaxed);
+        snapshot.calls[t] += calls[t].load(memory_order_relaxed);
+    }
+}
+
+Metrics::ThreadBlock &Metrics::local() {
+    thread_local ThreadBlock block;
+    return block;
+}
+
+bool Metrics::isEnabled() {
+#ifdef RAILWAY_METRICS
+    return true;
+#else
+    return false;
+#endif
+}
+
+void Metrics::add(Counter counter, long long amount) {
+    // Only this thread writes the block, so a plain load and store is enough (no locked add)
+    auto &value = local().counters[counter];
+    value.store(value.load(memory_order_relaxed) + amount, memory_order_relaxed);
+}
+
+void Metrics::addTime(Timer timer, long long nanos) {
+    ThreadBlock &block = local();
+    block.nanos[timer].store(block.nanos[timer].load(memory_order_relaxed) + nanos, memory_order_relaxed);
+    block.calls[timer].store(block.calls[timer].load(memory_order_relaxed) + 1, memory_order_relaxed);
+}
+
+MetricsSnapshot Metrics::collect() {
+    lock_guard<mutex> guard(registryLock);
+    MetricsSnapshot snapshot = finished;
+    for (const ThreadBlock *block: registry)
+        block->addTo(snapshot);
+
+    return snapshot;
+}
+
+void Metrics::beginAnalysis(const string &name) {
+    MetricsSnapshot start = collect();
+
+    lock_guard<mutex> guard(registryLock);
+    analysisStart = start;
+    analysisName = name;
+}
+
+void Metrics::endAnalysis() {
+    MetricsSnapshot end = collect();
+
+    lock_guard<mutex> guard(registryLock);
+    MetricsSnapshot analysis = end - analysisStart;
+    if (analysis.isEmpty()) return;
+
+    lastAnalysis = analysis;
+    lastAnalysisName = analysisName;
+}
+
+string Metrics::getLastAnalysisName() {
+    lock_guard<mutex> guard(registryLock);
+    return lastAnalysisName;
+}
+
+MetricsSnapshot Metrics::getLastAnalysis() {
+    lock_guard<mutex> guard(registryLock);
+    return lastAnalysis;
+}
+
+void Metrics::print(ostream &out, const MetricsSnapshot &snapshot) {
+    static const char *counterNames[COUNTER_COUNT] = {"Max flow solves", "Min cost solves", "Flow repairs",
+                                                      "Path searches", "Augmenting paths", "Arcs scanned",
+                                                      "Bellman-Ford rounds", "Vertices visited", "Pushes",
+                                                      "Relabels"};
+    static const char *timerNames[TIMER_COUNT] = {"Max flow", "Min cost max flow", "Flow repairs", "Workspace prepare"};
+
+    if (!isEnabled()) {
+        out << "Metrics are disabled (build with -DRAILWAY_METRICS=ON)" << endl;
+        return;
+    }
+
+    long long solves = snapshot.counters[MAX_FLOW_SOLVES] + snapshot.counters[MIN_COST_SOLVES] + snapshot.counters[FLOW_REPAIRS];
+    ios state(nullptr);
+    state.copyfmt(out);
+
+    out << left << setw(22) << "Counter" << right << setw(16) << "Total" << setw(14) << "Per solve" << endl;
+    for (int c = 0; c < COUNTER_COUNT; c++) {
+        out << left << setw(22) << counterNames[c] << right << setw(16) << snapshot.counters[c];
+        if (solves > 0 && c >= PATH_SEARCHES)
+            out << setw(14) << fixed << setprecision(1) << (double) snapshot.counters[c] / solves;
+        out << endl;
+    }
+
+    out << endl << left << setw(22) << "Timer" << right << setw(16) << "Calls" << setw(14) << "Total (ms)"
+        << setw(14) << "Mean (us)" << endl;
+    for (int t = 0; t < TIMER_COUNT; t++) {
+        double total = snapshot.nanos[t] / 1e6;
+        double mean = snapshot.calls[t] == 0 ? 0 : snapshot.nanos[t] / 1e3 / snapshot.calls[t];
+        out << left << setw(22) << timerNames[t] << right << setw(16) << snapshot.calls[t] << fixed << setprecision(2)
+            << setw(14) << total << setw(14) << mean << endl;
+    }
+
+    out.copyfmt(state);
+}
+
+void Metrics::addLatency(Latency latency, chrono::steady_clock::time_point start, long long nanos) {
+    latencies[latency].record(chrono::duration_cast<chrono::nanoseconds>(start - origin).count(), nanos);
+}
+
+bool Metrics::hasLatencies() {
+    for (const LatencyHistogram &histogram: latencies)
+        if (histogram.getCount() > 0) return true;
+
+    return false;
+}
+
+void Metrics::printLatencies(ostream &out) {
+    static const char *latencyNames[LATENCY_COUNT] = {"Max flow", "Min cost max flow", "Single point flow",
+                                                      "Region top-k", "Segment failure", "Cheapest route",
+                                                      "Edmonds-Karp", "Successive paths", "Cost scaling",
+                                                      "Warm min cost", "Flow repair"};
+
+    if (!isEnabled()) {
+        out << "Metrics are disabled (build with -DRAILWAY_METRICS=ON)" << endl;
+        return;
+    }
+
+    ios state(nullptr);
+    state.copyfmt(out);
+    out << fixed << setprecision(3);
+
+    for (int section = 0; section < 2; section++) {
+        int begin = section == 0 ? 0 : FIRST_ENGINE_LATENCY, end = section == 0 ? FIRST_ENGINE_LATENCY : LATENCY_COUNT;
+        bool empty = true;
+        for (int l = begin; l < end; l++)
+            if (latencies[l].getCount() > 0) empty = false;
+        if (empty) continue;
+
+        out << left << setw(20) << (section == 0 ? "Query (ms)" : "Engine (ms)") << right << setw(10) << "Count"
+            << setw(11) << "p50" << setw(11) << "p90" << setw(11) << "p99" << setw(11) << "p99.9" << setw(11) << "Max"
+            << setw(12) << "Per second" << endl;
+
+        for (int l = begin; l < end; l++) {
+            const LatencyHistogram &histogram = latencies[l];
+            if (histogram.getCount() == 0) continue;
+
+            out << left << setw(20) << latencyNames[l] << right << setw(10) << histogram.getCount();
+            for (double percentile: {50.0, 90.0, 99.0, 99.9})
+                out << setw(11) << histogram.getPercentile(percentile) / 1e6;
+            out << setw(11) << histogram.getMax() / 1e6 << setw(12) << setprecision(1) << histogram.getThroughput()
+                << setprecision(3) << endl;
+        }
+
+        out << endl;
+    }
+
+    out.copyfmt(state);
+}
+
+Metrics::ScopedTimer::ScopedTimer(Timer timer) : timer(timer), start(chrono::steady_clock::now()) {}
+
+Metrics::ScopedTimer::~ScopedTimer() {
+    addTime(timer, chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - start).count());
+}
+
+Metrics::ScopedLatency::ScopedLatency(Latency latency) : latency(latency), start(chrono::steady_clock::now()) {}
+
+Metrics::ScopedLatency::~ScopedLatency() {
+    addLatency(latency, start, chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - start).count());
+}
@@ -0,0 +1,269 @@
+#ifndef PROJECT_RAILWAY_METRICS_H
+#define PROJECT_RAILWAY_METRICS_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+#include "LatencyHistogram.h"
+
+using namespace std;
+
+/**
+ * Events counted by the solvers.
+ */
+enum Counter {
+    MAX_FLOW_SOLVES, /**< Max flow computations (Edmonds-Karp) */
+    MIN_COST_SOLVES, /**< Min cost max flow computations */
+    FLOW_REPAIRS, /**< Max flows repaired after a segment failed */
+    PATH_SEARCHES, /**< BFS searches for an augmenting path */
+    AUGMENTING_PATHS, /**< Augmenting paths applied to a flow */
+    ARCS_SCANNED, /**< Arcs looked at by the searches */
+    BELLMAN_FORD_ROUNDS, /**< Relaxation rounds of the cheapest path searches */
+    VERTICES_VISITED, /**< Vertices reached by the augmenting path searches */
+    PUSHES, /**< Pushes of the cost-scaling refines */
+    RELABELS, /**< Relabels of the cost-scaling refines */
+    COUNTER_COUNT
+};
+
+/**
+ * Solver phases whose time is measured.
+ */
+enum Timer {
+    MAX_FLOW_TIME, /**< Time spent in max flow computations */
+    MIN_COST_TIME, /**< Time spent in min cost max flow computations */
+    REPAIR_TIME, /**< Time spent repairing max flows */
+    PREPARE_TIME, /**< Time spent sizing and clearing workspaces */
+    TIMER_COUNT
+};
+
+/**
+ * Latencies kept as histograms: the queries of the menus by type, and every solve by the engine that ran it.
+ */
+enum Latency {
+    MAX_FLOW_QUERY, /**< Max flow between two stations, or between every pair of line extremes */
+    MIN_COST_QUERY, /**< Min cost max flow between two stations */
+    SINGLE_POINT_QUERY, /**< Max flow from every line extreme into a station */
+    REGION_TOP_K_QUERY, /**< Flows of every municipality or district */
+    SEGMENT_FAILURE_QUERY, /**< Analyses of failed segments */
+    CHEAPEST_ROUTE_QUERY, /**< Cheapest route from a station, to another one or to all of them */
+    EDMONDS_KARP_SOLVE, /**< Max flows solved by Edmonds-Karp */
+    SUCCESSIVE_SHORTEST_PATHS_SOLVE, /**< Min cost max flows solved by successive cheapest paths */
+    COST_SCALING_SOLVE, /**< Min cost max flows solved by cost scaling */
+    WARM_MIN_COST_SOLVE, /**< Min cost max flows re-optimized from the last one */
+    FLOW_REPAIR_SOLVE, /**< Max flows repaired after a segment failed */
+    LATENCY_COUNT
+};
+
+const Latency FIRST_ENGINE_LATENCY = EDMONDS_KARP_SOLVE; /**< Latencies from here on are kept by engine */
+
+/**
+ * Values of every counter and timer at some point, or the difference between two points.
+ */
+struct MetricsSnapshot {
+    array<long long, COUNTER_COUNT> counters{}; /**< Value of each counter */
+    array<long long, TIMER_COUNT> nanos{}; /**< Time measured by each timer, in nanoseconds */
+    array<long long, TIMER_COUNT> calls{}; /**< Number of measurements of each timer */
+
+    /**
+     * Gets what happened between two snapshots.
+     * @param before - the earlier snapshot
+     * @return the difference of every counter and timer
+     */
+    MetricsSnapshot operator-(const MetricsSnapshot &before) const;
+
+    /**
+     * Checks if nothing was counted or measured.
+     * @return true if every counter and timer is 0, false otherwise
+     */
+    bool isEmpty() const;
+};
+
+/**
+ * Low-overhead metrics of the solvers, switched on at compile time by the RAILWAY_METRICS definition (the CMake option of
+ * the same name). When it is off the METRIC_* macros expand to nothing, so the solvers pay nothing for them.
+ * Each thread counts into its own block, which only that thread writes, so counting needs no locks or atomic
+ * read-modify-write instructions; collect() adds the blocks of every thread, including the ones that already finished.
+ * Analyses are measured as the difference between the snapshots taken at their start and end.
+ */
+class Metrics {
+public:
+    /**
+     * Checks if the metrics were compiled in.
+     * @return true if RAILWAY_METRICS was defined, false otherwise
+     */
+    static bool isEnabled();
+
+    /**
+     * Adds to a counter of the calling thread.
+     * @param counter - the counter
+     * @param amount - the amount to add
+     */
+    static void add(Counter counter, long long amount);
+
+    /**
+     * Adds a measurement to a timer of the calling thread.
+     * @param timer - the timer
+     * @param nanos - the measured time, in nanoseconds
+     */
+    static void addTime(Timer timer, long long nanos);
+
+    /**
+     * Adds the counters and timers of every thread.
+     * Time Complexity: O(T), where T is the number of threads that are counting.
+     * @return the totals since the program started
+     */
+    static MetricsSnapshot collect();
+
+    /**
+     * Marks the start of an analysis.
+     * @param name - the name of the analysis
+     */
+    static void beginAnalysis(const string &name);
+
+    /**
+     * Marks the end of the current analysis. It becomes the last analysis if it used any solver.
+     */
+    static void endAnalysis();
+
+    /**
+     * Gets the name of the last analysis that used a solver.
+     * @return the name of the analysis (empty if none)
+     */
+    static string getLastAnalysisName();
+
+    /**
+     * Gets the metrics of the last analysis that used a solver.
+     * @return the metrics of the analysis
+     */
+    static MetricsSnapshot getLastAnalysis();
+
+    /**
+     * Writes a snapshot as a table, with the averages per solve.
+     * @param out - the stream to write to
+     * @param snapshot - the snapshot
+     */
+    static void print(ostream &out, const MetricsSnapshot &snapshot);
+
+    /**
+     * Adds a latency to its histogram.
+     * @param latency - the histogram
+     * @param start - the start of the measurement
+     * @param nanos - the latency, in nanoseconds
+     */
+    static void addLatency(Latency latency, chrono::steady_clock::time_point start, long long nanos);
+
+    /**
+     * Checks if any latency was recorded.
+     * @return true if some histogram has latencies, false otherwise
+     */
+    static bool hasLatencies();
+
+    /**
+     * Writes the percentiles and throughput of every histogram with latencies, queries first and engines second.
+     * Time Complexity: O(L*B), where L is the number of histograms and B is the number of buckets of each one.
+     * @param out - the stream to write to
+     */
+    static void printLatencies(ostream &out);
+
+    /**
+     * Measures the time of a scope and adds it to a timer when the scope ends.
+     */
+    class ScopedTimer {
+    public:
+        /**
+         * Starts measuring.
+         * @param timer - the timer that gets the measurement
+         */
+        explicit ScopedTimer(Timer timer);
+
+        /**
+         * Stops measuring and adds the measurement to the timer.
+         */
+        ~ScopedTimer();
+
+    private:
+        Timer timer; /**< Timer that gets the measurement */
+        chrono::steady_clock::time_point start; /**< Start of the measurement */
+    };
+
+    /**
+     * Measures the latency of a scope and adds it to a histogram when the scope ends.
+     */
+    class ScopedLatency {
+    public:
+        /**
+         * Starts measuring.
+         * @param latency - the histogram that gets the latency
+         */
+        explicit ScopedLatency(Latency latency);
+
+        /**
+         * Stops measuring and adds the latency to the histogram.
+         */
+        ~ScopedLatency();
+
+    private:
+        Latency latency; /**< Histogram that gets the latency */
+        chrono::steady_clock::time_point start; /**< Start of the measurement */
+    };
+
+private:
+    /**
+     * Counters and timers of a single thread. Only the owning thread writes them; other threads only read them.
+     */
+    struct ThreadBlock {
+        array<atomic<long long>, COUNTER_COUNT> counters; /**< Value of each counter */
+        array<atomic<long long>, TIMER_COUNT> nanos; /**< Time measured by each timer, in nanoseconds */
+        array<atomic<long long>, TIMER_COUNT> calls; /**< Number of measurements of each timer */
+
+        /**
+         * Registers the block, so collect() can find it.
+         */
+        ThreadBlock();
+
+        /**
+         * Adds the block to the totals of the finished threads and unregisters it.
+         */
+        ~ThreadBlock();
+
+        /**
+         * Adds the values of the block to a snapshot.
+         * @param snapshot - the snapshot
+         */
+        void addTo(MetricsSnapshot &snapshot) const;
+    };
+
+    static mutex registryLock; /**< Protects the registry, the finished totals and the analyses */
+    static vector<const ThreadBlock *> registry; /**< Blocks of the threads that are still running */
+    static MetricsSnapshot finished; /**< Totals of the threads that already finished */
+    static MetricsSnapshot analysisStart; /**< Snapshot taken at the start of the current analysis */
+    static string analysisName; /**< Name of the current analysis */
+    static MetricsSnapshot lastAnalysis; /**< Metrics of the last analysis that used a solver */
+    static string lastAnalysisName; /**< Name of the last analysis that used a solver */
+    static LatencyHistogram latencies[LATENCY_COUNT]; /**< Histogram of each kind of latency */
+    static const chrono::steady_clock::time_point origin; /**< Origin of the starts of the latencies */
+
+    /**
+     * Gets the block of the calling thread, creating it on first use.
+     * @return the block of the thread
+     */
+    static ThreadBlock &local();
+};
+
+#ifdef RAILWAY_METRICS
+#define METRIC_CONCAT_(a, b) a##b
+#define METRIC_CONCAT(a, b) METRIC_CONCAT_(a, b)
+#define METRIC_ADD(counter, amount) Metrics::add(counter, amount)
+#define METRIC_TIME(timer) Metrics::ScopedTimer METRIC_CONCAT(metricTimer, __LINE__)(timer)
+#define METRIC_LATENCY(latency) Metrics::ScopedLatency METRIC_CONCAT(metricLatency, __LINE__)(latency)
+#else
+#define METRIC_ADD(counter, amount) ((void) 0)
+#define METRIC_TIME(timer) ((void) 0)
+#define METRIC_LATENCY(latency) ((void) 0)
+#endif
+
+#endif //PROJECT_RAILWAY_METRICS_H
@@ -0,0 +1,116 @@
+#include "Trace.h"
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+
+string Trace::path;
+chrono::steady_clock::time_point Trace::origin = chrono::steady_clock::now();
+mutex Trace::lock;
+vector<unique_ptr<Trace::Buffer>> Trace::buffers;
+vector<Trace::Buffer *> Trace::freeBuffers;
+bool Trace::enabled = Trace::initialize();
+
+bool Trace::initialize() {
+    const char *env = getenv("RAILWAY_TRACE");
+    if (env == nullptr || *env == '\0') return false;
+
+    path = env;
+    return true;
+}
+
+Trace::Holder::~Holder() {
+    if (buffer == nullptr) return;
+
+    lock_guard<mutex> guard(lock);
+    freeBuffers.push_back(buffer);
+}
+
+Trace::Buffer &Trace::local(const string &name) {
+    thread_local Holder holder;
+    if (holder.buffer != nullptr) return *holder.buffer;
+
+    lock_guard<mutex> guard(lock);
+    if (!freeBuffers.empty()) {
+        // A free row with the same name is reused first, then the lowest one, so the workers keep their rows across runs
+        auto picked = freeBuffers.begin();
+        for (auto it = freeBuffers.begin(); it != freeBuffers.end(); it++) {
+            bool sameName = !name.empty() && (*it)->threadName == name;
+            if (sameName || (*it)->id < (*picked)->id) picked = it;
+            if (sameName) break;
+        }
+
+        holder.buffer = *picked;
+        freeBuffers.erase(picked);
+    }
+    else {
+        buffers.emplace_back(new Buffer());
+        holder.buffer = buffers.back().get();
+        holder.buffer->id = (int) buffers.size();
+        holder.buffer->threadName = "thread " + to_string(buffers.size());
+    }
+
+    return *holder.buffer;
+}
+
+void Trace::record(const char *category, const string &name, chrono::steady_clock::time_point start,
+                   const string &args) {
+    auto end = chrono::steady_clock::now();
+    Event event;
+    event.category = category;
+    event.name = name;
+    event.start = chrono::duration_cast<chrono::microseconds>(start - origin).count();
+    event.duration = chrono::duration_cast<chrono::microseconds>(end - start).count();
+    event.args = args;
+
+    local().events.push_back(move(event));
+}
+
+void Trace::setThreadName(const string &name) {
+    if (enabled) local(name).threadName = name;
+}
+
+string Trace::escape(const string &text) {
+    string escaped;
+    for (char c: text) {
+        if (c == '"' || c == '\\') {
+            escaped += '\\';
+            escaped += c;
+        }
+        else if ((unsigned char) c < 0x20) {
+            char code[8];
+            snprintf(code, sizeof(code), "\\u%04x", c);
+            escaped += code;
+        }
+        else {
+            escaped += c;
+        }
+    }
+
+    return escaped;
+}
+
+bool Trace::write() {
+    if (!enabled) return false;
+
+    ofstream file(path);
+    if (!file.is_open()) return false;
+
+    lock_guard<mutex> guard(lock);
+    file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    bool first = true;
+
+    for (const auto &buffer: buffers) {
+        file << (first ? "\n" : ",\n") << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer->id
+             << ",\"args\":{\"name\":\"" << escape(buffer->threadName) << "\"}}";
+        first = false;
+
+        for (const Event &event: buffer->events) {
+            file << ",\n{\"name\":\"" << escape(event.name) << "\",\"cat\":\"" << event.category
+                 << "\",\"ph\":\"X\",\"ts\":" << event.start << ",\"dur\":" << event.duration << ",\"pid\":1,\"tid\":"
+                 << buffer->id << ",\"args\":{" << event.args << "}}";
+        }
+    }
+
+    file << "\n]}\n";
+    return file.good();
+}
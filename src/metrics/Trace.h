@@ -0,0 +1,175 @@
+#ifndef PROJECT_RAILWAY_TRACE_H
+#define PROJECT_RAILWAY_TRACE_H
+
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+/**
+ * Timeline of the program in the Chrome trace event format, which chrome://tracing and Perfetto can open.
+ * Tracing is switched on by setting the RAILWAY_TRACE environment variable to the path of the file to write, and the
+ * events are written by write(), usually when the program ends. When it is off, a TraceScope only checks a flag.
+ * Each thread records into its own buffer. A thread that finishes gives its buffer back, and the next thread that starts
+ * tracing reuses it, so the workers of the successive WorkStealingPools show up as the same few rows of the timeline.
+ */
+class Trace {
+public:
+    /**
+     * Checks if tracing is on.
+     * @return true if the RAILWAY_TRACE environment variable was set, false otherwise
+     */
+    static bool isEnabled() {
+        return enabled;
+    }
+
+    /**
+     * Records a complete event of the calling thread.
+     * @param category - the category of the event
+     * @param name - the name of the event
+     * @param start - the start of the event
+     * @param args - the arguments of the event, as the members of a JSON object (may be empty)
+     */
+    static void record(const char *category, const string &name, chrono::steady_clock::time_point start,
+                       const string &args);
+
+    /**
+     * Names the row of the calling thread in the timeline.
+     * @param name - the name of the thread
+     */
+    static void setThreadName(const string &name);
+
+    /**
+     * Writes every event recorded so far to the file given by RAILWAY_TRACE. Does nothing if tracing is off.
+     * Must be called when no other thread is recording.
+     * Time Complexity: O(N), where N is the number of events.
+     * @return true if the file was written, false otherwise
+     */
+    static bool write();
+
+private:
+    /**
+     * Event that was already finished.
+     */
+    struct Event {
+        const char *category; /**< Category of the event */
+        string name; /**< Name of the event */
+        long long start; /**< Start of the event, in microseconds since tracing started */
+        long long duration; /**< Duration of the event, in microseconds */
+        string args; /**< Arguments of the event, as the members of a JSON object */
+    };
+
+    /**
+     * Events of a thread, or of a sequence of threads that reused it.
+     */
+    struct Buffer {
+        int id; /**< Row of the timeline */
+        string threadName; /**< Name of the row */
+        vector<Event> events; /**< Events recorded in the buffer */
+    };
+
+    /**
+     * Gives the buffer of a thread back when the thread finishes.
+     */
+    struct Holder {
+        Buffer *buffer = nullptr; /**< Buffer of the thread (nullptr until it records an event) */
+
+        /**
+         * Gives the buffer back, so another thread can reuse it.
+         */
+        ~Holder();
+    };
+
+    static bool enabled; /**< True if RAILWAY_TRACE was set */
+    static string path; /**< File the events are written to */
+    static chrono::steady_clock::time_point origin; /**< Time at which tracing started */
+    static mutex lock; /**< Protects the buffers */
+    static vector<unique_ptr<Buffer>> buffers; /**< Every buffer, in the order they were created */
+    static vector<Buffer *> freeBuffers; /**< Buffers of the threads that already finished */
+
+    /**
+     * Reads the RAILWAY_TRACE environment variable.
+     * @return true if tracing is on, false otherwise
+     */
+    static bool initialize();
+
+    /**
+     * Gets the buffer of the calling thread, taking a free one or creating one on first use.
+     * @param name - the name of the thread, to prefer a free buffer that had the same name (may be empty)
+     * @return the buffer of the thread
+     */
+    static Buffer &local(const string &name = "");
+
+    /**
+     * Escapes a string so it can be written inside a JSON string.
+     * @param text - the string
+     * @return the escaped string
+     */
+    static string escape(const string &text);
+};
+
+/**
+ * Event that lasts as long as the scope that declares it. It costs a single check when tracing is off.
+ */
+class TraceScope {
+public:
+    /**
+     * Starts an event.
+     * @param category - the category of the event (must outlive the trace, e.g. a string literal)
+     * @param name - the name of the event
+     */
+    TraceScope(const char *category, const char *name) : active(Trace::isEnabled()) {
+        if (active) begin(category, name);
+    }
+
+    /**
+     * Starts an event with a name built at run time.
+     * @param category - the category of the event (must outlive the trace, e.g. a string literal)
+     * @param name - the name of the event
+     */
+    TraceScope(const char *category, const string &name) : active(Trace::isEnabled()) {
+        if (active) begin(category, name);
+    }
+
+    /**
+     * Adds an argument to the event.
+     * @param key - the name of the argument
+     * @param value - the value of the argument
+     */
+    void addArg(const char *key, long long value) {
+        if (active) args += (args.empty() ? "\"" : ",\"") + string(key) + "\":" + to_string(value);
+    }
+
+    /**
+     * Records the event.
+     */
+    ~TraceScope() {
+        if (active) Trace::record(category, name, start, args);
+    }
+
+    TraceScope(const TraceScope &) = delete;
+    TraceScope &operator=(const TraceScope &) = delete;
+
+private:
+    bool active; /**< True if the event is being recorded */
+    const char *category = nullptr; /**< Category of the event */
+    string name; /**< Name of the event */
+    string args; /**< Arguments of the event */
+    chrono::steady_clock::time_point start; /**< Start of the event */
+
+    /**
+     * Sets the event up and starts measuring it.
+     * @param category - the category of the event
+     * @param name - the name of the event
+     */
+    void begin(const char *category, const string &name) {
+        this->category = category;
+        this->name = name;
+        start = chrono::steady_clock::now();
+    }
+};
+
+#endif //PROJECT_RAILWAY_TRACE_H
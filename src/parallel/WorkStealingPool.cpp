@@ -0,0 +1,152 @@
+#include "WorkStealingPool.h"
+#include <cstdlib>
+#include "metrics/Trace.h"
+
+WorkStealingPool::WorkStealingPool(unsigned nThreads) : cancelled(false) {
+    this->nThreads = nThreads == 0 ? getDefaultThreadCount() : nThreads;
+    queues = vector<WorkerQueue>(this->nThreads);
+    for (unsigned w = 1; w < this->nThreads; w++)
+        threads.emplace_back(&WorkStealingPool::workerLoop, this, w);
+}
+
+WorkStealingPool::~WorkStealingPool() {
+    {
+        lock_guard<mutex> guard(runLock);
+        stopping = true;
+    }
+    runStarted.notify_all();
+
+    for (auto &t: threads)
+        t.join();
+}
+
+unsigned WorkStealingPool::getThreadCount() const {
+    return nThreads;
+}
+
+unsigned WorkStealingPool::getDefaultThreadCount() {
+    const char *env = getenv("RAILWAY_THREADS");
+    if (env != nullptr) {
+        int n = atoi(env);
+        if (n > 0) return n;
+    }
+
+    unsigned n = thread::hardware_concurrency();
+    return n == 0 ? 1 : n;
+}
+
+void WorkStealingPool::setProgressCallback(const function<void(size_t, size_t)> &callback) {
+    progressCallback = callback;
+}
+
+void WorkStealingPool::cancel() {
+    cancelled = true;
+}
+
+bool WorkStealingPool::isCancelled() const {
+    return cancelled;
+}
+
+bool WorkStealingPool::nextTask(unsigned worker, size_t &task) {
+    {
+        lock_guard<mutex> guard(queues[worker].lock);
+        if (!queues[worker].tasks.empty()) {
+            task = queues[worker].tasks.back();
+            queues[worker].tasks.pop_back();
+            return true;
+        }
+    }
+
+    for (unsigned i = 1; i < runWorkers; i++) {
+        auto &victim = queues[(worker + i) % runWorkers];
+        lock_guard<mutex> guard(victim.lock);
+        if (!victim.tasks.empty()) {
+            task = victim.tasks.front();
+            victim.tasks.pop_front();
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void WorkStealingPool::reportProgress() {
+    lock_guard<mutex> guard(progressLock);
+    progressCallback(++finishedTasks, runTasks);
+}
+
+void WorkStealingPool::workerLoop(unsigned worker) {
+    Trace::setThreadName("worker " + to_string(worker));
+    unsigned long long joined = 0;
+
+    while (true) {
+        {
+            unique_lock<mutex> guard(runLock);
+            runStarted.wait(guard, [this, joined]() { return stopping || generation != joined; });
+            if (stopping) return;
+            joined = generation;
+            if (worker >= runWorkers) continue;
+        }
+
+        work(worker);
+
+        lock_guard<mutex> guard(runLock);
+        if (--busyWorkers == 0) runEnded.notify_one();
+    }
+}
+
+void WorkStealingPool::work(unsigned worker) {
+    TraceScope workerTrace("pool", "worker");
+    workerTrace.addArg("worker", worker);
+
+    size_t i;
+    while (!cancelled && nextTask(worker, i)) {
+        (*runTask)(i, worker);
+        if (progressCallback) reportProgress();
+    }
+}
+
+bool WorkStealingPool::parallelFor(size_t n, const function<void(size_t, unsigned)> &task) {
+    unsigned workers = n < nThreads ? n : nThreads;
+    runTasks = n;
+    finishedTasks = 0;
+
+    TraceScope trace("pool", "parallelFor");
+    trace.addArg("tasks", n);
+    trace.addArg("workers", workers);
+
+    if (workers <= 1) {
+        for (size_t i = 0; i < n && !cancelled; i++) {
+            task(i, 0);
+            if (progressCallback) reportProgress();
+        }
+    }
+    else {
+        for (unsigned w = 0; w < workers; w++) {
+            size_t begin = n * w / workers, end = n * (w + 1) / workers;
+            // A cancelled run can leave tasks behind
+            queues[w].tasks.clear();
+            // Pushed in reverse so that the owner pops its block in increasing order
+            for (size_t i = end; i > begin; i--)
+                queues[w].tasks.push_back(i - 1);
+        }
+
+        {
+            lock_guard<mutex> guard(runLock);
+            runTask = &task;
+            runWorkers = workers;
+            busyWorkers = workers - 1;
+            generation++;
+        }
+        runStarted.notify_all();
+
+        work(0);
+
+        unique_lock<mutex> guard(runLock);
+        runEnded.wait(guard, [this]() { return busyWorkers == 0; });
+        runTask = nullptr;
+    }
+
+    // The cancel only stops the run it reached, the next one starts over
+    return !cancelled.exchange(false);
+}
@@ -0,0 +1,149 @@
+#ifndef PROJECT_RAILWAY_WORKSTEALINGPOOL_H
+#define PROJECT_RAILWAY_WORKSTEALINGPOOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+/**
+ * Runs independent tasks over a fixed number of worker threads.
+ * Each worker starts with a contiguous block of tasks in its own deque and pops them from the back; a worker that runs
+ * out of tasks steals from the front of another worker's deque, so long max flow solves do not leave threads idle.
+ * The workers are started by the constructor and wait for the next run between two calls of parallelFor (the calling
+ * thread is worker 0), so a pool shared by every analysis of the program starts its threads only once.
+ * A run can be cancelled (the tasks that already started still finish) and reports its progress to an optional callback.
+ */
+class WorkStealingPool {
+public:
+    /**
+     * Constructor
+     * @param nThreads - the number of workers (0 uses getDefaultThreadCount())
+     */
+    explicit WorkStealingPool(unsigned nThreads = 0);
+
+    /**
+     * Destructor. Stops and joins the workers.
+     */
+    ~WorkStealingPool();
+
+    /**
+     * Gets the number of workers of the pool.
+     * @return the number of workers
+     */
+    unsigned getThreadCount() const;
+
+    /**
+     * Gets the number of workers used by pools created without an explicit count. It is the value of the RAILWAY_THREADS
+     * environment variable when set to a positive number, and one worker per hardware thread otherwise.
+     * @return the default number of workers
+     */
+    static unsigned getDefaultThreadCount();
+
+    /**
+     * Sets the function called after each finished task with the number of finished tasks and the total of the run.
+     * Calls are serialized, so the callback does not need to be thread safe.
+     * @param callback - the callback (an empty function disables the reports)
+     */
+    void setProgressCallback(const function<void(size_t, size_t)> &callback);
+
+    /**
+     * Stops the current run: the workers don't start any new task. Can be called from a task or from the progress callback.
+     * A cancel made between two runs stops the next one before its first task. The flag is cleared when the run it
+     * stopped returns.
+     */
+    void cancel();
+
+    /**
+     * Checks if the current run was cancelled, so long tasks can stop early.
+     * @return true if the run was cancelled, false otherwise
+     */
+    bool isCancelled() const;
+
+    /**
+     * Runs task(i, worker) for every i in [0, n) and waits for all of them to finish. The worker index is in
+     * [0, getThreadCount()) and can be used to pick per-worker scratch state.
+     * @param n - the number of tasks
+     * @param task - the function to run for each task
+     * @return true if every task ran, false if the run was cancelled
+     */
+    bool parallelFor(size_t n, const function<void(size_t, unsigned)> &task);
+
+    /**
+     * Runs task(i, workspace) for every i in [0, n), where workspace is owned by the worker running the task, so the
+     * scratch state of a solver is allocated once per worker instead of once per task.
+     * @tparam Workspace - the type of the workspace (default constructible)
+     * @param n - the number of tasks
+     * @param task - the function to run for each task
+     * @return true if every task ran, false if the run was cancelled
+     */
+    template <class Workspace>
+    bool parallelFor(size_t n, const function<void(size_t, Workspace &)> &task);
+
+private:
+    /**
+     * Deque of task indices owned by a worker.
+     */
+    struct WorkerQueue {
+        deque<size_t> tasks; /**< Tasks still to be run */
+        mutex lock; /**< Protects the tasks deque */
+    };
+
+    unsigned nThreads; /**< Number of workers */
+    atomic<bool> cancelled; /**< True if the current run was cancelled */
+    function<void(size_t, size_t)> progressCallback; /**< Receives the number of finished tasks and the total */
+    mutex progressLock; /**< Serializes the calls to the progress callback */
+
+    vector<WorkerQueue> queues; /**< Deque of each worker, reused by every run */
+    vector<thread> threads; /**< Workers 1 to nThreads - 1 */
+    mutex runLock; /**< Protects the state of the current run shared with the workers */
+    condition_variable runStarted; /**< Wakes the workers when a run starts or the pool is destroyed */
+    condition_variable runEnded; /**< Wakes the caller of parallelFor when the last busy worker is done */
+    const function<void(size_t, unsigned)> *runTask = nullptr; /**< Task of the current run */
+    size_t runTasks = 0; /**< Number of tasks of the current run */
+    size_t finishedTasks = 0; /**< Number of finished tasks of the current run, incremented under the progress lock */
+    unsigned runWorkers = 0; /**< Number of workers taking part in the current run */
+    unsigned busyWorkers = 0; /**< Workers (other than the caller) still running tasks of the current run */
+    unsigned long long generation = 0; /**< Number of runs started over the workers, so each one joins a run once */
+    bool stopping = false; /**< True once the destructor asked the workers to return */
+
+    /**
+     * Waits for the runs and takes part in each of them, until the pool is destroyed. Body of the threads of the pool.
+     * @param worker - the index of the worker
+     */
+    void workerLoop(unsigned worker);
+
+    /**
+     * Runs the tasks of the current run until there are none left or the run is cancelled.
+     * @param worker - the index of the worker
+     */
+    void work(unsigned worker);
+
+    /**
+     * Takes the next task of a worker, stealing from the other workers of the run when its own deque is empty.
+     * @param worker - the index of the worker
+     * @param task - variable that will hold the task
+     * @return true if a task was found, false if every deque is empty
+     */
+    bool nextTask(unsigned worker, size_t &task);
+
+    /**
+     * Counts a finished task of the current run and reports it to the progress callback.
+     */
+    void reportProgress();
+};
+
+template <class Workspace>
+bool WorkStealingPool::parallelFor(size_t n, const function<void(size_t, Workspace &)> &task) {
+    vector<Workspace> workspaces(nThreads);
+    return parallelFor(n, [&workspaces, &task](size_t i, unsigned worker) {
+        task(i, workspaces[worker]);
+    });
+}
+
+#endif //PROJECT_RAILWAY_WORKSTEALINGPOOL_H
@@ -27,6 +27,15 @@ bool getInput(type &input){
 }
 
 template bool getInput<int>(int &input);
+template bool getInput<double>(double &input);
+
+void drawProgress(size_t finished, size_t total) {
+    size_t percentage = finished * 100 / total;
+    if (finished > 1 && percentage == (finished - 1) * 100 / total && finished != total) return;
+
+    cout << "\r\033[34mCalculating... " << percentage << "%\033[0m" << flush;
+    if (finished == total) cout << endl;
+}
 
 int getLen(const string str){
     int counter = 0;
@@ -261,7 +270,8 @@ void drawFooter(vector<Edge*> edges, bool printCost){
         }
 }
 
-void drawFooterCombinations(vector<pair<pair<Vertex *, Vertex *>, int>> result_vector, Graph *railway){
+void drawFooterCombinations(const vector<pair<pair<Vertex *, Vertex *>, int>> &result_vector, const vector<FlowResult> &flows,
+                            const FlowNetwork &network){
     cout << "|\033[40m<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<\033[0m|\n"
          << "|\033[40m_____________________________________________\033[0m|\n";
 
@@ -305,11 +315,9 @@ void drawFooterCombinations(vector<pair<pair<Vertex *, Vertex *>, int>> result_v
                     vector<Edge*> aux;
 
                     for (int i = 0; i < counter; i++){
-                        vector<Vertex*> vertexes;
                         if (i == path-1){
-                            railway->getMaxFlow(result_vector[i].first.first, result_vector[i].first.second);
-                            vertexes.push_back(result_vector[i].first.first);
-                            aux = railway->fetchUsedEdges(vertexes);
+                            network.applyFlow(flows[i].flow);
+                            aux = network.getUsedEdges(flows[i]);
                             sortVector(aux);
                             paginationControllerEdge(aux);
                             c = false;
@@ -655,4 +663,98 @@ void drawNode(vector<Vertex*> data, int page, int nPages) {
     cout << "|\033[40m_____________________________________________________________________________________\033[0m|" << endl;
     cout << "|\033[40m                       [n]Next      [p]Previous    [q]Go Back                        \033[0m|" << endl;
     cout << "|\033[40m_____________________________________________________________________________________\033[0m|" << endl;
-}
\ No newline at end of file
+}
+
+void topPairs(const vector<pair<pair<Vertex *, Vertex *>, int>> &data, const string &title) {
+    int page = 0;
+    while (page >= 0 and page < (float)data.size() / 10.0)
+    {
+        string option;
+        drawPairs(data,page,ceil((float)data.size()/10.0),title);
+        bool cond = true;
+        while (cond)
+        {
+            cout << endl
+                 << "\033[33mChoose an option[n/p/q] or the number of the page you would want to go[1-"<<ceil((float)data.size()/10.0)<<"]: ";
+            cond = true;
+            cin >> option;
+
+            if (option.length() == 1)
+            {
+                option= ::toupper(option[0]);
+                switch (option[0])
+                {
+                    case 'N':
+                        page++;
+                        cond=false;
+                        break;
+                    case 'P':
+                        page--;
+                        cond=false;
+                        break;
+                    case 'Q':
+                        page = -1;
+                        cond=false;
+                        break;
+
+                    default:
+                        cond = true;
+                }
+            }
+            if(cond){
+                int test;
+                try{
+                    cond=false;
+                    test= stoi(option);
+                }catch (invalid_argument){
+                    cond=true;
+                }
+                if(!cond){
+                    cond=true;
+                    if(to_string(test).length()==option.length()){
+                        if(test>0 and test <=ceil((float)data.size()/10.0)) {
+                            page=test-1;
+                            cond= false;
+                        }
+                    }
+
+                }
+            }
+            if (cond)
+                cout << "\033[31mInvalid input! Please enter a valid input: \033[0m";
+            cin.clear();
+            cin.ignore(numeric_limits<streamsize>::max(), '\n');
+        }
+    }
+}
+
+void drawPairs(const vector<pair<pair<Vertex *, Vertex *>, int>> &data, int page, int nPages, const string &title) {
+    system("clear");
+    cout << "\033[0m";
+    cout << " _________________________________________________________________________________________________________ " << endl;
+    cout << "|\033[40m                                                  Page(" << page + 1 << "/" << nPages << ")";
+    for (int i = 0; i < 8 - to_string(page + 1).length() - to_string(nPages).length(); i++)
+        cout << ' ';
+
+    cout << "                                        \033[0m|" << endl;
+    cout << "|\033[40m_________________________________________________________________________________________________________\033[0m|" << endl;
+    cout << "|\033[40m   " << title << string(7 - getLen(title), ' ') << "|                   Station A                  |                    Station B                  \033[0m|" << endl;
+    cout << "|\033[40m_________________________________________________________________________________________________________\033[0m|" << endl;
+    for (int i = 10 * page; i < 10 * page + 10; i++) {
+        if (i == (int) data.size())
+            break;
+        cout<<"|";
+        if (i % 2 == 0)
+            cout << "\033[47m"
+                 << "\033[30m";
+        else
+            cout << "\033[100m";
+        auto aux = data[i];
+        cout << "    " << aux.second << string( 6- getLen(to_string(aux.second)), ' ') << "| " << aux.first.first->getId() << string(45 - getLen(aux.first.first->getId()), ' ') << "| " << aux.first.second->getId() << string(45 - getLen(aux.first.second->getId()), ' ') << " \033[0m";
+        cout<<"\033[0m|"<<endl;
+    }
+
+    cout << "|\033[40m_________________________________________________________________________________________________________\033[0m|" << endl;
+    cout << "|\033[40m                                 [n]Next      [p]Previous    [q]Go Back                                  \033[0m|" << endl;
+    cout << "|\033[40m_________________________________________________________________________________________________________\033[0m|" << endl;
+}
@@ -6,6 +6,7 @@
 #include <iostream>
 #include "graph/VertexEdge.h"
 #include "graph/Graph.h"
+#include "graph/FlowNetwork.h"
 #include <cmath>
 
 using namespace std;
@@ -53,6 +54,14 @@ void sortVector(vector<Edge *> &aux);
  */
 int getLen(string str);
 
+/**
+ * Shows the completion percentage of a long analysis on the current line, only redrawing it when the percentage changes.
+ * Meant to be used as the progress callback of a WorkStealingPool.
+ * @param finished - the number of finished tasks
+ * @param total - the total number of tasks
+ */
+void drawProgress(size_t finished, size_t total);
+
 /**
  * Asks the user for the name of a station. If the user writes the character provided by the variable 'quit' the user will
  * exit or confirm the stations he inserted
@@ -105,9 +114,11 @@ void drawFooter(vector<Edge*> edges, bool printCost = false);
 /**
  * Asks the user for the edge he wants to consider for the detailed information
  * @param result_vector - vector with the pair of vertexes to be considered
- * @param railway - graph with all the stations
+ * @param flows - result of the max flow of the pairs of result_vector with the highest flow
+ * @param network - network in which the flows were calculated
  */
-void drawFooterCombinations(vector<pair<pair<Vertex *, Vertex *>, int>> result_vector, Graph *railway);
+void drawFooterCombinations(const vector<pair<pair<Vertex *, Vertex *>, int>> &result_vector, const vector<FlowResult> &flows,
+                            const FlowNetwork &network);
 
 /**
  * Draws a header with results written on it
@@ -173,4 +184,20 @@ void topNode(const vector<Vertex*>& data);
  */
 void drawNode(vector<Vertex*> data, int page, int nPages);
 
+/**
+ * Prints a ranking of pairs of stations and the max flow between them, 10 pairs per page
+ * @param data - pairs of stations and their flow to be printed
+ * @param title - title of the value column (at most 7 characters)
+ */
+void topPairs(const vector<pair<pair<Vertex *, Vertex *>, int>> &data, const string &title = "Flow");
+
+/**
+ * Draws a page of the ranking of pairs of stations
+ * @param data - pairs of stations and their flow to be printed
+ * @param page - page the user is in
+ * @param nPages - number of pages there are
+ * @param title - title of the value column (at most 7 characters)
+ */
+void drawPairs(const vector<pair<pair<Vertex *, Vertex *>, int>> &data, int page, int nPages, const string &title = "Flow");
+
 #endif //PROJECT_RAILWAY_UTILS_H